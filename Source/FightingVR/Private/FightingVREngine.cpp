@@ -7,10 +7,16 @@
 #include "FightingVREngine.h"
 #include "FightingVR.h"
 #include "FightingVRInstance.h"
+#include "OnlineSubsystemUtils.h"
 
 UFightingVREngine::UFightingVREngine(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	MaxNetworkFailureHistory = 32;
+	bAutoReconnect = false;
+	MaxReconnectAttempts = 2;
+	NetworkFailureHistoryHead = 0;
+	ReconnectAttempts = 0;
 }
 
 void UFightingVREngine::Init(IEngineLoop* InEngineLoop)
@@ -18,17 +24,126 @@ void UFightingVREngine::Init(IEngineLoop* InEngineLoop)
 	// Note: Lots of important things happen in Super::Init(), including spawning the player pawn in-game and
 	// creating the renderer.
 	Super::Init(InEngineLoop);
+
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UFightingVREngine::OnPostLoadMapWithWorld);
+}
+
+void UFightingVREngine::GetNetworkFailureHistory(TArray<FFightingVRNetworkFailureRecord>& OutHistory) const
+{
+	OutHistory.Reset(NetworkFailureHistory.Num());
+	for (int32 i = 0; i < NetworkFailureHistory.Num(); ++i)
+	{
+		OutHistory.Add(NetworkFailureHistory[(NetworkFailureHistoryHead + i) % NetworkFailureHistory.Num()]);
+	}
+}
+
+void UFightingVREngine::RecordNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
+{
+	if (MaxNetworkFailureHistory <= 0)
+	{
+		return;
+	}
+
+	FFightingVRNetworkFailureRecord Record;
+	Record.Time = FDateTime::UtcNow();
+	Record.FailureType = FailureType;
+	Record.ErrorString = ErrorString;
+
+	FWorldContext* Context = World ? GetWorldContextFromWorld(World) : nullptr;
+	if (Context)
+	{
+		Record.URL = Context->PendingNetGame ? Context->PendingNetGame->URL.ToString() : Context->LastURL.ToString();
+	}
+
+	// the connection is still around at this point, grab its stats before it is closed
+	UNetConnection* Connection = NetDriver ? NetDriver->ServerConnection : nullptr;
+	if (Connection)
+	{
+		Record.PingMs = Connection->AvgLag * 1000.0f;
+		Record.InPacketLossPercent = 100.0f * Connection->InPacketsLost / FMath::Max(Connection->InPackets + Connection->InPacketsLost, 1);
+		Record.OutPacketLossPercent = 100.0f * Connection->OutPacketsLost / FMath::Max(Connection->OutPackets + Connection->OutPacketsLost, 1);
+		Record.bSaturated = !Connection->IsNetReady(false);
+	}
+
+	UE_LOG(LogFightingVR, Warning, TEXT("NetworkFailure: Type=%s URL=%s PingMs=%.0f InLoss=%.1f%% OutLoss=%.1f%% Saturated=%d Error=%s"),
+		ENetworkFailure::ToString(FailureType), *Record.URL, Record.PingMs, Record.InPacketLossPercent, Record.OutPacketLossPercent, Record.bSaturated ? 1 : 0, *ErrorString);
+
+	if (NetworkFailureHistory.Num() < MaxNetworkFailureHistory)
+	{
+		NetworkFailureHistory.Add(MoveTemp(Record));
+	}
+	else
+	{
+		NetworkFailureHistory[NetworkFailureHistoryHead] = MoveTemp(Record);
+		NetworkFailureHistoryHead = (NetworkFailureHistoryHead + 1) % NetworkFailureHistory.Num();
+	}
+}
+
+bool UFightingVREngine::TryReconnect(UWorld* World, UNetDriver* NetDriver)
+{
+	if (!bAutoReconnect || NetDriver->GetNetMode() != NM_Client)
+	{
+		return false;
+	}
+
+	// the first failure starts a reconnect to the session we were playing in, later ones retry it
+	if (ReconnectURL.IsEmpty())
+	{
+		FWorldContext* Context = World ? GetWorldContextFromWorld(World) : nullptr;
+		if (Context == nullptr || NetDriver->NetDriverName != NAME_GameNetDriver)
+		{
+			return false;
+		}
+
+		ReconnectURL = Context->LastURL.ToString();
+		ReconnectAttempts = 0;
+
+		// the session is torn down with the connection, keep what is needed to join it again
+		ReconnectSession = FOnlineSessionSearchResult();
+		IOnlineSessionPtr Sessions = Online::GetSessionInterface(World);
+		if (const FNamedOnlineSession* Session = Sessions.IsValid() ? Sessions->GetNamedSession(NAME_GameSession) : nullptr)
+		{
+			ReconnectSession.Session = *Session;
+		}
+	}
+
+	if (ReconnectAttempts >= MaxReconnectAttempts)
+	{
+		UE_LOG(LogFightingVR, Log, TEXT("NetworkFailure: giving up reconnecting to %s after %d attempts"), *ReconnectURL, ReconnectAttempts);
+		ReconnectURL.Empty();
+		ReconnectSession = FOnlineSessionSearchResult();
+		ReconnectAttempts = 0;
+		return false;
+	}
+
+	++ReconnectAttempts;
+	UE_LOG(LogFightingVR, Log, TEXT("NetworkFailure: reconnecting to %s, attempt %d of %d"), *ReconnectURL, ReconnectAttempts, MaxReconnectAttempts);
+	return true;
+}
+
+void UFightingVREngine::OnPostLoadMapWithWorld(UWorld* LoadedWorld)
+{
+	if (!ReconnectURL.IsEmpty() && LoadedWorld && LoadedWorld->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogFightingVR, Log, TEXT("NetworkFailure: reconnected to %s after %d attempts"), *ReconnectURL, ReconnectAttempts);
+		ReconnectURL.Empty();
+		ReconnectSession = FOnlineSessionSearchResult();
+		ReconnectAttempts = 0;
+	}
 }
 
 
 void UFightingVREngine::HandleNetworkFailure(UWorld *World, UNetDriver *NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
 {
 	// Determine if we need to change the King state based on network failures.
+	bool bReconnect = false;
 
 	// Only handle failure at this level for game or pending net drivers.
 	FName NetDriverName = NetDriver ? NetDriver->NetDriverName : NAME_None; 
 	if (NetDriverName == NAME_GameNetDriver || NetDriverName == NAME_PendingNetDriver)
 	{
+		RecordNetworkFailure(World, NetDriver, FailureType, ErrorString);
+
 		// If this net driver has already been unregistered with this world, then don't handle it.
 		//if (World)
 		{
@@ -53,8 +168,11 @@ void UFightingVREngine::HandleNetworkFailure(UWorld *World, UNetDriver *NetDrive
 					}
 					case ENetworkFailure::PendingConnectionFailure:						
 					{
+						// a failed reconnect attempt tries again until it runs out of attempts
+						bReconnect = !ReconnectURL.IsEmpty() && TryReconnect(World, NetDriver);
+
 						UFightingVRInstance* const GI = Cast<UFightingVRInstance>(GameInstance);
-						if (GI && NetDriver->GetNetMode() == NM_Client)
+						if (GI && NetDriver->GetNetMode() == NM_Client && !bReconnect)
 						{
 							const FText OKButton = NSLOCTEXT( "DialogButtons", "OKAY", "OK" );
 
@@ -68,8 +186,10 @@ void UFightingVREngine::HandleNetworkFailure(UWorld *World, UNetDriver *NetDrive
 					case ENetworkFailure::ConnectionLost:						
 					case ENetworkFailure::ConnectionTimeout:
 					{
+						bReconnect = TryReconnect(World, NetDriver);
+
 						UFightingVRInstance* const GI = Cast<UFightingVRInstance>(GameInstance);
-						if (GI && NetDriver->GetNetMode() == NM_Client)
+						if (GI && NetDriver->GetNetMode() == NM_Client && !bReconnect)
 						{
 							const FText ReturnReason	= NSLOCTEXT( "NetworkErrors", "HostDisconnect", "Lost connection to host." );
 							const FText OKButton		= NSLOCTEXT( "DialogButtons", "OKAY", "OK" );
@@ -94,5 +214,26 @@ void UFightingVREngine::HandleNetworkFailure(UWorld *World, UNetDriver *NetDrive
 
 	// standard failure handling.
 	Super::HandleNetworkFailure(World, NetDriver, FailureType, ErrorString);
+
+	// the standard handling queues a disconnect travel, replace it with the trip back to the session
+	if (bReconnect && World)
+	{
+		UFightingVRInstance* const GI = Cast<UFightingVRInstance>(World->GetGameInstance());
+		if (GI && ReconnectSession.IsValid())
+		{
+			if (!GI->RejoinSession(ReconnectSession))
+			{
+				const FText ReturnReason	= NSLOCTEXT( "NetworkErrors", "HostDisconnect", "Lost connection to host." );
+				const FText OKButton		= NSLOCTEXT( "DialogButtons", "OKAY", "OK" );
+
+				GI->ShowMessageThenGotoState( ReturnReason, OKButton, FText::GetEmpty(), FightingVRInstanceState::MainMenu, false );
+			}
+		}
+		else
+		{
+			// without an online session, like a direct connect on LAN or the Null subsystem, there is nothing to rejoin
+			SetClientTravel(World, *ReconnectURL, TRAVEL_Absolute);
+		}
+	}
 }
 
@@ -14,10 +14,14 @@
 #include "FightingVRMenuItemWidgetStyle.h"
 #include "FightingVRViewportClient.h"
 #include "Player/FightingVRPlayerController_Menu.h"
+#include "Player/FightingVRLocalPlayer.h"
+#include "Player/FightingVRPersistentUser.h"
 #include "Online/FightingVRPlayerState.h"
 #include "Online/FightingVRSession.h"
 #include "Online/FightingVROnlineSessionClient.h"
+#include "Online/FightingVRReplayEvents.h"
 #include "OnlineSubsystemUtils.h"
+#include "TimerManager.h"
 
 #if !defined(CONTROLLER_SWAPPING)
 	#define CONTROLLER_SWAPPING 0
@@ -95,6 +99,22 @@ UFightingVRInstance::UFightingVRInstance(const FObjectInitializer& ObjectInitial
 	, bIsLicensed(true) // Default to licensed (should have been checked by OS on boot)
 {
 	CurrentState = FightingVRInstanceState::None;
+	FrontEndTransitionStartTime = 0.0;
+	PendingFrontEndMapPackage = nullptr;
+
+	FFightingVRReplayProfile StandardProfile;
+	StandardProfile.ProfileName = TEXT("Standard");
+	ReplayProfiles.Add(StandardProfile);
+
+	FFightingVRReplayProfile LightweightProfile;
+	LightweightProfile.ProfileName = TEXT("Lightweight");
+	LightweightProfile.CheckpointIntervalSeconds = 60.0f;
+	LightweightProfile.CheckpointSaveMaxMSPerFrame = 2.0f;
+	// filters nothing until ReplayLowValueActorClasses is configured for the replication graph
+	LightweightProfile.bFilterLowValueActors = true;
+	ReplayProfiles.Add(LightweightProfile);
+
+	DefaultReplayProfile = StandardProfile.ProfileName;
 }
 
 void UFightingVRInstance::Init() 
@@ -493,20 +513,26 @@ void UFightingVRInstance::ShowLoadingScreen()
 	
 }
 
-bool UFightingVRInstance::LoadFrontEndMap(const FString& MapName)
+bool UFightingVRInstance::IsFrontEndMapLoaded(const FString& MapName) const
 {
-	bool bSuccess = true;
-
-	// if already loaded, do nothing
 	UWorld* const World = GetWorld();
 	if (World)
 	{
 		FString const CurrentMapName = *World->PersistentLevel->GetOutermost()->GetName();
 		//if (MapName.Find(TEXT("Highrise")) != -1)
-		if (CurrentMapName == MapName)
-		{
-			return bSuccess;
-		}
+		return CurrentMapName == MapName;
+	}
+	return false;
+}
+
+bool UFightingVRInstance::LoadFrontEndMap(const FString& MapName)
+{
+	bool bSuccess = true;
+
+	// if already loaded, do nothing
+	if (IsFrontEndMapLoaded(MapName))
+	{
+		return bSuccess;
 	}
 
 	FString Error;
@@ -529,6 +555,112 @@ bool UFightingVRInstance::LoadFrontEndMap(const FString& MapName)
 	return bSuccess;
 }
 
+bool UFightingVRInstance::LoadFrontEndMapAsync(const FString& MapName, FOnFrontEndMapLoaded OnLoaded)
+{
+	// a newer transition replaces whatever was in flight
+	CancelFrontEndMapLoad();
+
+	if (IsFrontEndMapLoaded(MapName))
+	{
+		OnLoaded.ExecuteIfBound(true);
+		return true;
+	}
+
+	FURL URL(*MapName);
+	if (!URL.Valid || HasAnyFlags(RF_ClassDefaultObject))
+	{
+		UE_LOG(LogFightingVR, Warning, TEXT("FrontEndTransition: %s is not a valid map URL"), *MapName);
+		OnLoaded.ExecuteIfBound(false);
+		return false;
+	}
+
+	UFightingVRViewportClient* FightingVRViewport = Cast<UFightingVRViewportClient>(GetGameViewportClient());
+	if (FightingVRViewport != nullptr)
+	{
+		// the viewport loading screen keeps animating while the package streams in, OnPostLoadMap hides it again
+		FightingVRViewport->ShowLoadingScreen();
+	}
+
+	PendingFrontEndMap = MapName;
+	OnPendingFrontEndMapLoaded = OnLoaded;
+	FrontEndTransitionStartTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogFightingVR, Log, TEXT("FrontEndTransition: Begin Map=%s"), *MapName);
+
+	LoadPackageAsync(URL.Map, FLoadPackageAsyncDelegate::CreateUObject(this, &UFightingVRInstance::OnFrontEndMapPackageLoaded));
+	return true;
+}
+
+void UFightingVRInstance::OnFrontEndMapPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	// ignore loads of transitions that were cancelled or replaced by a newer one
+	if (PendingFrontEndMap.IsEmpty() || FURL(*PendingFrontEndMap).Map != PackageName.ToString())
+	{
+		return;
+	}
+
+	if (Result != EAsyncLoadingResult::Succeeded || LoadedPackage == nullptr)
+	{
+		UE_LOG(LogFightingVR, Warning, TEXT("FrontEndTransition: Preload of %s failed, falling back to a blocking load"), *PendingFrontEndMap);
+	}
+
+	// nothing else references the package until LoadMap picks it up, keep a GC from throwing the preload away
+	PendingFrontEndMapPackage = LoadedPackage;
+
+	// LoadMap flushes async loading, so it can't run from inside a completion callback
+	const FString MapName = PendingFrontEndMap;
+	const double PreloadEndTime = FPlatformTime::Seconds();
+	GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this, MapName, PreloadEndTime]()
+	{
+		if (PendingFrontEndMap != MapName)
+		{
+			return;
+		}
+
+		FOnFrontEndMapLoaded OnLoaded = OnPendingFrontEndMapLoaded;
+		PendingFrontEndMap.Empty();
+		OnPendingFrontEndMapLoaded.Unbind();
+
+		// the package is already in memory, so this only has to create the world
+		const double BrowseStartTime = FPlatformTime::Seconds();
+		const bool bSuccess = LoadFrontEndMap(MapName);
+		const double BrowseEndTime = FPlatformTime::Seconds();
+
+		// the new world references its package now
+		PendingFrontEndMapPackage = nullptr;
+
+		UE_LOG(LogFightingVR, Log, TEXT("FrontEndTransition: End Map=%s Success=%d PreloadMs=%.2f BrowseMs=%.2f TotalMs=%.2f"),
+			*MapName,
+			bSuccess ? 1 : 0,
+			(PreloadEndTime - FrontEndTransitionStartTime) * 1000.0,
+			(BrowseEndTime - BrowseStartTime) * 1000.0,
+			(BrowseEndTime - FrontEndTransitionStartTime) * 1000.0);
+
+		if (!bSuccess)
+		{
+			// no map change is coming to hide the loading screen, the caller's fallback needs to be seen
+			UFightingVRViewportClient* FightingVRViewport = Cast<UFightingVRViewportClient>(GetGameViewportClient());
+			if (FightingVRViewport != nullptr)
+			{
+				FightingVRViewport->HideLoadingScreen();
+			}
+		}
+
+		OnLoaded.ExecuteIfBound(bSuccess);
+	}));
+}
+
+void UFightingVRInstance::CancelFrontEndMapLoad()
+{
+	if (!PendingFrontEndMap.IsEmpty())
+	{
+		UE_LOG(LogFightingVR, Log, TEXT("FrontEndTransition: Cancel Map=%s"), *PendingFrontEndMap);
+		PendingFrontEndMap.Empty();
+		OnPendingFrontEndMapLoaded.Unbind();
+		PendingFrontEndMapPackage = nullptr;
+	}
+}
+
 AFightingVRSession* UFightingVRInstance::GetGameSession() const
 {
 	UWorld* const World = GetWorld();
@@ -596,6 +728,9 @@ void UFightingVRInstance::MaybeChangeState()
 
 void UFightingVRInstance::EndCurrentState(FName NextState)
 {
+	// a front end map still loading for the old state must not construct its UI in the new one
+	CancelFrontEndMapLoad();
+
 	// per-state custom ending code here
 	if (CurrentState == FightingVRInstanceState::PendingInvite)
 	{
@@ -651,14 +786,17 @@ void UFightingVRInstance::BeginNewState(FName NewState, FName PrevState)
 
 void UFightingVRInstance::BeginPendingInviteState()
 {	
-	if (LoadFrontEndMap(MainMenuMap))
-	{				
-		StartOnlinePrivilegeTask(IOnlineIdentity::FOnGetUserPrivilegeCompleteDelegate::CreateUObject(this, &UFightingVRInstance::OnUserCanPlayInvite), EUserPrivileges::CanPlayOnline, PendingInvite.UserId);
-	}
-	else
+	LoadFrontEndMapAsync(MainMenuMap, FOnFrontEndMapLoaded::CreateWeakLambda(this, [this](bool bSuccess)
 	{
-		GotoState(FightingVRInstanceState::WelcomeScreen);
-	}
+		if (bSuccess)
+		{
+			StartOnlinePrivilegeTask(IOnlineIdentity::FOnGetUserPrivilegeCompleteDelegate::CreateUObject(this, &UFightingVRInstance::OnUserCanPlayInvite), EUserPrivileges::CanPlayOnline, PendingInvite.UserId);
+		}
+		else
+		{
+			GotoState(FightingVRInstanceState::WelcomeScreen);
+		}
+	}));
 }
 
 void UFightingVRInstance::EndPendingInviteState()
@@ -675,17 +813,20 @@ void UFightingVRInstance::BeginWelcomeScreenState()
 	// Remove any possible splitscren players
 	RemoveSplitScreenPlayers();
 
-	LoadFrontEndMap(WelcomeScreenMap);
-
-	ULocalPlayer* const LocalPlayer = GetFirstGamePlayer();
-	LocalPlayer->SetCachedUniqueNetId(nullptr);
-	check(!WelcomeMenuUI.IsValid());
-	WelcomeMenuUI = MakeShareable(new FFightingVRWelcomeMenu);
-	WelcomeMenuUI->Construct( this );
-	WelcomeMenuUI->AddToGameViewport();
+	// everything after the map switch runs from the callback, in the same order as with a blocking load.
+	// The UI is built even if the map failed to load, so there is always a way on.
+	LoadFrontEndMapAsync(WelcomeScreenMap, FOnFrontEndMapLoaded::CreateWeakLambda(this, [this](bool bSuccess)
+	{
+		ULocalPlayer* const LocalPlayer = GetFirstGamePlayer();
+		LocalPlayer->SetCachedUniqueNetId(nullptr);
+		check(!WelcomeMenuUI.IsValid());
+		WelcomeMenuUI = MakeShareable(new FFightingVRWelcomeMenu);
+		WelcomeMenuUI->Construct( this );
+		WelcomeMenuUI->AddToGameViewport();
 
-	// Disallow splitscreen (we will allow while in the playing state)
-	GetGameViewportClient()->SetForceDisableSplitscreen( true );
+		// Disallow splitscreen (we will allow while in the playing state)
+		GetGameViewportClient()->SetForceDisableSplitscreen( true );
+	}));
 }
 
 void UFightingVRInstance::EndWelcomeScreenState()
@@ -745,27 +886,29 @@ void UFightingVRInstance::BeginMainMenuState()
 	// Set presence to menu state for the owning player
 	SetPresenceForLocalPlayers(FString(TEXT("In Menu")), FVariantData(FString(TEXT("OnMenu"))));
 
-	// load startup map
-	LoadFrontEndMap(MainMenuMap);
-
-	// player 0 gets to own the UI
-	ULocalPlayer* const Player = GetFirstGamePlayer();
+	// load startup map, everything after the map switch runs once it is the current world, in the same order as with a blocking load.
+	// The menu is built even if the map failed to load, so there is always a way on.
+	LoadFrontEndMapAsync(MainMenuMap, FOnFrontEndMapLoaded::CreateWeakLambda(this, [this](bool bSuccess)
+	{
+		// player 0 gets to own the UI
+		ULocalPlayer* const Player = GetFirstGamePlayer();
 
-	MainMenuUI = MakeShareable(new FFightingVRMainMenu());
-	MainMenuUI->Construct(this, Player);
-	MainMenuUI->AddMenuToGameViewport();
+		MainMenuUI = MakeShareable(new FFightingVRMainMenu());
+		MainMenuUI->Construct(this, Player);
+		MainMenuUI->AddMenuToGameViewport();
 
 #if !FIGHTINGVR_CONSOLE_UI
-	// The cached unique net ID is usually set on the welcome screen, but there isn't
-	// one on PC/Mac, so do it here.
-	if (Player != nullptr)
-	{
-		Player->SetControllerId(0);
-		Player->SetCachedUniqueNetId(Player->GetUniqueNetIdFromCachedControllerId().GetUniqueNetId());
-	}
+		// The cached unique net ID is usually set on the welcome screen, but there isn't
+		// one on PC/Mac, so do it here.
+		if (Player != nullptr)
+		{
+			Player->SetControllerId(0);
+			Player->SetCachedUniqueNetId(Player->GetUniqueNetIdFromCachedControllerId().GetUniqueNetId());
+		}
 #endif
 
-	RemoveNetworkFailureHandlers();
+		RemoveNetworkFailureHandlers();
+	}));
 }
 
 void UFightingVRInstance::EndMainMenuState()
@@ -823,12 +966,26 @@ void UFightingVRInstance::BeginPlayingState()
 
 void UFightingVRInstance::EndPlayingState()
 {
+	// recordings also end with the match world, without going through StopRecordingReplay
+	RestoreReplayConsoleVariables();
+
 	// Disallow splitscreen
 	GetGameViewportClient()->SetForceDisableSplitscreen( true );
 
 	// Clear the players' presence information
 	SetPresenceForLocalPlayers(FString(TEXT("In Menu")), FVariantData(FString(TEXT("OnMenu"))));
 
+	// players met during the match were only marked dirty, save them once on the way out
+	for (ULocalPlayer* LocalPlayer : LocalPlayers)
+	{
+		UFightingVRLocalPlayer* const FightingVRLocalPlayer = Cast<UFightingVRLocalPlayer>(LocalPlayer);
+		UFightingVRPersistentUser* const PersistentUser = FightingVRLocalPlayer ? FightingVRLocalPlayer->GetPersistentUser() : nullptr;
+		if (PersistentUser)
+		{
+			PersistentUser->SaveIfDirty();
+		}
+	}
+
 	UWorld* const World = GetWorld();
 	AFightingVRState* const GameState = World != NULL ? World->GetGameState<AFightingVRState>() : NULL;
 
@@ -1102,6 +1259,90 @@ bool UFightingVRInstance::JoinSession(ULocalPlayer* LocalPlayer, const FOnlineSe
 	return false;
 }
 
+bool UFightingVRInstance::RejoinSession(const FOnlineSessionSearchResult& SearchResult)
+{
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (!Sessions.IsValid() || !SearchResult.IsValid())
+	{
+		return false;
+	}
+
+	// the local session outlives the lost connection, and joining fails while it is still registered
+	if (Sessions->GetNamedSession(NAME_GameSession))
+	{
+		PendingRejoinSession = SearchResult;
+		return Sessions->DestroySession(NAME_GameSession, FOnDestroySessionCompleteDelegate::CreateUObject(this, &UFightingVRInstance::OnRejoinSessionDestroyed));
+	}
+
+	return StartRejoinSession(SearchResult);
+}
+
+bool UFightingVRInstance::StartRejoinSession(const FOnlineSessionSearchResult& SearchResult)
+{
+	ULocalPlayer* const LocalPlayer = GetFirstGamePlayer();
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (LocalPlayer == nullptr || !Sessions.IsValid() || !LocalPlayer->GetPreferredUniqueNetId().IsValid())
+	{
+		return false;
+	}
+
+	// AFightingVRSession belongs to the server's game mode, which a client doesn't have, so join through the session interface
+	Sessions->ClearOnJoinSessionCompleteDelegate_Handle(OnRejoinSessionCompleteDelegateHandle);
+	OnRejoinSessionCompleteDelegateHandle = Sessions->AddOnJoinSessionCompleteDelegate_Handle(FOnJoinSessionCompleteDelegate::CreateUObject(this, &UFightingVRInstance::OnRejoinSessionComplete));
+
+	if (!Sessions->JoinSession(*LocalPlayer->GetPreferredUniqueNetId(), NAME_GameSession, SearchResult))
+	{
+		// some subsystems complete a failed join before returning, the completion has reported it already
+		const bool bFailureHandled = !OnRejoinSessionCompleteDelegateHandle.IsValid();
+		Sessions->ClearOnJoinSessionCompleteDelegate_Handle(OnRejoinSessionCompleteDelegateHandle);
+		return bFailureHandled;
+	}
+
+	return true;
+}
+
+void UFightingVRInstance::OnRejoinSessionDestroyed(FName SessionName, bool bWasSuccessful)
+{
+	const FOnlineSessionSearchResult SearchResult = PendingRejoinSession;
+	PendingRejoinSession = FOnlineSessionSearchResult();
+
+	if (!StartRejoinSession(SearchResult))
+	{
+		const FText ReturnReason	= NSLOCTEXT( "NetworkErrors", "HostDisconnect", "Lost connection to host." );
+		const FText OKButton		= NSLOCTEXT( "DialogButtons", "OKAY", "OK" );
+
+		ShowMessageThenGotoState( ReturnReason, OKButton, FText::GetEmpty(), FightingVRInstanceState::MainMenu, false );
+	}
+}
+
+void UFightingVRInstance::OnRejoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	if (SessionName != NAME_GameSession)
+	{
+		return;
+	}
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (Sessions.IsValid())
+	{
+		Sessions->ClearOnJoinSessionCompleteDelegate_Handle(OnRejoinSessionCompleteDelegateHandle);
+	}
+
+	if (Result != EOnJoinSessionCompleteResult::Success)
+	{
+		UE_LOG(LogOnlineGame, Warning, TEXT("Rejoining the lost session failed (%s)"), LexToString(Result));
+
+		const FText ReturnReason	= NSLOCTEXT( "NetworkErrors", "HostDisconnect", "Lost connection to host." );
+		const FText OKButton		= NSLOCTEXT( "DialogButtons", "OKAY", "OK" );
+
+		ShowMessageThenGotoState( ReturnReason, OKButton, FText::GetEmpty(), FightingVRInstanceState::MainMenu, false );
+		return;
+	}
+
+	// resolves the connect string of the joined session and client travels to it, replacing the disconnect travel
+	InternalTravelToSession(NAME_GameSession);
+}
+
 bool UFightingVRInstance::PlayDemo(ULocalPlayer* LocalPlayer, const FString& DemoName)
 {
 	ShowLoadingScreen();
@@ -1112,6 +1353,93 @@ bool UFightingVRInstance::PlayDemo(ULocalPlayer* LocalPlayer, const FString& Dem
 	return true;
 }
 
+const FFightingVRReplayProfile& UFightingVRInstance::GetReplayProfile(const TArray<FString>& AdditionalOptions) const
+{
+	static const FFightingVRReplayProfile FallbackProfile;
+
+	FName ProfileName = DefaultReplayProfile;
+	for (const FString& Option : AdditionalOptions)
+	{
+		FString OptionValue;
+		if (FParse::Value(*Option, TEXT("ReplayProfile="), OptionValue))
+		{
+			ProfileName = FName(*OptionValue);
+		}
+	}
+
+	const FFightingVRReplayProfile* Profile = ReplayProfiles.FindByPredicate([ProfileName](const FFightingVRReplayProfile& Candidate) { return Candidate.ProfileName == ProfileName; });
+	if (Profile == nullptr)
+	{
+		UE_LOG(LogOnlineGame, Warning, TEXT("Unknown replay profile %s, recording with engine defaults"), *ProfileName.ToString());
+		return FallbackProfile;
+	}
+
+	return *Profile;
+}
+
+void UFightingVRInstance::StartRecordingReplay(const FString& InName, const FString& FriendlyName, const TArray<FString>& AdditionalOptions, TSharedPtr<IAnalyticsProvider> AnalyticsProvider)
+{
+	const FFightingVRReplayProfile& Profile = GetReplayProfile(AdditionalOptions);
+
+	// the demo net driver reads these when it starts recording and on every checkpoint
+	auto SetConsoleVariable = [this](const TCHAR* Name, float Value)
+	{
+		if (IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			// keep the value from before the first of back to back recordings
+			if (!SavedReplayConsoleVariables.Contains(Name))
+			{
+				SavedReplayConsoleVariables.Add(Name, ConsoleVariable->GetString());
+			}
+
+			if ((ConsoleVariable->GetFlags() & ECVF_SetByMask) > ECVF_SetByCode)
+			{
+				UE_LOG(LogOnlineGame, Warning, TEXT("%s was set from the console, keeping %s instead of the replay profile value %g"), Name, *ConsoleVariable->GetString(), Value);
+				return;
+			}
+
+			ConsoleVariable->Set(Value, ECVF_SetByCode);
+		}
+	};
+
+	SetConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds"), Profile.CheckpointIntervalSeconds);
+	SetConsoleVariable(TEXT("demo.CheckpointSaveMaxMSPerFrameOverride"), Profile.CheckpointSaveMaxMSPerFrame > 0.0f ? Profile.CheckpointSaveMaxMSPerFrame : -1.0f);
+	SetConsoleVariable(TEXT("demo.RecordHz"), Profile.RecordHz);
+	SetConsoleVariable(TEXT("FightingVRRepGraph.Replay.FilterLowValueActors"), Profile.bFilterLowValueActors ? 1.0f : 0.0f);
+
+	UE_LOG(LogOnlineGame, Log, TEXT("Recording replay %s with profile %s (checkpoint every %.0fs, %.1f Hz, filter %d)"), *InName, *Profile.ProfileName.ToString(), Profile.CheckpointIntervalSeconds, Profile.RecordHz, Profile.bFilterLowValueActors ? 1 : 0);
+
+	Super::StartRecordingReplay(InName, FriendlyName, AdditionalOptions, AnalyticsProvider);
+}
+
+void UFightingVRInstance::StopRecordingReplay()
+{
+	UWorld* const World = GetWorld();
+	UFightingVRReplayEventRecorder* const ReplayEvents = World ? World->GetSubsystem<UFightingVRReplayEventRecorder>() : nullptr;
+	if (ReplayEvents)
+	{
+		ReplayEvents->Flush();
+	}
+
+	Super::StopRecordingReplay();
+
+	RestoreReplayConsoleVariables();
+}
+
+void UFightingVRInstance::RestoreReplayConsoleVariables()
+{
+	for (const TPair<FString, FString>& SavedVariable : SavedReplayConsoleVariables)
+	{
+		IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(*SavedVariable.Key);
+		if (ConsoleVariable && (ConsoleVariable->GetFlags() & ECVF_SetByMask) <= ECVF_SetByCode)
+		{
+			ConsoleVariable->Set(*SavedVariable.Value, ECVF_SetByCode);
+		}
+	}
+
+	SavedReplayConsoleVariables.Reset();
+}
+
 /** Callback which is intended to be called upon finding sessions */
 void UFightingVRInstance::OnJoinSessionComplete(EOnJoinSessionCompleteResult::Type Result)
 {
@@ -10,6 +10,7 @@
 #include "Online/FightingVRSession.h"
 #include "Bots/FightingVRAIController.h"
 #include "FightingVRTeamStart.h"
+#include "Weapons/FightingVRWeapon.h"
 
 
 AFightingVRMode::AFightingVRMode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -28,6 +29,7 @@ AFightingVRMode::AFightingVRMode(const FObjectInitializer& ObjectInitializer) :
 	ReplaySpectatorPlayerControllerClass = AFightingVRDemoSpectator::StaticClass();
 
 	MinRespawnDelay = 5.0f;
+	MaxPooledWeapons = 64;
 
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
@@ -189,6 +191,12 @@ void AFightingVRMode::FinishMatch()
 	AFightingVRState* const MyGameState = Cast<AFightingVRState>(GameState);
 	if (IsMatchInProgress())
 	{
+		// the winner is decided on final scores, including points scored this frame
+		if (MyGameState)
+		{
+			MyGameState->FlushPendingScores();
+		}
+
 		EndMatch();
 		DetermineMatchWinner();		
 
@@ -305,13 +313,17 @@ void AFightingVRMode::Killed(AController* Killer, AController* KilledPlayer, APa
 	if (KillerPlayerState && KillerPlayerState != VictimPlayerState)
 	{
 		KillerPlayerState->ScoreKill(VictimPlayerState, KillScore);
-		KillerPlayerState->InformAboutKill(KillerPlayerState, DamageType, VictimPlayerState);
 	}
 
 	if (VictimPlayerState)
 	{
 		VictimPlayerState->ScoreDeath(KillerPlayerState, DeathScore);
-		VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
+
+		AFightingVRState* const MyGameState = GetGameState<AFightingVRState>();
+		if (MyGameState)
+		{
+			MyGameState->AddKill(KillerPlayerState, VictimPlayerState, DamageType);
+		}
 	}
 }
 
@@ -341,6 +353,48 @@ float AFightingVRMode::ModifyDamage(float Damage, AActor* DamagedActor, struct F
 	return ActualDamage;
 }
 
+AFightingVRWeapon* AFightingVRMode::AcquireWeapon(TSubclassOf<AFightingVRWeapon> WeaponClass)
+{
+	for (int32 i = WeaponPool.Num() - 1; i >= 0; i--)
+	{
+		AFightingVRWeapon* Weapon = WeaponPool[i];
+		if (!IsValid(Weapon))
+		{
+			// destroyed while parked, e.g. by level streaming
+			WeaponPool.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (Weapon->GetClass() == WeaponClass)
+		{
+			WeaponPool.RemoveAtSwap(i);
+			Weapon->OnUnparked();
+			return Weapon;
+		}
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<AFightingVRWeapon>(WeaponClass, SpawnInfo);
+}
+
+void AFightingVRMode::ReleaseWeapon(AFightingVRWeapon* Weapon)
+{
+	if (!IsValid(Weapon) || Weapon->IsParked())
+	{
+		return;
+	}
+
+	if (WeaponPool.Num() >= MaxPooledWeapons)
+	{
+		Weapon->Destroy();
+		return;
+	}
+
+	Weapon->OnParked();
+	WeaponPool.Add(Weapon);
+}
+
 bool AFightingVRMode::CanDealDamage(class AFightingVRPlayerState* DamageInstigator, class AFightingVRPlayerState* DamagedPlayer) const
 {
 	return true;
@@ -4,6 +4,8 @@
 #include "FightingVR.h"
 #include "Net/OnlineEngineInterface.h"
 
+FOnFightingVRRosterChanged AFightingVRPlayerState::NotifyRosterChanged;
+
 AFightingVRPlayerState::AFightingVRPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	TeamNumber = 0;
@@ -55,11 +57,28 @@ void AFightingVRPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	NotifyRosterChanged.Broadcast(this);
 }
 
 void AFightingVRPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	NotifyRosterChanged.Broadcast(this);
+}
+
+void AFightingVRPlayerState::OnRep_PlayerName()
+{
+	Super::OnRep_PlayerName();
+
+	UpdateShortPlayerName();
+	NotifyRosterChanged.Broadcast(this);
+}
+
+void AFightingVRPlayerState::SetPlayerName(const FString& S)
+{
+	Super::SetPlayerName(S);
+
+	UpdateShortPlayerName();
 }
 
 void AFightingVRPlayerState::AddBulletsFired(int32 NumBullets)
@@ -90,6 +109,8 @@ void AFightingVRPlayerState::CopyProperties(APlayerState* PlayerState)
 	if (FightingVRPlayer)
 	{
 		FightingVRPlayer->TeamNumber = TeamNumber;
+		FightingVRPlayer->ShortPlayerName = ShortPlayerName;
+		FightingVRPlayer->ShortPlayerNameText = ShortPlayerNameText;
 	}	
 }
 
@@ -155,54 +176,16 @@ void AFightingVRPlayerState::ScoreDeath(AFightingVRPlayerState* KilledBy, int32
 
 void AFightingVRPlayerState::ScorePoints(int32 Points)
 {
+	// many kills can land in one frame, the game state applies them to this player and the team in one go
 	AFightingVRState* const MyGameState = GetWorld()->GetGameState<AFightingVRState>();
-	if (MyGameState && TeamNumber >= 0)
+	if (MyGameState)
 	{
-		if (TeamNumber >= MyGameState->TeamScores.Num())
-		{
-			MyGameState->TeamScores.AddZeroed(TeamNumber - MyGameState->TeamScores.Num() + 1);
-		}
-
-		MyGameState->TeamScores[TeamNumber] += Points;
+		MyGameState->AddPendingScore(this, Points);
 	}
-
-	SetScore(GetScore() + Points);
-}
-
-void AFightingVRPlayerState::InformAboutKill_Implementation(class AFightingVRPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AFightingVRPlayerState* KilledPlayerState)
-{
-	//id can be null for bots
-	if (KillerPlayerState->GetUniqueId().IsValid())
-	{	
-		//search for the actual killer before calling OnKill()	
-		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
-		{		
-			AFightingVRPlayerController* TestPC = Cast<AFightingVRPlayerController>(*It);
-			if (TestPC && TestPC->IsLocalController())
-			{
-				// a local player might not have an ID if it was created with CreateDebugPlayer.
-				ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(TestPC->Player);
-				FUniqueNetIdRepl LocalID = LocalPlayer->GetCachedUniqueNetId();
-				if (LocalID.IsValid() &&  *LocalPlayer->GetCachedUniqueNetId() == *KillerPlayerState->GetUniqueId())
-				{			
-					TestPC->OnKill();
-				}
-			}
-		}
-	}
-}
-
-void AFightingVRPlayerState::BroadcastDeath_Implementation(class AFightingVRPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AFightingVRPlayerState* KilledPlayerState)
-{	
-	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	else
 	{
-		// all local players get death messages so they can update their huds.
-		AFightingVRPlayerController* TestPC = Cast<AFightingVRPlayerController>(*It);
-		if (TestPC && TestPC->IsLocalController())
-		{
-			TestPC->OnDeathMessage(KillerPlayerState, this, KillerDamageType);				
-		}
-	}	
+		SetScore(GetScore() + Points);
+	}
 }
 
 void AFightingVRPlayerState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
@@ -214,11 +197,22 @@ void AFightingVRPlayerState::GetLifetimeReplicatedProps( TArray< FLifetimeProper
 	DOREPLIFETIME( AFightingVRPlayerState, NumDeaths );
 }
 
-FString AFightingVRPlayerState::GetShortPlayerName() const
+void AFightingVRPlayerState::UpdateShortPlayerName()
 {
-	if( GetPlayerName().Len() > MAX_PLAYER_NAME_LENGTH )
+	const FString& PlayerName = GetPlayerName();
+	if (PlayerName.Len() > MAX_PLAYER_NAME_LENGTH)
+	{
+		ShortPlayerName = PlayerName.Left(MAX_PLAYER_NAME_LENGTH) + TEXT("...");
+	}
+	else if (ShortPlayerName != PlayerName)
 	{
-		return GetPlayerName().Left(MAX_PLAYER_NAME_LENGTH) + "...";
+		ShortPlayerName = PlayerName;
 	}
-	return GetPlayerName();
+	else
+	{
+		// unchanged, keep the existing text
+		return;
+	}
+
+	ShortPlayerNameText = FText::FromString(ShortPlayerName);
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Online/FightingVRReplayEvents.h"
+#include "FightingVR.h"
+#include "Engine/DemoNetDriver.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/** bump when the layout of the events file changes, older files are ignored */
+static const uint32 ReplayEventsFileVersion = 1;
+static const uint32 ReplayEventsFileMagic = 0x46565245; // 'FVRE'
+
+void UFightingVRReplayEventRecorder::Deinitialize()
+{
+	Flush();
+	Events.Reset();
+
+	Super::Deinitialize();
+}
+
+void UFightingVRReplayEventRecorder::RecordEvent(EFightingVRReplayEventType Type, const FString& Description)
+{
+	const UDemoNetDriver* DemoDriver = GetWorld() ? GetWorld()->GetDemoNetDriver() : nullptr;
+	if (DemoDriver == nullptr || !DemoDriver->IsRecording())
+	{
+		return;
+	}
+
+	const FString StreamName = DemoDriver->GetActiveReplayName();
+	if (StreamName != RecordingStreamName)
+	{
+		// a new recording was started in this world, finish the file of the previous one
+		Flush();
+		Events.Reset();
+		RecordingStreamName = StreamName;
+	}
+
+	FFightingVRReplayEvent& Event = Events.AddDefaulted_GetRef();
+	Event.Time = DemoDriver->GetDemoCurrentTime();
+	Event.Type = Type;
+	Event.Description = Description;
+	bEventsDirty = true;
+}
+
+void UFightingVRReplayEventRecorder::Flush()
+{
+	if (!bEventsDirty || RecordingStreamName.IsEmpty())
+	{
+		return;
+	}
+
+	// only a few hundred bytes, written at match state changes and when the recording stops
+	SaveEvents(RecordingStreamName, Events);
+
+	bEventsDirty = false;
+}
+
+bool UFightingVRReplayEventRecorder::SaveEvents(const FString& StreamName, const TArray<FFightingVRReplayEvent>& InEvents)
+{
+	if (StreamName.IsEmpty())
+	{
+		return false;
+	}
+
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = ReplayEventsFileMagic;
+	uint32 FileVersion = ReplayEventsFileVersion;
+	Writer << Magic;
+	Writer << FileVersion;
+	Writer << const_cast<TArray<FFightingVRReplayEvent>&>(InEvents);
+
+	const FString Filename = GetEventsFilename(StreamName);
+	if (!FFileHelper::SaveArrayToFile(FileData, *Filename))
+	{
+		UE_LOG(LogFightingVR, Warning, TEXT("Failed to write replay events %s"), *Filename);
+		return false;
+	}
+
+	return true;
+}
+
+bool UFightingVRReplayEventRecorder::LoadEvents(const FString& StreamName, TArray<FFightingVRReplayEvent>& OutEvents)
+{
+	OutEvents.Reset();
+
+	TArray<uint8> FileData;
+	const FString Filename = GetEventsFilename(StreamName);
+	if (StreamName.IsEmpty() || !FFileHelper::LoadFileToArray(FileData, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint32 FileVersion = 0;
+	Reader << Magic;
+	Reader << FileVersion;
+
+	if (Magic != ReplayEventsFileMagic || FileVersion != ReplayEventsFileVersion)
+	{
+		UE_LOG(LogFightingVR, Log, TEXT("Ignoring replay events %s, unknown format"), *Filename);
+		return false;
+	}
+
+	Reader << OutEvents;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogFightingVR, Warning, TEXT("Ignoring replay events %s, file is truncated"), *Filename);
+		OutEvents.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void UFightingVRReplayEventRecorder::DeleteEvents(const FString& StreamName)
+{
+	if (!StreamName.IsEmpty())
+	{
+		IFileManager::Get().Delete(*GetEventsFilename(StreamName), false, false, true);
+	}
+}
+
+FString UFightingVRReplayEventRecorder::GetEventsFilename(const FString& StreamName)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Demos"), StreamName + TEXT(".events"));
+}
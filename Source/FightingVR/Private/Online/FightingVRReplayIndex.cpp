@@ -0,0 +1,205 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FightingVRReplayIndex.h"
+#include "FightingVR.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/** bump when the layout of the index file changes, older files are discarded */
+static const uint32 ReplayIndexFileVersion = 1;
+static const uint32 ReplayIndexFileMagic = 0x46565249; // 'FVRI'
+
+static void SerializeStreamInfo(FArchive& Ar, FNetworkReplayStreamInfo& StreamInfo)
+{
+	Ar << StreamInfo.Name;
+	Ar << StreamInfo.FriendlyName;
+	Ar << StreamInfo.Timestamp;
+	Ar << StreamInfo.SizeInBytes;
+	Ar << StreamInfo.LengthInMS;
+	Ar << StreamInfo.NumViewers;
+	Ar << StreamInfo.Changelist;
+
+	bool bIsLive = StreamInfo.bIsLive;
+	bool bShouldKeep = StreamInfo.bShouldKeep;
+	Ar << bIsLive;
+	Ar << bShouldKeep;
+	StreamInfo.bIsLive = bIsLive;
+	StreamInfo.bShouldKeep = bShouldKeep;
+}
+
+FFightingVRReplayIndex& FFightingVRReplayIndex::Get()
+{
+	static FFightingVRReplayIndex Instance;
+	return Instance;
+}
+
+FFightingVRReplayIndex::FFightingVRReplayIndex()
+	: bSaveInFlight(false)
+{
+	IndexFilename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Demos"), TEXT("ReplayIndex.dat"));
+	Load();
+}
+
+uint32 FFightingVRReplayIndex::GetVersionKey(const FNetworkReplayVersion& Version)
+{
+	// the demo list only ever varies the network version, changelist is always 0
+	return Version.NetworkVersion;
+}
+
+bool FFightingVRReplayIndex::IsSameStream(const FNetworkReplayStreamInfo& A, const FNetworkReplayStreamInfo& B)
+{
+	return A.Name == B.Name && A.Timestamp == B.Timestamp;
+}
+
+const TArray<FNetworkReplayStreamInfo>& FFightingVRReplayIndex::GetStreams(const FNetworkReplayVersion& Version) const
+{
+	static const TArray<FNetworkReplayStreamInfo> NoStreams;
+
+	const TArray<FNetworkReplayStreamInfo>* Streams = StreamsByVersion.Find(GetVersionKey(Version));
+	return Streams ? *Streams : NoStreams;
+}
+
+void FFightingVRReplayIndex::SetStreams(const FNetworkReplayVersion& Version, TArray<FNetworkReplayStreamInfo>&& Streams)
+{
+	TArray<FNetworkReplayStreamInfo>& CachedStreams = StreamsByVersion.FindOrAdd(GetVersionKey(Version));
+
+	bool bChanged = CachedStreams.Num() != Streams.Num();
+	for (int32 i = 0; !bChanged && i < Streams.Num(); ++i)
+	{
+		const FNetworkReplayStreamInfo& Cached = CachedStreams[i];
+		const FNetworkReplayStreamInfo& Found = Streams[i];
+		bChanged = !IsSameStream(Cached, Found) || Cached.SizeInBytes != Found.SizeInBytes || Cached.LengthInMS != Found.LengthInMS || Cached.bIsLive != Found.bIsLive;
+	}
+
+	CachedStreams = MoveTemp(Streams);
+
+	if (bChanged)
+	{
+		Save();
+	}
+}
+
+void FFightingVRReplayIndex::RemoveStream(const FString& StreamName)
+{
+	bool bChanged = false;
+	for (TPair<uint32, TArray<FNetworkReplayStreamInfo>>& VersionStreams : StreamsByVersion)
+	{
+		bChanged |= VersionStreams.Value.RemoveAll([&StreamName](const FNetworkReplayStreamInfo& StreamInfo) { return StreamInfo.Name == StreamName; }) > 0;
+	}
+
+	if (bChanged)
+	{
+		Save();
+	}
+}
+
+void FFightingVRReplayIndex::Load()
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *IndexFilename, FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint32 FileVersion = 0;
+	Reader << Magic;
+	Reader << FileVersion;
+
+	if (Magic != ReplayIndexFileMagic || FileVersion != ReplayIndexFileVersion)
+	{
+		UE_LOG(LogFightingVR, Log, TEXT("Discarding replay index %s, unknown format"), *IndexFilename);
+		return;
+	}
+
+	int32 NumVersions = 0;
+	Reader << NumVersions;
+
+	for (int32 VersionIdx = 0; VersionIdx < NumVersions && !Reader.IsError(); ++VersionIdx)
+	{
+		uint32 VersionKey = 0;
+		int32 NumStreams = 0;
+		Reader << VersionKey;
+		Reader << NumStreams;
+
+		TArray<FNetworkReplayStreamInfo>& Streams = StreamsByVersion.FindOrAdd(VersionKey);
+		Streams.Reset();
+
+		for (int32 StreamIdx = 0; StreamIdx < NumStreams && !Reader.IsError(); ++StreamIdx)
+		{
+			SerializeStreamInfo(Reader, Streams.AddDefaulted_GetRef());
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogFightingVR, Warning, TEXT("Discarding replay index %s, file is truncated"), *IndexFilename);
+		StreamsByVersion.Reset();
+	}
+}
+
+void FFightingVRReplayIndex::Save()
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = ReplayIndexFileMagic;
+	uint32 FileVersion = ReplayIndexFileVersion;
+	int32 NumVersions = StreamsByVersion.Num();
+	Writer << Magic;
+	Writer << FileVersion;
+	Writer << NumVersions;
+
+	for (const TPair<uint32, TArray<FNetworkReplayStreamInfo>>& VersionStreams : StreamsByVersion)
+	{
+		uint32 VersionKey = VersionStreams.Key;
+		int32 NumStreams = VersionStreams.Value.Num();
+		Writer << VersionKey;
+		Writer << NumStreams;
+
+		for (FNetworkReplayStreamInfo StreamInfo : VersionStreams.Value)
+		{
+			SerializeStreamInfo(Writer, StreamInfo);
+		}
+	}
+
+	// the index is only a cache, so a write lost to a crash just means a slower next open
+	FScopeLock Lock(&SaveCritical);
+	PendingSaveData = MoveTemp(FileData);
+
+	// a single task writes the file, so saves can't interleave or land out of order
+	if (!bSaveInFlight)
+	{
+		bSaveInFlight = true;
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this]()
+		{
+			WritePendingSaves();
+		});
+	}
+}
+
+void FFightingVRReplayIndex::WritePendingSaves()
+{
+	for (;;)
+	{
+		TArray<uint8> FileData;
+		{
+			FScopeLock Lock(&SaveCritical);
+			if (PendingSaveData.Num() == 0)
+			{
+				bSaveInFlight = false;
+				return;
+			}
+
+			FileData = MoveTemp(PendingSaveData);
+			PendingSaveData.Reset();
+		}
+
+		FFileHelper::SaveArrayToFile(FileData, *IndexFilename);
+	}
+}
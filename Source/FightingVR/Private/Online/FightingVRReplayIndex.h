@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "NetworkReplayStreaming.h"
+
+/**
+ * On-disk cache of replay stream metadata, keyed by stream name and timestamp.
+ * Lets the demo browser show the last known replays while the streamer enumerates in the background.
+ */
+class FFightingVRReplayIndex
+{
+public:
+
+	/** Returns the index, loading it from disk on first use */
+	static FFightingVRReplayIndex& Get();
+
+	/**
+	 * Returns the cached streams for an enumeration version, newest first.
+	 *
+	 * @param	Version		Version the streams were enumerated with.
+	 */
+	const TArray<FNetworkReplayStreamInfo>& GetStreams(const FNetworkReplayVersion& Version) const;
+
+	/**
+	 * Replaces the cached streams for an enumeration version and saves the index in the background if anything changed.
+	 *
+	 * @param	Version		Version the streams were enumerated with.
+	 * @param	Streams		Streams found, newest first.
+	 */
+	void SetStreams(const FNetworkReplayVersion& Version, TArray<FNetworkReplayStreamInfo>&& Streams);
+
+	/**
+	 * Removes a deleted stream from all cached versions.
+	 *
+	 * @param	StreamName	Name of the deleted stream.
+	 */
+	void RemoveStream(const FString& StreamName);
+
+	/** Returns true if both infos describe the same recording */
+	static bool IsSameStream(const FNetworkReplayStreamInfo& A, const FNetworkReplayStreamInfo& B);
+
+private:
+
+	FFightingVRReplayIndex();
+
+	/** Key used to store streams of an enumeration version */
+	static uint32 GetVersionKey(const FNetworkReplayVersion& Version);
+
+	/** Reads the index file, discarding it if the format is unknown */
+	void Load();
+
+	/** Writes the index file on a background thread */
+	void Save();
+
+	/** Background thread, writes the latest saved index data until none is left */
+	void WritePendingSaves();
+
+	/** Cached streams per enumeration version, newest first */
+	TMap<uint32, TArray<FNetworkReplayStreamInfo>> StreamsByVersion;
+
+	/** Full path of the index file */
+	FString IndexFilename;
+
+	/** Guards PendingSaveData and bSaveInFlight */
+	FCriticalSection SaveCritical;
+
+	/** Latest index data not written yet, older data is replaced rather than written */
+	TArray<uint8> PendingSaveData;
+
+	/** True while a background task writes the index, only one ever writes the file */
+	bool bSaveInFlight;
+};
@@ -50,6 +50,8 @@
 *		the graph leaner since no extra work has to be done for the weapon actors.
 *		
 *		See UFightingVRReplicationGraph::OnCharacterWeaponChange: this is how actors are added/removed from the dependent actor list. 
+*		
+*		Weapons parked in the game mode's weapon pool between respawns are the exception: they sit in the AlwaysRelevantNode until they go dormant (see OnWeaponParked).
 *	
 *	How To Use
 *	
@@ -93,6 +95,7 @@
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/Pawn.h"
 #include "Engine/LevelScriptActor.h"
+#include "Engine/DemoNetDriver.h"
 #include "Player/FightingVRCharacter.h"
 #include "Online/FightingVRPlayerState.h"
 #include "Weapons/FightingVRWeapon.h"
@@ -124,6 +127,10 @@ static FAutoConsoleVariableRef CVarFightingVRRepDynamicActorFrequencyBuckets(TEX
 int32 CVar_FightingVRRepGraph_DisableSpatialRebuilds = 1;
 static FAutoConsoleVariableRef CVarFightingVRRepDisableSpatialRebuilds(TEXT("FightingVRRepGraph.DisableSpatialRebuilds"), CVar_FightingVRRepGraph_DisableSpatialRebuilds, TEXT(""), ECVF_Default );
 
+// Read when a demo net driver creates its graph. Set by the replay profile before recording starts.
+int32 CVar_FightingVRRepGraph_Replay_FilterLowValueActors = 0;
+static FAutoConsoleVariableRef CVarFightingVRRepGraphReplayFilterLowValueActors(TEXT("FightingVRRepGraph.Replay.FilterLowValueActors"), CVar_FightingVRRepGraph_Replay_FilterLowValueActors, TEXT("If > 0, ReplayLowValueActorClasses are not routed by replay recording graphs"), ECVF_Default );
+
 // ----------------------------------------------------------------------------------------------------------
 
 
@@ -270,6 +277,40 @@ void UFightingVRReplicationGraph::InitGlobalActorClassSettings()
 		}
 	}
 
+	// Replays don't need cosmetic/low value actors. Never routing them keeps them out of the demo stream and out of the recording cost.
+	const UDemoNetDriver* DemoNetDriver = Cast<UDemoNetDriver>(NetDriver);
+	if (DemoNetDriver && !DemoNetDriver->IsPlaying() && CVar_FightingVRRepGraph_Replay_FilterLowValueActors > 0)
+	{
+		if (ReplayLowValueActorClasses.Num() == 0)
+		{
+			UE_LOG(LogFightingVRReplicationGraph, Log, TEXT("Replay low value actor filtering is on, but no ReplayLowValueActorClasses are configured"));
+		}
+
+		for (const FSoftClassPath& LowValueClassPath : ReplayLowValueActorClasses)
+		{
+			UClass* LowValueClass = LowValueClassPath.TryLoadClass<AActor>();
+			if (LowValueClass == nullptr)
+			{
+				UE_LOG(LogFightingVRReplicationGraph, Warning, TEXT("Replay low value actor class %s not found"), *LowValueClassPath.ToString());
+				continue;
+			}
+
+			AddInfo(LowValueClass, EClassRepNodeMapping::NotRouted);
+
+			// Child classes that were added explicitly above would otherwise keep their own policy
+			for (auto It = ClassRepNodePolicies.CreateIterator(); It; ++It)
+			{
+				UClass* Class = Cast<UClass>(It.Key().ResolveObjectPtr());
+				if (Class && Class->IsChildOf(LowValueClass))
+				{
+					It.Value() = EClassRepNodeMapping::NotRouted;
+				}
+			}
+
+			UE_LOG(LogFightingVRReplicationGraph, Log, TEXT("Filtering %s from replay recording"), *LowValueClass->GetName());
+		}
+	}
+
 	// -----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 	// Setup FClassReplicationInfo. This is essentially the per class replication settings. Some we set explicitly, the rest we are setting via looking at the legacy settings on AActor.
 	// -----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -350,6 +391,8 @@ void UFightingVRReplicationGraph::InitGlobalActorClassSettings()
 	
 	AFightingVRCharacter::NotifyEquipWeapon.AddUObject(this, &UFightingVRReplicationGraph::OnCharacterEquipWeapon);
 	AFightingVRCharacter::NotifyUnEquipWeapon.AddUObject(this, &UFightingVRReplicationGraph::OnCharacterUnEquipWeapon);
+	AFightingVRWeapon::NotifyParked.AddUObject(this, &UFightingVRReplicationGraph::OnWeaponParked);
+	AFightingVRWeapon::NotifyUnparked.AddUObject(this, &UFightingVRReplicationGraph::OnWeaponUnparked);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &UFightingVRReplicationGraph::OnGameplayDebuggerOwnerChange);
@@ -531,6 +574,27 @@ void UFightingVRReplicationGraph::OnCharacterUnEquipWeapon(AFightingVRCharacter*
 	}
 }
 
+void UFightingVRReplicationGraph::OnWeaponParked(AFightingVRWeapon* Weapon)
+{
+	if (Weapon)
+	{
+		CHECK_WORLDS(Weapon);
+
+		// Parked weapons have no pawn to depend on. Keep them gathered so their last state reaches clients and their channels close as dormant rather than destroyed.
+		AlwaysRelevantNode->NotifyAddNetworkActor(FNewReplicatedActorInfo(Weapon));
+	}
+}
+
+void UFightingVRReplicationGraph::OnWeaponUnparked(AFightingVRWeapon* Weapon)
+{
+	if (Weapon)
+	{
+		CHECK_WORLDS(Weapon);
+
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(FNewReplicatedActorInfo(Weapon));
+	}
+}
+
 #if WITH_GAMEPLAY_DEBUGGER
 void UFightingVRReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
 {
@@ -53,6 +53,16 @@ public:
 
 	UPROPERTY()
 	TArray<UClass*>	AlwaysRelevantClasses;
+
+	/**
+	 * Cosmetic/low value actor classes left out of replay recordings when FightingVRRepGraph.Replay.FilterLowValueActors is set.
+	 * Opt-in and empty by default: the game's replicated C++ actors all matter for playback, so the list is meant for
+	 * project Blueprints, e.g. in DefaultEngine.ini:
+	 *   [/Script/FightingVR.FightingVRReplicationGraph]
+	 *   +ReplayLowValueActorClasses=/Game/Blueprints/BP_AmbientProp.BP_AmbientProp_C
+	 */
+	UPROPERTY(config)
+	TArray<FSoftClassPath> ReplayLowValueActorClasses;
 	
 	UPROPERTY()
 	UReplicationGraphNode_GridSpatialization2D* GridNode;
@@ -65,6 +75,9 @@ public:
 	void OnCharacterEquipWeapon(AFightingVRCharacter* Character, AFightingVRWeapon* NewWeapon);
 	void OnCharacterUnEquipWeapon(AFightingVRCharacter* Character, AFightingVRWeapon* OldWeapon);
 
+	void OnWeaponParked(AFightingVRWeapon* Weapon);
+	void OnWeaponUnparked(AFightingVRWeapon* Weapon);
+
 #if WITH_GAMEPLAY_DEBUGGER
 	void OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner);
 #endif
@@ -14,6 +14,15 @@ namespace
 AFightingVRSession::AFightingVRSession(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	RegisterServerRetryDelay = 2.0f;
+	RegisterServerMaxRetryDelay = 60.0f;
+	ServerHeartbeatInterval = 30.0f;
+	bRegisteringServer = false;
+	bRegisterServerAttemptPending = false;
+	RegisterServerAttempts = 0;
+	RegisterServerStartTime = 0.0;
+	RegisterServerAttemptStartTime = 0.0;
+
 	if (!HasAnyFlags(RF_ClassDefaultObject))
 	{
 		OnCreateSessionCompleteDelegate = FOnCreateSessionCompleteDelegate::CreateUObject(this, &AFightingVRSession::OnCreateSessionComplete);
@@ -176,6 +185,17 @@ void AFightingVRSession::OnCreateSessionComplete(FName InSessionName, bool bWasS
 		Sessions->ClearOnCreateSessionCompleteDelegate_Handle(OnCreateSessionCompleteDelegateHandle);
 	}
 
+	if (bRegisteringServer && InSessionName == NAME_GameSession)
+	{
+		OnRegisterServerComplete(bWasSuccessful);
+
+		// failed attempts are retried, listeners only hear about the registration that went through
+		if (!bWasSuccessful)
+		{
+			return;
+		}
+	}
+
 	OnCreatePresenceSessionComplete().Broadcast(InSessionName, bWasSuccessful);	
 }
 
@@ -196,6 +216,11 @@ void AFightingVRSession::OnDestroySessionComplete(FName InSessionName, bool bWas
 		Sessions->ClearOnDestroySessionCompleteDelegate_Handle(OnDestroySessionCompleteDelegateHandle);
 		HostSettings = NULL;
 	}
+
+	if (bRegisteringServer && InSessionName == NAME_GameSession)
+	{
+		RetryRegisterServer();
+	}
 }
 
 bool AFightingVRSession::HostSession(TSharedPtr<const FUniqueNetId> UserId, FName InSessionName, const FString& GameType, const FString& MapName, bool bIsLAN, bool bIsPresence, int32 MaxNumPlayers)
@@ -476,28 +501,174 @@ bool AFightingVRSession::TravelToSession(int32 ControllerId, FName InSessionName
 
 void AFightingVRSession::RegisterServer()
 {
-	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
-	if (OnlineSub)
+	if (bRegisteringServer)
+	{
+		return;
+	}
+
+	bRegisteringServer = true;
+	RegisterServerAttempts = 0;
+	RegisterServerStartTime = FPlatformTime::Seconds();
+
+	AttemptRegisterServer();
+}
+
+TSharedPtr<FFightingVROnlineSessionSettings> AFightingVRSession::BuildServerSettings() const
+{
+	TSharedPtr<class FFightingVROnlineSessionSettings> FightingVRHostSettings = MakeShareable(new FFightingVROnlineSessionSettings(false, false, 16));
+	FightingVRHostSettings->Set(SETTING_MATCHING_HOPPER, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::DontAdvertise);
+	FightingVRHostSettings->Set(SETTING_MATCHING_TIMEOUT, 120.0f, EOnlineDataAdvertisementType::ViaOnlineService);
+	FightingVRHostSettings->Set(SETTING_SESSION_TEMPLATE_NAME, FString("GameSession"), EOnlineDataAdvertisementType::DontAdvertise);
+	FightingVRHostSettings->Set(SETTING_GAMEMODE, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::ViaOnlineService);
+	FightingVRHostSettings->Set(SETTING_MAPNAME, GetWorld()->GetMapName(), EOnlineDataAdvertisementType::ViaOnlineService);
+	FightingVRHostSettings->bAllowInvites = true;
+	FightingVRHostSettings->bIsDedicated = true;
+	if (FParse::Param(FCommandLine::Get(), TEXT("forcelan")))
+	{
+		FightingVRHostSettings->bIsLANMatch = true;
+	}
+	return FightingVRHostSettings;
+}
+
+void AFightingVRSession::AttemptRegisterServer()
+{
+	IOnlineSessionPtr SessionInt = Online::GetSessionInterface(GetWorld());
+	if (!SessionInt.IsValid())
+	{
+		bRegisteringServer = false;
+		return;
+	}
+
+	HostSettings = BuildServerSettings();
+	if (RegisterServerAttempts == 0 && HostSettings->bIsLANMatch)
+	{
+		UE_LOG(LogOnlineGame, Log, TEXT("Registering server as a LAN server"));
+	}
+
+	++RegisterServerAttempts;
+	RegisterServerAttemptStartTime = FPlatformTime::Seconds();
+	bRegisterServerAttemptPending = true;
+
+	OnCreateSessionCompleteDelegateHandle = SessionInt->AddOnCreateSessionCompleteDelegate_Handle(OnCreateSessionCompleteDelegate);
+	if (!SessionInt->CreateSession(0, NAME_GameSession, *HostSettings) && bRegisterServerAttemptPending)
+	{
+		// some subsystems fail synchronously without firing the delegate, others (like Null) fire it and return false as well
+		SessionInt->ClearOnCreateSessionCompleteDelegate_Handle(OnCreateSessionCompleteDelegateHandle);
+		OnRegisterServerComplete(false);
+	}
+}
+
+void AFightingVRSession::OnRegisterServerComplete(bool bWasSuccessful)
+{
+	// each attempt is handled once, however the subsystem reports it
+	if (!bRegisteringServer || !bRegisterServerAttemptPending)
+	{
+		return;
+	}
+
+	bRegisterServerAttemptPending = false;
+
+	const double Now = FPlatformTime::Seconds();
+	UE_LOG(LogOnlineGame, Log, TEXT("RegisterServer: Attempt=%d Success=%d AttemptMs=%.1f TotalMs=%.1f"),
+		RegisterServerAttempts,
+		bWasSuccessful ? 1 : 0,
+		(Now - RegisterServerAttemptStartTime) * 1000.0,
+		(Now - RegisterServerStartTime) * 1000.0);
+
+	if (bWasSuccessful)
 	{
-		IOnlineSessionPtr SessionInt = OnlineSub->GetSessionInterface();
-		if (SessionInt.IsValid())
+		bRegisteringServer = false;
+
+		if (ServerHeartbeatInterval > 0.0f)
 		{
-			TSharedPtr<class FFightingVROnlineSessionSettings> FightingVRHostSettings = MakeShareable(new FFightingVROnlineSessionSettings(false, false, 16));
-			FightingVRHostSettings->Set(SETTING_MATCHING_HOPPER, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::DontAdvertise);
-			FightingVRHostSettings->Set(SETTING_MATCHING_TIMEOUT, 120.0f, EOnlineDataAdvertisementType::ViaOnlineService);
-			FightingVRHostSettings->Set(SETTING_SESSION_TEMPLATE_NAME, FString("GameSession"), EOnlineDataAdvertisementType::DontAdvertise);
-			FightingVRHostSettings->Set(SETTING_GAMEMODE, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::ViaOnlineService);
-			FightingVRHostSettings->Set(SETTING_MAPNAME, GetWorld()->GetMapName(), EOnlineDataAdvertisementType::ViaOnlineService);
-			FightingVRHostSettings->bAllowInvites = true;
-			FightingVRHostSettings->bIsDedicated = true;
-			if (FParse::Param(FCommandLine::Get(), TEXT("forcelan")))
-			{
-				UE_LOG(LogOnlineGame, Log, TEXT("Registering server as a LAN server"));
-				FightingVRHostSettings->bIsLANMatch = true;
-			}
-			HostSettings = FightingVRHostSettings;
-			OnCreateSessionCompleteDelegateHandle = SessionInt->AddOnCreateSessionCompleteDelegate_Handle(OnCreateSessionCompleteDelegate);
-			SessionInt->CreateSession(0, NAME_GameSession, *HostSettings);
+			GetWorldTimerManager().SetTimer(TimerHandle_ServerHeartbeat, this, &AFightingVRSession::ServerHeartbeat, ServerHeartbeatInterval, true);
+		}
+		return;
+	}
+
+	// a failed create can leave the named session behind, which would make every retry fail too,
+	// so the retry waits for OnDestroySessionComplete
+	IOnlineSessionPtr SessionInt = Online::GetSessionInterface(GetWorld());
+	if (SessionInt.IsValid() && SessionInt->GetNamedSession(NAME_GameSession))
+	{
+		OnDestroySessionCompleteDelegateHandle = SessionInt->AddOnDestroySessionCompleteDelegate_Handle(OnDestroySessionCompleteDelegate);
+		if (!SessionInt->DestroySession(NAME_GameSession))
+		{
+			SessionInt->ClearOnDestroySessionCompleteDelegate_Handle(OnDestroySessionCompleteDelegateHandle);
+			RetryRegisterServer();
 		}
+		return;
+	}
+
+	RetryRegisterServer();
+}
+
+void AFightingVRSession::RetryRegisterServer()
+{
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	if (bRegisterServerAttemptPending || TimerManager.IsTimerActive(TimerHandle_RetryRegisterServer))
+	{
+		return;
+	}
+
+	// exponential backoff with some jitter, so a fleet of servers doesn't retry in lockstep
+	const float BackoffDelay = RegisterServerRetryDelay * FMath::Pow(2.0f, FMath::Min(RegisterServerAttempts - 1, 16));
+	const float RetryDelay = FMath::Min(BackoffDelay, RegisterServerMaxRetryDelay) * FMath::FRandRange(0.8f, 1.2f);
+
+	UE_LOG(LogOnlineGame, Warning, TEXT("RegisterServer: attempt %d failed, retrying in %.1fs"), RegisterServerAttempts, RetryDelay);
+	TimerManager.SetTimer(TimerHandle_RetryRegisterServer, this, &AFightingVRSession::AttemptRegisterServer, FMath::Max(RetryDelay, 0.1f), false);
+}
+
+/** true if a setting is sent to the online service, as opposed to kept locally or only sent in ping replies */
+static bool IsAdvertisedOnline(const FOnlineSessionSetting& Setting)
+{
+	return Setting.AdvertisementType == EOnlineDataAdvertisementType::ViaOnlineService || Setting.AdvertisementType == EOnlineDataAdvertisementType::ViaOnlineServiceAndPing;
+}
+
+void AFightingVRSession::ServerHeartbeat()
+{
+	IOnlineSessionPtr SessionInt = Online::GetSessionInterface(GetWorld());
+	if (!SessionInt.IsValid() || bRegisteringServer)
+	{
+		return;
+	}
+
+	if (SessionInt->GetNamedSession(NAME_GameSession) == nullptr || !HostSettings.IsValid())
+	{
+		UE_LOG(LogOnlineGame, Warning, TEXT("RegisterServer: session lost, registering again"));
+		GetWorldTimerManager().ClearTimer(TimerHandle_ServerHeartbeat);
+		RegisterServer();
+		return;
+	}
+
+	// only the changed keys are applied, and the online service is only refreshed when one of them is advertised through it
+	TSharedPtr<FFightingVROnlineSessionSettings> NewSettings = BuildServerSettings();
+	int32 NumChangedKeys = 0;
+	bool bAdvertisedKeyChanged = false;
+	for (const TPair<FName, FOnlineSessionSetting>& NewSetting : NewSettings->Settings)
+	{
+		const FOnlineSessionSetting* OldSetting = HostSettings->Settings.Find(NewSetting.Key);
+		if (OldSetting == nullptr || OldSetting->Data != NewSetting.Value.Data || OldSetting->AdvertisementType != NewSetting.Value.AdvertisementType)
+		{
+			bAdvertisedKeyChanged |= IsAdvertisedOnline(NewSetting.Value) || (OldSetting && IsAdvertisedOnline(*OldSetting));
+			HostSettings->Settings.Add(NewSetting.Key, NewSetting.Value);
+			++NumChangedKeys;
+		}
+	}
+
+	for (auto It = HostSettings->Settings.CreateIterator(); It; ++It)
+	{
+		if (!NewSettings->Settings.Contains(It.Key()))
+		{
+			bAdvertisedKeyChanged |= IsAdvertisedOnline(It.Value());
+			++NumChangedKeys;
+			It.RemoveCurrent();
+		}
+	}
+
+	if (NumChangedKeys > 0)
+	{
+		UE_LOG(LogOnlineGame, Log, TEXT("RegisterServer: %d session settings changed, refreshing online data: %d"), NumChangedKeys, bAdvertisedKeyChanged ? 1 : 0);
+		SessionInt->UpdateSession(NAME_GameSession, *HostSettings, bAdvertisedKeyChanged);
 	}
 }
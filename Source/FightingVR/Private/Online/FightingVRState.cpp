@@ -3,15 +3,66 @@
 #include "FightingVRState.h"
 #include "FightingVR.h"
 #include "Online/FightingVRPlayerState.h"
+#include "Player/FightingVRLocalPlayerRegistry.h"
+#include "Online/FightingVRReplayEvents.h"
 #include "FightingVRInstance.h"
 #include "OnlineSubsystemUtils.h"
 #include "OnlineGameMatchesInterface.h"
 
+/** number of kills kept in the replicated kill feed, matches the HUD death message count */
+static const int32 MaxKillFeedEntries = 5;
+
+/** kills older than this are not announced, e.g. when joining a match in progress */
+static const float MaxKillFeedEntryAge = 10.0f;
+
+void FFightingVRKillFeedEntry::PostReplicatedAdd(const FFightingVRKillFeed& InArraySerializer)
+{
+	ConditionallyAnnounce(InArraySerializer);
+}
+
+void FFightingVRKillFeedEntry::PostReplicatedChange(const FFightingVRKillFeed& InArraySerializer)
+{
+	// the fast array calls this again once player state references that were unmapped on add resolve
+	ConditionallyAnnounce(InArraySerializer);
+}
+
+void FFightingVRKillFeedEntry::ConditionallyAnnounce(const FFightingVRKillFeed& InArraySerializer)
+{
+	if (bAnnounced || InArraySerializer.Owner == nullptr)
+	{
+		return;
+	}
+
+	if (VictimPlayerState == nullptr || (bHasKiller && KillerPlayerState == nullptr))
+	{
+		UE_LOG(LogFightingVR, Verbose, TEXT("Kill feed entry %d arrived before its player states, waiting for them to be mapped"), ReplicationID);
+		return;
+	}
+
+	bAnnounced = true;
+	InArraySerializer.Owner->NotifyKill(*this);
+	InArraySerializer.Owner->RecordReplayKill(*this);
+}
+
+FFightingVRKillFeedEntry& FFightingVRKillFeed::AddEntry(int32 MaxEntries)
+{
+	if (Entries.Num() >= MaxEntries)
+	{
+		Entries.RemoveAt(0, Entries.Num() - MaxEntries + 1, false);
+		MarkArrayDirty();
+	}
+
+	FFightingVRKillFeedEntry& NewEntry = Entries.AddDefaulted_GetRef();
+	MarkItemDirty(NewEntry);
+	return NewEntry;
+}
+
 AFightingVRState::AFightingVRState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NumTeams = 0;
 	RemainingTime = 0;
 	bTimerPaused = false;
+	KillFeed.Owner = this;
 
 	UFightingVRInstance* GameInstance = GetWorld() != nullptr ? Cast<UFightingVRInstance>(GetWorld()->GetGameInstance()) : nullptr;
 
@@ -26,6 +77,137 @@ void AFightingVRState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > &
 	DOREPLIFETIME( AFightingVRState, RemainingTime );
 	DOREPLIFETIME( AFightingVRState, bTimerPaused );
 	DOREPLIFETIME( AFightingVRState, TeamScores );
+	DOREPLIFETIME( AFightingVRState, KillFeed );
+}
+
+void AFightingVRState::AddKill(AFightingVRPlayerState* KillerPlayerState, AFightingVRPlayerState* VictimPlayerState, const UDamageType* DamageType)
+{
+	FFightingVRKillFeedEntry& NewEntry = KillFeed.AddEntry(MaxKillFeedEntries);
+	NewEntry.KillerPlayerState = KillerPlayerState;
+	NewEntry.VictimPlayerState = VictimPlayerState;
+	NewEntry.bHasKiller = KillerPlayerState != nullptr;
+	NewEntry.DamageTypeClass = DamageType ? DamageType->GetClass() : nullptr;
+	NewEntry.KillTime = GetServerWorldTimeSeconds();
+
+	// remote clients are notified when the entry replicates, local players on a listen server or standalone need it now
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		NotifyKill(NewEntry);
+	}
+
+	RecordReplayKill(NewEntry);
+}
+
+void AFightingVRState::RecordReplayKill(const FFightingVRKillFeedEntry& Entry)
+{
+	if (Entry.VictimPlayerState == nullptr)
+	{
+		return;
+	}
+
+	UFightingVRReplayEventRecorder* ReplayEvents = GetWorld()->GetSubsystem<UFightingVRReplayEventRecorder>();
+	if (ReplayEvents == nullptr)
+	{
+		return;
+	}
+
+	if (Entry.KillerPlayerState && Entry.KillerPlayerState != Entry.VictimPlayerState)
+	{
+		ReplayEvents->RecordEvent(EFightingVRReplayEventType::Kill, FString::Printf(TEXT("%s > %s"), *Entry.KillerPlayerState->GetPlayerName(), *Entry.VictimPlayerState->GetPlayerName()));
+	}
+	else
+	{
+		ReplayEvents->RecordEvent(EFightingVRReplayEventType::Death, Entry.VictimPlayerState->GetPlayerName());
+	}
+}
+
+void AFightingVRState::NotifyKill(const FFightingVRKillFeedEntry& Entry)
+{
+	if (Entry.VictimPlayerState == nullptr || GetServerWorldTimeSeconds() - Entry.KillTime > MaxKillFeedEntryAge)
+	{
+		return;
+	}
+
+	const UDamageType* DamageType = Entry.DamageTypeClass ? Entry.DamageTypeClass->GetDefaultObject<UDamageType>() : nullptr;
+	const bool bIsSuicide = Entry.KillerPlayerState == Entry.VictimPlayerState;
+
+	const UFightingVRLocalPlayerRegistry* LocalPlayerRegistry = GetWorld()->GetSubsystem<UFightingVRLocalPlayerRegistry>();
+	if (LocalPlayerRegistry == nullptr)
+	{
+		return;
+	}
+
+	AFightingVRPlayerController* KillerPC = bIsSuicide ? nullptr : LocalPlayerRegistry->FindByPlayerState(Entry.KillerPlayerState);
+	if (KillerPC)
+	{
+		KillerPC->OnKill();
+	}
+
+	// all local players get death messages so they can update their huds.
+	for (AFightingVRPlayerController* LocalPC : LocalPlayerRegistry->GetLocalControllers())
+	{
+		if (LocalPC)
+		{
+			LocalPC->OnDeathMessage(Entry.KillerPlayerState, Entry.VictimPlayerState, DamageType);
+		}
+	}
+}
+
+void AFightingVRState::AddPendingScore(AFightingVRPlayerState* PlayerState, int32 Points)
+{
+	if (PlayerState == nullptr)
+	{
+		return;
+	}
+
+	PendingPlayerScores.FindOrAdd(PlayerState) += Points;
+
+	// the team is taken now, so a team change before the flush can't move these points
+	const int32 TeamNumber = PlayerState->GetTeamNum();
+	if (TeamNumber >= 0)
+	{
+		if (TeamNumber >= PendingTeamScores.Num())
+		{
+			PendingTeamScores.AddZeroed(TeamNumber - PendingTeamScores.Num() + 1);
+		}
+
+		PendingTeamScores[TeamNumber] += Points;
+	}
+
+	if (!TimerHandle_FlushPendingScores.IsValid())
+	{
+		TimerHandle_FlushPendingScores = GetWorldTimerManager().SetTimerForNextTick(this, &AFightingVRState::FlushPendingScores);
+	}
+}
+
+void AFightingVRState::FlushPendingScores()
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_FlushPendingScores);
+
+	if (PendingTeamScores.Num() > 0)
+	{
+		if (PendingTeamScores.Num() > TeamScores.Num())
+		{
+			TeamScores.AddZeroed(PendingTeamScores.Num() - TeamScores.Num());
+		}
+
+		for (int32 TeamNumber = 0; TeamNumber < PendingTeamScores.Num(); ++TeamNumber)
+		{
+			TeamScores[TeamNumber] += PendingTeamScores[TeamNumber];
+		}
+
+		PendingTeamScores.Reset();
+	}
+
+	for (const TPair<TWeakObjectPtr<AFightingVRPlayerState>, int32>& PendingScore : PendingPlayerScores)
+	{
+		if (AFightingVRPlayerState* PlayerState = PendingScore.Key.Get())
+		{
+			PlayerState->SetScore(PlayerState->GetScore() + PendingScore.Value);
+		}
+	}
+
+	PendingPlayerScores.Reset();
 }
 
 void AFightingVRState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
@@ -87,6 +269,18 @@ void AFightingVRState::RequestFinishAndExitToMainMenu()
 	}
 }
 
+void AFightingVRState::OnRep_MatchState()
+{
+	Super::OnRep_MatchState();
+
+	// also called on the server when the state is set, so recording clients and servers both get it
+	if (UFightingVRReplayEventRecorder* ReplayEvents = GetWorld()->GetSubsystem<UFightingVRReplayEventRecorder>())
+	{
+		ReplayEvents->RecordEvent(EFightingVRReplayEventType::MatchState, MatchState.ToString());
+		ReplayEvents->Flush();
+	}
+}
+
 void AFightingVRState::HandleMatchHasStarted()
 {
 	Super::HandleMatchHasStarted();
@@ -97,4 +291,16 @@ void AFightingVRState::HandleMatchHasEnded()
 {
 	Super::HandleMatchHasEnded();
 	GameMatches.HandleMatchHasEnded(bEnableGameFeedback, NumTeams, MakeArrayView(TeamScores));
+}
+
+void AFightingVRState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+	AFightingVRPlayerState::NotifyRosterChanged.Broadcast(Cast<AFightingVRPlayerState>(PlayerState));
+}
+
+void AFightingVRState::RemovePlayerState(APlayerState* PlayerState)
+{
+	Super::RemovePlayerState(PlayerState);
+	AFightingVRPlayerState::NotifyRosterChanged.Broadcast(Cast<AFightingVRPlayerState>(PlayerState));
 }
\ No newline at end of file
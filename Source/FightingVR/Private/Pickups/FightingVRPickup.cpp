@@ -2,6 +2,7 @@
 
 #include "Pickups/FightingVRPickup.h"
 #include "FightingVR.h"
+#include "Pickups/FightingVRPickupRespawnScheduler.h"
 #include "Particles/ParticleSystemComponent.h"
 
 AFightingVRPickup::AFightingVRPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -25,6 +26,9 @@ AFightingVRPickup::AFightingVRPickup(const FObjectInitializer& ObjectInitializer
 
 	SetRemoteRoleForBackwardsCompat(ROLE_SimulatedProxy);
 	bReplicates = true;
+
+	// state only changes on pickup and respawn, both flush dormancy
+	NetDormancy = DORM_Initial;
 }
 
 void AFightingVRPickup::BeginPlay()
@@ -68,11 +72,12 @@ void AFightingVRPickup::PickupOnTouch(class AFightingVRCharacter* Pawn)
 			if (!IsPendingKill())
 			{
 				bIsActive = false;
+				FlushNetDormancy();
 				OnPickedUp();
 
 				if (RespawnTime > 0.0f)
 				{
-					GetWorldTimerManager().SetTimer(TimerHandle_RespawnPickup, this, &AFightingVRPickup::RespawnPickup, RespawnTime, false);
+					GetWorld()->GetSubsystem<UFightingVRPickupRespawnScheduler>()->ScheduleRespawn(this, RespawnTime);
 				}
 			}
 		}
@@ -83,6 +88,7 @@ void AFightingVRPickup::RespawnPickup()
 {
 	bIsActive = true;
 	PickedUpBy = NULL;
+	FlushNetDormancy();
 	OnRespawned();
 
 	TSet<AActor*> OverlappingPawns;
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Pickups/FightingVRPickupRespawnScheduler.h"
+#include "FightingVR.h"
+#include "Pickups/FightingVRPickup.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Pickup Respawns"), STAT_FightingVR_PendingPickupRespawns, STATGROUP_FightingVR);
+
+void UFightingVRPickupRespawnScheduler::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_RespawnDuePickups);
+	}
+
+	PendingRespawns.Reset();
+	SET_DWORD_STAT(STAT_FightingVR_PendingPickupRespawns, 0);
+
+	Super::Deinitialize();
+}
+
+void UFightingVRPickupRespawnScheduler::ScheduleRespawn(AFightingVRPickup* Pickup, float Delay)
+{
+	UWorld* World = GetWorld();
+	if (Pickup == nullptr || World == nullptr)
+	{
+		return;
+	}
+
+	FPendingRespawn Respawn;
+	Respawn.Pickup = Pickup;
+	Respawn.RespawnTime = World->GetTimeSeconds() + Delay;
+	PendingRespawns.HeapPush(Respawn);
+
+	// the timer only has to move if this is now the earliest respawn
+	if (PendingRespawns.HeapTop().Pickup == Pickup)
+	{
+		UpdateTimer();
+	}
+
+	SET_DWORD_STAT(STAT_FightingVR_PendingPickupRespawns, PendingRespawns.Num());
+}
+
+void UFightingVRPickupRespawnScheduler::RespawnDuePickups()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	while (PendingRespawns.Num() > 0 && PendingRespawns.HeapTop().RespawnTime <= Now)
+	{
+		FPendingRespawn Respawn;
+		PendingRespawns.HeapPop(Respawn, false);
+
+		// respawning can pick the pickup up again right away, which pushes a new entry that is never due yet
+		if (AFightingVRPickup* Pickup = Respawn.Pickup.Get())
+		{
+			Pickup->RespawnPickup();
+		}
+	}
+
+	UpdateTimer();
+	SET_DWORD_STAT(STAT_FightingVR_PendingPickupRespawns, PendingRespawns.Num());
+}
+
+void UFightingVRPickupRespawnScheduler::UpdateTimer()
+{
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+
+	if (PendingRespawns.Num() > 0)
+	{
+		const float Delay = PendingRespawns.HeapTop().RespawnTime - GetWorld()->GetTimeSeconds();
+		TimerManager.SetTimer(TimerHandle_RespawnDuePickups, this, &UFightingVRPickupRespawnScheduler::RespawnDuePickups, FMath::Max(Delay, SMALL_NUMBER), false);
+	}
+	else
+	{
+		TimerManager.ClearTimer(TimerHandle_RespawnDuePickups);
+	}
+}
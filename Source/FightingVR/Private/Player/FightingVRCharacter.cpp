@@ -6,6 +6,8 @@
 #include "Weapons/FightingVRDamageType.h"
 #include "UI/FightingVRHUD.h"
 #include "Online/FightingVRPlayerState.h"
+#include "Player/FightingVRCorpseManager.h"
+#include "Player/FightingVRTeamMaterialCache.h"
 #include "Animation/AnimMontage.h"
 #include "Animation/AnimInstance.h"
 #include "Sound/SoundNodeLocalPlayer.h"
@@ -28,6 +30,18 @@ FAutoConsoleVariableRef CVarNetEnablePauseRelevancy(
 	TEXT("0: Disable, 1: Enable"),
 	ECVF_Cheat);
 
+int32 CVar_FightingVR_ServerAnimBudget = 1;
+static FAutoConsoleVariableRef CVarFightingVRServerAnimBudget(TEXT("FightingVR.ServerAnimBudget"), CVar_FightingVR_ServerAnimBudget, TEXT("If > 0, dedicated servers only refresh bones of pawns that were shot at or are close to a shot"), ECVF_Default);
+
+float CVar_FightingVR_ServerAnimBudget_RelevantTime = 1.0f;
+static FAutoConsoleVariableRef CVarFightingVRServerAnimBudgetRelevantTime(TEXT("FightingVR.ServerAnimBudget.RelevantTime"), CVar_FightingVR_ServerAnimBudget_RelevantTime, TEXT("Seconds a pawn keeps refreshing bones after being shot at"), ECVF_Default);
+
+float CVar_FightingVR_ServerAnimBudget_FiringLineRadius = 300.0f;
+static FAutoConsoleVariableRef CVarFightingVRServerAnimBudgetFiringLineRadius(TEXT("FightingVR.ServerAnimBudget.FiringLineRadius"), CVar_FightingVR_ServerAnimBudget_FiringLineRadius, TEXT("Pawns closer than this to a shot refresh their bones before it is traced"), ECVF_Default);
+
+float CVar_FightingVR_ServerAnimBudget_IdleTickInterval = 0.1f;
+static FAutoConsoleVariableRef CVarFightingVRServerAnimBudgetIdleTickInterval(TEXT("FightingVR.ServerAnimBudget.IdleTickInterval"), CVar_FightingVR_ServerAnimBudget_IdleTickInterval, TEXT("Mesh tick interval of pawns nobody is shooting at"), ECVF_Default);
+
 FOnFightingVRCharacterEquipWeapon AFightingVRCharacter::NotifyEquipWeapon;
 FOnFightingVRCharacterUnEquipWeapon AFightingVRCharacter::NotifyUnEquipWeapon;
 
@@ -65,6 +79,8 @@ AFightingVRCharacter::AFightingVRCharacter(const FObjectInitializer& ObjectIniti
 	bWantsToRun = false;
 	bWantsToFire = false;
 	LowHealthPercentage = 0.5f;
+	bPoseRelevant = true;
+	PoseRelevantUntilTime = 0.0f;
 
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
@@ -82,14 +98,25 @@ void AFightingVRCharacter::PostInitializeComponents()
 		GetWorldTimerManager().SetTimerForNextTick(this, &AFightingVRCharacter::SpawnDefaultInventory);
 	}
 
+	// 1st person mesh placement in OnCameraUpdate is relative to the class default, look it up once
+	const AFightingVRCharacter* DefaultCharacter = GetClass()->GetDefaultObject<AFightingVRCharacter>();
+	DefaultMesh1PTransform = FTransform(DefaultCharacter->Mesh1P->GetRelativeRotation(), DefaultCharacter->Mesh1P->GetRelativeLocation());
+
 	// set initial mesh visibility (3rd person view)
 	UpdatePawnMeshes();
 
-	// create material instance for setting team colors (3rd person view)
+	// nobody is shooting at a freshly spawned pawn
+	if (GetNetMode() == NM_DedicatedServer && CVar_FightingVR_ServerAnimBudget > 0)
+	{
+		SetPoseRelevant(false);
+	}
+
+	// remember authored materials, team colored instances are shared through the world's team material cache
 	for (int32 iMat = 0; iMat < GetMesh()->GetNumMaterials(); iMat++)
 	{
-		MeshMIDs.Add(GetMesh()->CreateAndSetMaterialInstanceDynamic(iMat));
+		MeshBaseMaterials.Add(GetMesh()->GetMaterial(iMat));
 	}
+	Mesh1PBaseMaterials.Add(Mesh1P->GetMaterial(0));
 
 	// play respawn effects
 	if (GetNetMode() != NM_DedicatedServer)
@@ -123,8 +150,7 @@ void AFightingVRCharacter::PawnClientRestart()
 	SetCurrentWeapon(CurrentWeapon);
 
 	// set team colors for 1st person view
-	UMaterialInstanceDynamic* Mesh1PMID = Mesh1P->CreateAndSetMaterialInstanceDynamic(0);
-	UpdateTeamColors(Mesh1PMID);
+	UpdateTeamColors(Mesh1P, Mesh1PBaseMaterials);
 }
 
 void AFightingVRCharacter::PossessedBy(class AController* InController)
@@ -192,36 +218,105 @@ void AFightingVRCharacter::UpdatePawnMeshes()
 	GetMesh()->SetOwnerNoSee(bFirstPerson);
 }
 
-void AFightingVRCharacter::UpdateTeamColors(UMaterialInstanceDynamic* UseMID)
+void AFightingVRCharacter::UpdateTeamColors(USkeletalMeshComponent* UseMesh, const TArray<UMaterialInterface*>& BaseMaterials)
 {
-	if (UseMID)
+	if (UseMesh && GetNetMode() != NM_DedicatedServer)
 	{
 		AFightingVRPlayerState* MyPlayerState = Cast<AFightingVRPlayerState>(GetPlayerState());
-		if (MyPlayerState != NULL)
+		UFightingVRTeamMaterialCache* TeamMaterialCache = GetWorld()->GetSubsystem<UFightingVRTeamMaterialCache>();
+		if (MyPlayerState != NULL && TeamMaterialCache != NULL)
 		{
-			float MaterialParam = (float)MyPlayerState->GetTeamNum();
-			UseMID->SetScalarParameterValue(TEXT("Team Color Index"), MaterialParam);
+			const int32 TeamNum = MyPlayerState->GetTeamNum();
+			for (int32 iMat = 0; iMat < BaseMaterials.Num(); iMat++)
+			{
+				UMaterialInterface* TeamMaterial = TeamMaterialCache->GetTeamMaterial(BaseMaterials[iMat], TeamNum);
+				if (TeamMaterial && UseMesh->GetMaterial(iMat) != TeamMaterial)
+				{
+					UseMesh->SetMaterial(iMat, TeamMaterial);
+				}
+			}
 		}
 	}
 }
 
-void AFightingVRCharacter::OnCameraUpdate(const FVector& CameraLocation, const FRotator& CameraRotation)
+void AFightingVRCharacter::SetPoseRelevant(bool bRelevant)
+{
+	if (bPoseRelevant == bRelevant)
+	{
+		return;
+	}
+
+	bPoseRelevant = bRelevant;
+
+	// nothing is rendered on a dedicated server: AlwaysTickPose keeps montages and notifies going but never refreshes bones
+	GetMesh()->VisibilityBasedAnimTickOption = bRelevant ? EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones : EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	GetMesh()->SetComponentTickInterval(bRelevant ? 0.0f : CVar_FightingVR_ServerAnimBudget_IdleTickInterval);
+
+	if (bRelevant)
+	{
+		// bring the stale pose (and the physics bodies hit traces use) up to date right now
+		GetMesh()->RefreshBoneTransforms();
+	}
+}
+
+void AFightingVRCharacter::MarkPoseRelevant()
+{
+	if (GetNetMode() != NM_DedicatedServer || bIsDying)
+	{
+		return;
+	}
+
+	PoseRelevantUntilTime = GetWorld()->GetTimeSeconds() + CVar_FightingVR_ServerAnimBudget_RelevantTime;
+	SetPoseRelevant(true);
+}
+
+void AFightingVRCharacter::MarkPosesNearLine(UWorld* World, const FVector& Start, const FVector& End)
 {
-	USkeletalMeshComponent* DefMesh1P = Cast<USkeletalMeshComponent>(GetClass()->GetDefaultSubobjectByName(TEXT("PawnMesh1P")));
-	const FMatrix DefMeshLS = FRotationTranslationMatrix(DefMesh1P->GetRelativeRotation(), DefMesh1P->GetRelativeLocation());
-	const FMatrix LocalToWorld = ActorToWorld().ToMatrixWithScale();
+	if (World == nullptr || World->GetNetMode() != NM_DedicatedServer || CVar_FightingVR_ServerAnimBudget <= 0)
+	{
+		return;
+	}
+
+	AGameStateBase* const GameState = World->GetGameState();
+	if (GameState == nullptr)
+	{
+		return;
+	}
 
-	// Mesh rotating code expect uniform scale in LocalToWorld matrix
+	// called for every shot, so only look at player pawns and reject those outside the line's bounds first
+	const float Radius = CVar_FightingVR_ServerAnimBudget_FiringLineRadius;
+	const float RadiusSq = FMath::Square(Radius);
+	const FBox LineBounds = FBox(Start.ComponentMin(End), Start.ComponentMax(End)).ExpandBy(Radius);
+
+	for (APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		AFightingVRCharacter* Pawn = PlayerState ? PlayerState->GetPawn<AFightingVRCharacter>() : nullptr;
+		if (Pawn == nullptr)
+		{
+			continue;
+		}
+
+		const FVector PawnLocation = Pawn->GetActorLocation();
+		if (LineBounds.IsInside(PawnLocation) && FMath::PointDistToSegmentSquared(PawnLocation, Start, End) < RadiusSq)
+		{
+			Pawn->MarkPoseRelevant();
+		}
+	}
+}
+
+void AFightingVRCharacter::OnCameraUpdate(const FVector& CameraLocation, const FRotator& CameraRotation)
+{
+	// Mesh rotating code expect uniform scale in ActorToWorld transform
 
 	const FRotator RotCameraPitch(CameraRotation.Pitch, 0.0f, 0.0f);
 	const FRotator RotCameraYaw(0.0f, CameraRotation.Yaw, 0.0f);
 
-	const FMatrix LeveledCameraLS = FRotationTranslationMatrix(RotCameraYaw, CameraLocation) * LocalToWorld.Inverse();
-	const FMatrix PitchedCameraLS = FRotationMatrix(RotCameraPitch) * LeveledCameraLS;
-	const FMatrix MeshRelativeToCamera = DefMeshLS * LeveledCameraLS.Inverse();
-	const FMatrix PitchedMesh = MeshRelativeToCamera * PitchedCameraLS;
+	const FTransform LeveledCameraLS = FTransform(RotCameraYaw, CameraLocation).GetRelativeTransform(ActorToWorld());
+	const FTransform PitchedCameraLS = FTransform(RotCameraPitch) * LeveledCameraLS;
+	const FTransform MeshRelativeToCamera = DefaultMesh1PTransform.GetRelativeTransform(LeveledCameraLS);
+	const FTransform PitchedMesh = MeshRelativeToCamera * PitchedCameraLS;
 
-	Mesh1P->SetRelativeLocationAndRotation(PitchedMesh.GetOrigin(), PitchedMesh.Rotator());
+	Mesh1P->SetRelativeLocationAndRotation(PitchedMesh.GetLocation(), PitchedMesh.Rotator());
 }
 
 
@@ -272,6 +367,9 @@ float AFightingVRCharacter::TakeDamage(float Damage, struct FDamageEvent const&
 	AFightingVRMode* const Game = GetWorld()->GetAuthGameMode<AFightingVRMode>();
 	Damage = Game ? Game->ModifyDamage(Damage, this, DamageEvent, EventInstigator, DamageCauser) : 0.f;
 
+	// the next shots are likely to hit this pawn too
+	MarkPoseRelevant();
+
 	const float ActualDamage = Super::TakeDamage(Damage, DamageEvent, EventInstigator, DamageCauser);
 	if (ActualDamage > 0.f)
 	{
@@ -369,6 +467,13 @@ void AFightingVRCharacter::OnDeath(float KillingDamage, struct FDamageEvent cons
 	// remove all weapons
 	DestroyInventory();
 
+	// weapons are parked rather than destroyed on the server, so drop the weapon mesh locally
+	// (OnRep_MyPawn does the same when the weapon's owner replicates, only the first one gets here)
+	if (GetLocalRole() < ROLE_Authority && CurrentWeapon && CurrentWeapon->IsAttachedToPawn())
+	{
+		CurrentWeapon->OnLeaveInventory();
+	}
+
 	// switch back to 3rd person view
 	UpdatePawnMeshes();
 
@@ -471,6 +576,11 @@ void AFightingVRCharacter::SetRagdollPhysics()
 	{
 		bInRagdoll = false;
 	}
+	else if (GetNetMode() == NM_DedicatedServer)
+	{
+		// nobody sees the corpse on a dedicated server, clients run their own ragdoll after TearOff
+		bInRagdoll = false;
+	}
 	else if (!GetMesh() || !GetMesh()->GetPhysicsAsset())
 	{
 		bInRagdoll = false;
@@ -499,6 +609,12 @@ void AFightingVRCharacter::SetRagdollPhysics()
 	else
 	{
 		SetLifeSpan(10.0f);
+
+		// corpse budget may freeze or remove this one (or older ones) before the lifespan runs out
+		if (UFightingVRCorpseManager* CorpseManager = GetWorld()->GetSubsystem<UFightingVRCorpseManager>())
+		{
+			CorpseManager->AddCorpse(this);
+		}
 	}
 }
 
@@ -565,14 +681,25 @@ void AFightingVRCharacter::SpawnDefaultInventory()
 		return;
 	}
 
+	// reuse weapons parked by pawns that died earlier
+	AFightingVRMode* GameMode = GetWorld()->GetAuthGameMode<AFightingVRMode>();
+
 	int32 NumWeaponClasses = DefaultInventoryClasses.Num();
 	for (int32 i = 0; i < NumWeaponClasses; i++)
 	{
 		if (DefaultInventoryClasses[i])
 		{
-			FActorSpawnParameters SpawnInfo;
-			SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-			AFightingVRWeapon* NewWeapon = GetWorld()->SpawnActor<AFightingVRWeapon>(DefaultInventoryClasses[i], SpawnInfo);
+			AFightingVRWeapon* NewWeapon = NULL;
+			if (GameMode)
+			{
+				NewWeapon = GameMode->AcquireWeapon(DefaultInventoryClasses[i]);
+			}
+			else
+			{
+				FActorSpawnParameters SpawnInfo;
+				SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				NewWeapon = GetWorld()->SpawnActor<AFightingVRWeapon>(DefaultInventoryClasses[i], SpawnInfo);
+			}
 			AddWeapon(NewWeapon);
 		}
 	}
@@ -591,14 +718,23 @@ void AFightingVRCharacter::DestroyInventory()
 		return;
 	}
 
-	// remove all weapons from inventory and destroy them
+	// remove all weapons from inventory and park them for the next respawn, or destroy them if there is no pool
+	AFightingVRMode* GameMode = GetWorld()->GetAuthGameMode<AFightingVRMode>();
+
 	for (int32 i = Inventory.Num() - 1; i >= 0; i--)
 	{
 		AFightingVRWeapon* Weapon = Inventory[i];
 		if (Weapon)
 		{
 			RemoveWeapon(Weapon);
-			Weapon->Destroy();
+			if (GameMode && !GameMode->IsPendingKill())
+			{
+				GameMode->ReleaseWeapon(Weapon);
+			}
+			else
+			{
+				Weapon->Destroy();
+			}
 		}
 	}
 }
@@ -1076,6 +1212,19 @@ void AFightingVRCharacter::Tick(float DeltaSeconds)
 	{
 		SetRunning(false, false);
 	}
+
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		if (CVar_FightingVR_ServerAnimBudget <= 0)
+		{
+			// the budget was switched off at runtime, pawns idled before that go back to full bone updates
+			SetPoseRelevant(true);
+		}
+		else if (bPoseRelevant && !bIsDying && GetWorld()->GetTimeSeconds() > PoseRelevantUntilTime)
+		{
+			SetPoseRelevant(false);
+		}
+	}
 	AFightingVRPlayerController* MyPC = Cast<AFightingVRPlayerController>(Controller);
 	if (MyPC && MyPC->HasHealthRegen())
 	{
@@ -1303,10 +1452,7 @@ float AFightingVRCharacter::GetLowHealthPercentage() const
 
 void AFightingVRCharacter::UpdateTeamColorsAllMIDs()
 {
-	for (int32 i = 0; i < MeshMIDs.Num(); ++i)
-	{
-		UpdateTeamColors(MeshMIDs[i]);
-	}
+	UpdateTeamColors(GetMesh(), MeshBaseMaterials);
 }
 
 void AFightingVRCharacter::BuildPauseReplicationCheckPoints(TArray<FVector>& RelevancyCheckPoints)
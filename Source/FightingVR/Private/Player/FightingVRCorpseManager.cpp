@@ -0,0 +1,240 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Player/FightingVRCorpseManager.h"
+#include "FightingVR.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Ragdolls"), STAT_FightingVR_ActiveRagdolls, STATGROUP_FightingVR);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Corpses"), STAT_FightingVR_Corpses, STATGROUP_FightingVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Evicted Corpses"), STAT_FightingVR_EvictedCorpses, STATGROUP_FightingVR);
+
+int32 CVar_FightingVR_Corpses_MaxActiveRagdolls = 6;
+static FAutoConsoleVariableRef CVarFightingVRCorpsesMaxActiveRagdolls(TEXT("FightingVR.Corpses.MaxActiveRagdolls"), CVar_FightingVR_Corpses_MaxActiveRagdolls, TEXT("Max number of corpses simulating physics at once, older ones are frozen"), ECVF_Default);
+
+int32 CVar_FightingVR_Corpses_MaxCorpses = 16;
+static FAutoConsoleVariableRef CVarFightingVRCorpsesMaxCorpses(TEXT("FightingVR.Corpses.MaxCorpses"), CVar_FightingVR_Corpses_MaxCorpses, TEXT("Max number of corpses in the world, the oldest/farthest ones are removed"), ECVF_Default);
+
+float CVar_FightingVR_Corpses_SettleTime = 3.0f;
+static FAutoConsoleVariableRef CVarFightingVRCorpsesSettleTime(TEXT("FightingVR.Corpses.SettleTime"), CVar_FightingVR_Corpses_SettleTime, TEXT("Seconds after which a ragdoll is frozen even if it did not fall asleep"), ECVF_Default);
+
+float CVar_FightingVR_Corpses_EvictDistance = 5000.0f;
+static FAutoConsoleVariableRef CVarFightingVRCorpsesEvictDistance(TEXT("FightingVR.Corpses.EvictDistance"), CVar_FightingVR_Corpses_EvictDistance, TEXT("Frozen corpses farther than this from every local viewer and not rendered are removed"), ECVF_Default);
+
+/** how often corpses are checked for settling and eviction */
+static const float CorpseUpdateInterval = 0.25f;
+
+/** corpses removed before their lifespan runs out are hidden this long before being destroyed */
+static const float EvictedCorpseLifeSpan = 0.1f;
+
+static void GetLocalViewLocations(UWorld* World, TArray<FVector, TInlineAllocator<4>>& OutLocations)
+{
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			OutLocations.Add(ViewLocation);
+		}
+	}
+}
+
+static float GetDistanceToClosestViewer(const AActor* Actor, const TArray<FVector, TInlineAllocator<4>>& ViewLocations)
+{
+	float ClosestDistSq = MAX_FLT;
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(ViewLocation, Actor->GetActorLocation()));
+	}
+
+	return ViewLocations.Num() > 0 ? FMath::Sqrt(ClosestDistSq) : 0.0f;
+}
+
+void UFightingVRCorpseManager::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_UpdateCorpses);
+	}
+
+	Corpses.Reset();
+
+	Super::Deinitialize();
+}
+
+void UFightingVRCorpseManager::AddCorpse(AFightingVRCharacter* Corpse)
+{
+	UWorld* World = GetWorld();
+	if (Corpse == nullptr || World == nullptr)
+	{
+		return;
+	}
+
+	FCorpseInfo& Info = Corpses.AddDefaulted_GetRef();
+	Info.Pawn = Corpse;
+	Info.StartTime = World->GetTimeSeconds();
+	Info.bFrozen = false;
+
+	// many pawns can die in the same frame, enforce the budget right away instead of waiting for the next update
+	EnforceCorpseBudget(CVar_FightingVR_Corpses_MaxCorpses);
+	EnforceActiveBudget(CVar_FightingVR_Corpses_MaxActiveRagdolls);
+
+	if (!World->GetTimerManager().IsTimerActive(TimerHandle_UpdateCorpses))
+	{
+		World->GetTimerManager().SetTimer(TimerHandle_UpdateCorpses, this, &UFightingVRCorpseManager::UpdateCorpses, CorpseUpdateInterval, true);
+	}
+
+	SET_DWORD_STAT(STAT_FightingVR_Corpses, Corpses.Num());
+	SET_DWORD_STAT(STAT_FightingVR_ActiveRagdolls, GetNumActiveRagdolls());
+}
+
+int32 UFightingVRCorpseManager::GetNumActiveRagdolls() const
+{
+	int32 NumActive = 0;
+	for (const FCorpseInfo& Info : Corpses)
+	{
+		NumActive += (Info.bFrozen || !Info.Pawn.IsValid()) ? 0 : 1;
+	}
+
+	return NumActive;
+}
+
+void UFightingVRCorpseManager::UpdateCorpses()
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	// corpses destroyed by their lifespan
+	Corpses.RemoveAll([](const FCorpseInfo& Info) { return !Info.Pawn.IsValid() || Info.Pawn->IsPendingKillPending(); });
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	GetLocalViewLocations(World, ViewLocations);
+
+	const float TimeSeconds = World->GetTimeSeconds();
+	for (int32 i = Corpses.Num() - 1; i >= 0; i--)
+	{
+		FCorpseInfo& Info = Corpses[i];
+		AFightingVRCharacter* Pawn = Info.Pawn.Get();
+
+		if (!Info.bFrozen)
+		{
+			const bool bSettled = !Pawn->GetMesh()->IsAnyRigidBodyAwake() || TimeSeconds - Info.StartTime > CVar_FightingVR_Corpses_SettleTime;
+			if (bSettled)
+			{
+				FreezeCorpse(Info);
+			}
+		}
+		else if (ViewLocations.Num() > 0 && !Pawn->WasRecentlyRendered() && GetDistanceToClosestViewer(Pawn, ViewLocations) > CVar_FightingVR_Corpses_EvictDistance)
+		{
+			Pawn->SetActorHiddenInGame(true);
+			Pawn->SetLifeSpan(EvictedCorpseLifeSpan);
+			Corpses.RemoveAt(i);
+			INC_DWORD_STAT(STAT_FightingVR_EvictedCorpses);
+		}
+	}
+
+	if (Corpses.Num() == 0)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_UpdateCorpses);
+	}
+
+	SET_DWORD_STAT(STAT_FightingVR_Corpses, Corpses.Num());
+	SET_DWORD_STAT(STAT_FightingVR_ActiveRagdolls, GetNumActiveRagdolls());
+}
+
+void UFightingVRCorpseManager::EnforceActiveBudget(int32 MaxActive)
+{
+	int32 NumActive = GetNumActiveRagdolls();
+	while (NumActive > FMath::Max(MaxActive, 0))
+	{
+		const int32 CorpseIdx = FindCorpseToEvict(true);
+		if (CorpseIdx == INDEX_NONE)
+		{
+			break;
+		}
+
+		FreezeCorpse(Corpses[CorpseIdx]);
+		NumActive--;
+	}
+}
+
+void UFightingVRCorpseManager::EnforceCorpseBudget(int32 MaxCorpses)
+{
+	while (Corpses.Num() > FMath::Max(MaxCorpses, 0))
+	{
+		const int32 CorpseIdx = FindCorpseToEvict(false);
+		if (CorpseIdx == INDEX_NONE)
+		{
+			break;
+		}
+
+		if (AFightingVRCharacter* Pawn = Corpses[CorpseIdx].Pawn.Get())
+		{
+			Pawn->SetActorHiddenInGame(true);
+			Pawn->SetLifeSpan(EvictedCorpseLifeSpan);
+		}
+
+		Corpses.RemoveAt(CorpseIdx);
+		INC_DWORD_STAT(STAT_FightingVR_EvictedCorpses);
+	}
+}
+
+int32 UFightingVRCorpseManager::FindCorpseToEvict(bool bOnlyActive) const
+{
+	UWorld* World = GetWorld();
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	GetLocalViewLocations(World, ViewLocations);
+
+	const float TimeSeconds = World->GetTimeSeconds();
+	const float MaxAge = FMath::Max(CVar_FightingVR_Corpses_SettleTime, KINDA_SMALL_NUMBER);
+	const float MaxDistance = FMath::Max(CVar_FightingVR_Corpses_EvictDistance, KINDA_SMALL_NUMBER);
+
+	int32 BestIdx = INDEX_NONE;
+	float BestScore = -MAX_FLT;
+	for (int32 i = 0; i < Corpses.Num(); i++)
+	{
+		const FCorpseInfo& Info = Corpses[i];
+		const AFightingVRCharacter* Pawn = Info.Pawn.Get();
+		if (Pawn == nullptr)
+		{
+			// already gone, cheapest of all
+			return i;
+		}
+
+		if (bOnlyActive && Info.bFrozen)
+		{
+			continue;
+		}
+
+		// age and distance weigh the same once they reach their limits, corpses never rendered come first
+		const float Score = (TimeSeconds - Info.StartTime) / MaxAge + GetDistanceToClosestViewer(Pawn, ViewLocations) / MaxDistance + (Pawn->WasRecentlyRendered() ? 0.0f : 1.0f);
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestIdx = i;
+		}
+	}
+
+	return BestIdx;
+}
+
+void UFightingVRCorpseManager::FreezeCorpse(FCorpseInfo& Info) const
+{
+	Info.bFrozen = true;
+
+	AFightingVRCharacter* Pawn = Info.Pawn.Get();
+	USkeletalMeshComponent* Mesh = Pawn ? Pawn->GetMesh() : nullptr;
+	if (Mesh)
+	{
+		// keep the last simulated pose: stop the bodies, then stop refreshing bones from animation
+		Mesh->PutAllRigidBodiesToSleep();
+		Mesh->SetAllBodiesSimulatePhysics(false);
+		Mesh->bNoSkeletonUpdate = true;
+		Mesh->SetComponentTickEnabled(false);
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "Player/FightingVRLocalPlayer.h"
 #include "FightingVR.h"
+#include "Player/FightingVRResultsWriter.h"
 #include "OnlineSubsystemUtilsClasses.h"
 #include "FightingVRInstance.h"
 #include "OnlineSubsystemUtils.h"
@@ -23,6 +24,15 @@ UFightingVRPersistentUser* UFightingVRLocalPlayer::GetPersistentUser() const
 	return PersistentUser;
 }
 
+UFightingVRResultsWriter* UFightingVRLocalPlayer::GetResultsWriter()
+{
+	if (ResultsWriter == nullptr)
+	{
+		ResultsWriter = NewObject<UFightingVRResultsWriter>(this);
+	}
+	return ResultsWriter;
+}
+
 void UFightingVRLocalPlayer::LoadPersistentUser()
 {
 	FString SaveGameName = GetNickname();
@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Player/FightingVRLocalPlayerRegistry.h"
+#include "FightingVR.h"
+#include "Player/FightingVRPlayerController.h"
+
+void UFightingVRLocalPlayerRegistry::RegisterController(AFightingVRPlayerController* Controller)
+{
+	if (Controller)
+	{
+		LocalControllers.Remove(nullptr);
+		LocalControllers.AddUnique(Controller);
+	}
+}
+
+void UFightingVRLocalPlayerRegistry::UnregisterController(AFightingVRPlayerController* Controller)
+{
+	LocalControllers.Remove(Controller);
+	LocalControllers.Remove(nullptr);
+}
+
+AFightingVRPlayerController* UFightingVRLocalPlayerRegistry::FindByPlayerState(const APlayerState* PlayerState) const
+{
+	if (PlayerState == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (AFightingVRPlayerController* Controller : LocalControllers)
+	{
+		if (Controller && Controller->PlayerState == PlayerState)
+		{
+			return Controller;
+		}
+	}
+
+	// after a seamless travel or a reconnect the entry can name a copied or reactivated player state of the same player
+	const FUniqueNetIdRepl& UniqueId = PlayerState->GetUniqueId();
+	if (UniqueId.IsValid())
+	{
+		for (AFightingVRPlayerController* Controller : LocalControllers)
+		{
+			if (Controller && Controller->PlayerState && Controller->PlayerState->GetUniqueId() == UniqueId)
+			{
+				return Controller;
+			}
+		}
+	}
+
+	return nullptr;
+}
@@ -4,6 +4,9 @@
 #include "FightingVR.h"
 #include "FightingVRLocalPlayer.h"
 
+int32 CVar_FightingVR_RecentlyMet_MaxPlayers = 20;
+static FAutoConsoleVariableRef CVarFightingVRRecentlyMetMaxPlayers(TEXT("FightingVR.RecentlyMet.MaxPlayers"), CVar_FightingVR_RecentlyMet_MaxPlayers, TEXT("Recently met players remembered per user, the least recently met is dropped first"), ECVF_Default);
+
 UFightingVRPersistentUser::UFightingVRPersistentUser(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -249,3 +252,48 @@ void UFightingVRPersistentUser::SetIsRecordingDemos(const bool InbIsRecordingDem
 
 	bIsRecordingDemos = InbIsRecordingDemos;
 }
+
+void UFightingVRPersistentUser::AddRecentlyMetPlayer(const FString& UniqueId, const FString& PlayerName)
+{
+	if (UniqueId.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 ExistingIdx = RecentlyMetPlayers.IndexOfByPredicate([&UniqueId](const FFightingVRRecentlyMetPlayer& Player) { return Player.UniqueId == UniqueId; });
+	if (ExistingIdx == 0 && RecentlyMetPlayers[0].PlayerName == PlayerName)
+	{
+		// already the most recent, don't dirty the save for every roster update of the same player
+		return;
+	}
+
+	FFightingVRRecentlyMetPlayer Player;
+	if (ExistingIdx != INDEX_NONE)
+	{
+		Player = MoveTemp(RecentlyMetPlayers[ExistingIdx]);
+		RecentlyMetPlayers.RemoveAt(ExistingIdx, 1, false);
+	}
+
+	Player.UniqueId = UniqueId;
+	Player.PlayerName = PlayerName;
+	Player.LastMetTime = FDateTime::UtcNow();
+	RecentlyMetPlayers.Insert(MoveTemp(Player), 0);
+
+	const int32 MaxPlayers = FMath::Max(CVar_FightingVR_RecentlyMet_MaxPlayers, 1);
+	if (RecentlyMetPlayers.Num() > MaxPlayers)
+	{
+		RecentlyMetPlayers.SetNum(MaxPlayers);
+	}
+
+	bIsDirty = true;
+}
+
+void UFightingVRPersistentUser::RenameRecentlyMetPlayer(const FString& UniqueId, const FString& PlayerName)
+{
+	FFightingVRRecentlyMetPlayer* Player = RecentlyMetPlayers.FindByPredicate([&UniqueId](const FFightingVRRecentlyMetPlayer& MetPlayer) { return MetPlayer.UniqueId == UniqueId; });
+	if (Player && Player->PlayerName != PlayerName)
+	{
+		Player->PlayerName = PlayerName;
+		bIsDirty = true;
+	}
+}
@@ -5,6 +5,8 @@
 #include "Player/FightingVRPlayerCameraManager.h"
 #include "Player/FightingVRCheatManager.h"
 #include "Player/FightingVRLocalPlayer.h"
+#include "Player/FightingVRLocalPlayerRegistry.h"
+#include "Player/FightingVRResultsWriter.h"
 #include "Online/FightingVRPlayerState.h"
 #include "Weapons/FightingVRWeapon.h"
 #include "UI/Menu/FightingVRIngameMenu.h"
@@ -52,6 +54,9 @@ static const int32 GreatScoreCount = 15;
 #define TRACK_STATS_LOCALLY 1
 #endif
 
+/** Chat lines longer than this are truncated, both when sending and on the server */
+static const int32 MaxChatMessageLength = 128;
+
 AFightingVRPlayerController::AFightingVRPlayerController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PlayerCameraManagerClass = AFightingVRPlayerCameraManager::StaticClass();
@@ -61,6 +66,10 @@ AFightingVRPlayerController::AFightingVRPlayerController(const FObjectInitialize
 	LastDeathLocation = FVector::ZeroVector;
 
 	ServerSayString = TEXT("Say");
+	ChatMessagesPerSecond = 1.0f;
+	ChatBurstSize = 4;
+	ChatTokens = ChatBurstSize;
+	LastChatTokenTime = 0.0f;
 	FightingVRFriendUpdateTimer = 0.0f;
 	bHasSentStartEvents = false;
 
@@ -70,6 +79,7 @@ AFightingVRPlayerController::AFightingVRPlayerController(const FObjectInitialize
 	bHasQueriedPlatformStats = false;
 	bHasQueriedPlatformAchievements = false;
 	bHasInitializedInputComponent = false;
+	bPendingMatchResultIsWinner = false;
 }
 
 void AFightingVRPlayerController::SetupInputComponent()
@@ -119,6 +129,11 @@ void AFightingVRPlayerController::TickActor(float DeltaTime, enum ELevelTick Tic
 {
 	Super::TickActor(DeltaTime, TickType, ThisTickFunction);
 
+	if (PendingChatMessages.Num() > 0)
+	{
+		FlushPendingChatMessages();
+	}
+
 	if (IsGameMenuVisible())
 	{
 		if (FightingVRFriendUpdateTimer > 0)
@@ -197,9 +212,42 @@ void AFightingVRPlayerController::SetPlayer( UPlayer* InPlayer )
 
 		FInputModeGameOnly InputMode;
 		SetInputMode(InputMode);
+
+		if (UFightingVRLocalPlayerRegistry* LocalPlayerRegistry = GetWorld()->GetSubsystem<UFightingVRLocalPlayerRegistry>())
+		{
+			LocalPlayerRegistry->RegisterController(this);
+		}
+	}
+}
+
+void AFightingVRPlayerController::NotifyLoadedWorld(FName WorldPackageName, bool bFinalDest)
+{
+	Super::NotifyLoadedWorld(WorldPackageName, bFinalDest);
+
+	// kept controllers move to the new world without going through SetPlayer again
+	UFightingVRLocalPlayerRegistry* LocalPlayerRegistry = GetWorld()->GetSubsystem<UFightingVRLocalPlayerRegistry>();
+	if (LocalPlayerRegistry && IsLocalPlayerController())
+	{
+		LocalPlayerRegistry->RegisterController(this);
 	}
 }
 
+void AFightingVRPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// results not written yet would be lost with this controller, queue them now
+	if (TimerHandle_WriteMatchResults.IsValid())
+	{
+		WriteMatchResults();
+	}
+
+	if (UFightingVRLocalPlayerRegistry* LocalPlayerRegistry = GetWorld()->GetSubsystem<UFightingVRLocalPlayerRegistry>())
+	{
+		LocalPlayerRegistry->UnregisterController(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AFightingVRPlayerController::QueryAchievements()
 {
 	if (bHasQueriedPlatformAchievements)
@@ -510,48 +558,19 @@ void AFightingVRPlayerController::OnDeathMessage(class AFightingVRPlayerState* K
 
 void AFightingVRPlayerController::UpdateAchievementProgress( const FString& Id, float Percent )
 {
-	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
-	if (LocalPlayer)
-	{
-		IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
-		if(OnlineSub)
-		{
-			IOnlineIdentityPtr Identity = OnlineSub->GetIdentityInterface();
-			if (Identity.IsValid())
-			{
-				FUniqueNetIdRepl UserId = LocalPlayer->GetCachedUniqueNetId();
+	QueueAchievementProgress(Id, Percent);
 
-				if (UserId.IsValid())
-				{
-
-					IOnlineAchievementsPtr Achievements = OnlineSub->GetAchievementsInterface();
-					if (Achievements.IsValid() && (!WriteObject.IsValid() || WriteObject->WriteState != EOnlineAsyncTaskState::InProgress))
-					{
-						WriteObject = MakeShareable(new FOnlineAchievementsWrite());
-						WriteObject->SetFloatStat(*Id, Percent);
+	if (UFightingVRLocalPlayer* LocalPlayer = Cast<UFightingVRLocalPlayer>(Player))
+	{
+		LocalPlayer->GetResultsWriter()->WritePendingAchievements();
+	}
+}
 
-						FOnlineAchievementsWriteRef WriteObjectRef = WriteObject.ToSharedRef();
-						Achievements->WriteAchievements(*UserId, WriteObjectRef);
-					}
-					else
-					{
-						UE_LOG(LogOnline, Warning, TEXT("No valid achievement interface or another write is in progress."));
-					}
-				}
-				else
-				{
-					UE_LOG(LogOnline, Warning, TEXT("No valid user id for this controller."));
-				}
-			}
-			else
-			{
-				UE_LOG(LogOnline, Warning, TEXT("No valid identity interface."));
-			}
-		}
-		else
-		{
-			UE_LOG(LogOnline, Warning, TEXT("No default online subsystem."));
-		}
+void AFightingVRPlayerController::QueueAchievementProgress( const FString& Id, float Percent )
+{
+	if (UFightingVRLocalPlayer* LocalPlayer = Cast<UFightingVRLocalPlayer>(Player))
+	{
+		LocalPlayer->GetResultsWriter()->QueueAchievementProgress(Id, Percent);
 	}
 	else
 	{
@@ -836,15 +855,24 @@ void AFightingVRPlayerController::ClientGameEnded_Implementation(class AActor* E
 		FightingVRHUD->SetMatchState(bIsWinner ? EFightingVRMatchState::Won : EFightingVRMatchState::Lost);
 	}
 
-	UpdateSaveFileOnGameEnd(bIsWinner);
-	UpdateAchievementsOnGameEnd();
-	UpdateLeaderboardsOnGameEnd();
-	UpdateStatsOnGameEnd(bIsWinner);
+	// Results touch the save file and several online backends, so write them on the next frame instead of this one
+	bPendingMatchResultIsWinner = bIsWinner;
+	TimerHandle_WriteMatchResults = GetWorldTimerManager().SetTimerForNextTick(this, &AFightingVRPlayerController::WriteMatchResults);
 
 	// Flag that the game has just ended (if it's ended due to host loss we want to wait for ClientReturnToMainMenu_Implementation first, incase we don't want to process)
 	bGameEndedFrame = true;
 }
 
+void AFightingVRPlayerController::WriteMatchResults()
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_WriteMatchResults);
+
+	UpdateSaveFileOnGameEnd(bPendingMatchResultIsWinner);
+	UpdateAchievementsOnGameEnd();
+	UpdateLeaderboardsOnGameEnd();
+	UpdateStatsOnGameEnd(bPendingMatchResultIsWinner);
+}
+
 void AFightingVRPlayerController::ClientSendRoundEndEvent_Implementation(bool bIsWinner, int32 ExpendedTimeInSeconds)
 {
 	const UWorld* World = GetWorld();
@@ -1042,7 +1070,13 @@ void AFightingVRPlayerController::ClientTeamMessage_Implementation( APlayerState
 		{
 			if( SenderPlayerState != PlayerState  )
 			{
-				FightingVRHUD->AddChatLine(FText::FromString(S), false);
+				// The server batches all lines a player said in one frame into a single message
+				TArray<FString> ChatLines;
+				S.ParseIntoArrayLines(ChatLines);
+				for (const FString& ChatLine : ChatLines)
+				{
+					FightingVRHUD->AddChatLine(FText::FromString(ChatLine), false);
+				}
 			}
 		}
 	}
@@ -1050,7 +1084,7 @@ void AFightingVRPlayerController::ClientTeamMessage_Implementation( APlayerState
 
 void AFightingVRPlayerController::Say( const FString& Msg )
 {
-	ServerSay(Msg.Left(128));
+	ServerSay(Msg.Left(MaxChatMessageLength));
 }
 
 bool AFightingVRPlayerController::ServerSay_Validate( const FString& Msg )
@@ -1060,7 +1094,45 @@ bool AFightingVRPlayerController::ServerSay_Validate( const FString& Msg )
 
 void AFightingVRPlayerController::ServerSay_Implementation( const FString& Msg )
 {
-	GetWorld()->GetAuthGameMode<AFightingVRMode>()->Broadcast(this, Msg, ServerSayString);
+	if (!ConsumeChatToken())
+	{
+		UE_LOG(LogFightingVR, Verbose, TEXT("Dropping chat message from %s, sender is over the chat rate limit"), *GetNameSafe(PlayerState));
+		return;
+	}
+
+	// Line breaks are used to separate batched messages
+	FString ChatMessage = Msg.Left(MaxChatMessageLength);
+	ChatMessage.ReplaceCharInline(TEXT('\n'), TEXT(' '));
+	ChatMessage.ReplaceCharInline(TEXT('\r'), TEXT(' '));
+	if (!ChatMessage.IsEmpty())
+	{
+		PendingChatMessages.Add(MoveTemp(ChatMessage));
+	}
+}
+
+bool AFightingVRPlayerController::ConsumeChatToken()
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	ChatTokens = FMath::Min<float>(ChatTokens + (CurrentTime - LastChatTokenTime) * ChatMessagesPerSecond, ChatBurstSize);
+	LastChatTokenTime = CurrentTime;
+
+	if (ChatTokens < 1.0f)
+	{
+		return false;
+	}
+
+	ChatTokens -= 1.0f;
+	return true;
+}
+
+void AFightingVRPlayerController::FlushPendingChatMessages()
+{
+	AFightingVRMode* GameMode = GetWorld()->GetAuthGameMode<AFightingVRMode>();
+	if (GameMode)
+	{
+		GameMode->Broadcast(this, FString::Join(PendingChatMessages, TEXT("\n")), ServerSayString);
+	}
+	PendingChatMessages.Reset();
 }
 
 AFightingVRHUD* AFightingVRPlayerController::GetFightingVRHUD() const
@@ -1129,7 +1201,7 @@ void AFightingVRPlayerController::ShowInGameMenu()
 }
 void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 {
-	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
+	UFightingVRLocalPlayer* LocalPlayer = Cast<UFightingVRLocalPlayer>(Player);
 	if (LocalPlayer)
 	{
 		AFightingVRPlayerState* FightingVRPlayerState = Cast<AFightingVRPlayerState>(PlayerState);
@@ -1163,7 +1235,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{
 					float fSomeKillPct = ((float)TotalKills / (float)SomeKillsCount) * 100.0f;
 					fSomeKillPct = FMath::RoundToFloat(fSomeKillPct);
-					UpdateAchievementProgress(ACH_SOME_KILLS, fSomeKillPct);
+					QueueAchievementProgress(ACH_SOME_KILLS, fSomeKillPct);
 
 					CurrentGameAchievement += FMath::Min(fSomeKillPct, 100.0f);
 					TotalGameAchievement += 100;
@@ -1172,7 +1244,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{
 					float fLotsKillPct = ((float)TotalKills / (float)LotsKillsCount) * 100.0f;
 					fLotsKillPct = FMath::RoundToFloat(fLotsKillPct);
-					UpdateAchievementProgress(ACH_LOTS_KILLS, fLotsKillPct);
+					QueueAchievementProgress(ACH_LOTS_KILLS, fLotsKillPct);
 
 					CurrentGameAchievement += FMath::Min(fLotsKillPct, 100.0f);
 					TotalGameAchievement += 100;
@@ -1182,7 +1254,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				///////////////////////////////////////
 				// Match Achievements
 				{
-					UpdateAchievementProgress(ACH_FINISH_MATCH, 100.0f);
+					QueueAchievementProgress(ACH_FINISH_MATCH, 100.0f);
 
 					CurrentGameAchievement += 100;
 					TotalGameAchievement += 100;
@@ -1191,7 +1263,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{
 					float fLotsRoundsPct = ((float)Matches / (float)LotsMatchesCount) * 100.0f;
 					fLotsRoundsPct = FMath::RoundToFloat(fLotsRoundsPct);
-					UpdateAchievementProgress(ACH_LOTS_MATCHES, fLotsRoundsPct);
+					QueueAchievementProgress(ACH_LOTS_MATCHES, fLotsRoundsPct);
 
 					CurrentGameAchievement += FMath::Min(fLotsRoundsPct, 100.0f);
 					TotalGameAchievement += 100;
@@ -1202,7 +1274,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				// Win Achievements
 				if (Wins >= 1)
 				{
-					UpdateAchievementProgress(ACH_FIRST_WIN, 100.0f);
+					QueueAchievementProgress(ACH_FIRST_WIN, 100.0f);
 
 					CurrentGameAchievement += 100.0f;
 				}
@@ -1211,7 +1283,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{			
 					float fLotsWinPct = ((float)Wins / (float)LotsWinsCount) * 100.0f;
 					fLotsWinPct = FMath::RoundToInt(fLotsWinPct);
-					UpdateAchievementProgress(ACH_LOTS_WIN, fLotsWinPct);
+					QueueAchievementProgress(ACH_LOTS_WIN, fLotsWinPct);
 
 					CurrentGameAchievement += FMath::Min(fLotsWinPct, 100.0f);
 					TotalGameAchievement += 100;
@@ -1220,7 +1292,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{			
 					float fManyWinPct = ((float)Wins / (float)ManyWinsCount) * 100.0f;
 					fManyWinPct = FMath::RoundToInt(fManyWinPct);
-					UpdateAchievementProgress(ACH_MANY_WIN, fManyWinPct);
+					QueueAchievementProgress(ACH_MANY_WIN, fManyWinPct);
 
 					CurrentGameAchievement += FMath::Min(fManyWinPct, 100.0f);
 					TotalGameAchievement += 100;
@@ -1232,7 +1304,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{
 					float fLotsBulletsPct = ((float)TotalBulletsFired / (float)LotsBulletsCount) * 100.0f;
 					fLotsBulletsPct = FMath::RoundToFloat(fLotsBulletsPct);
-					UpdateAchievementProgress(ACH_SHOOT_BULLETS, fLotsBulletsPct);
+					QueueAchievementProgress(ACH_SHOOT_BULLETS, fLotsBulletsPct);
 
 					CurrentGameAchievement += FMath::Min(fLotsBulletsPct, 100.0f);
 					TotalGameAchievement += 100;
@@ -1241,7 +1313,7 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{
 					float fLotsRocketsPct = ((float)TotalRocketsFired / (float)LotsRocketsCount) * 100.0f;
 					fLotsRocketsPct = FMath::RoundToFloat(fLotsRocketsPct);
-					UpdateAchievementProgress(ACH_SHOOT_ROCKETS, fLotsRocketsPct);
+					QueueAchievementProgress(ACH_SHOOT_ROCKETS, fLotsRocketsPct);
 
 					CurrentGameAchievement += FMath::Min(fLotsRocketsPct, 100.0f);
 					TotalGameAchievement += 100;
@@ -1253,13 +1325,13 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 				{
 					float fGoodScorePct = ((float)MatchScore / (float)GoodScoreCount) * 100.0f;
 					fGoodScorePct = FMath::RoundToFloat(fGoodScorePct);
-					UpdateAchievementProgress(ACH_GOOD_SCORE, fGoodScorePct);
+					QueueAchievementProgress(ACH_GOOD_SCORE, fGoodScorePct);
 				}
 
 				{
 					float fGreatScorePct = ((float)MatchScore / (float)GreatScoreCount) * 100.0f;
 					fGreatScorePct = FMath::RoundToFloat(fGreatScorePct);
-					UpdateAchievementProgress(ACH_GREAT_SCORE, fGreatScorePct);
+					QueueAchievementProgress(ACH_GREAT_SCORE, fGreatScorePct);
 				}
 				///////////////////////////////////////
 
@@ -1271,15 +1343,18 @@ void AFightingVRPlayerController::UpdateAchievementsOnGameEnd()
 					FString MapName = *FPackageName::GetShortName(World->PersistentLevel->GetOutermost()->GetName());
 					if (MapName.Find(TEXT("Highrise")) != -1)
 					{
-						UpdateAchievementProgress(ACH_PLAY_HIGHRISE, 100.0f);
+						QueueAchievementProgress(ACH_PLAY_HIGHRISE, 100.0f);
 					}
 					else if (MapName.Find(TEXT("Sanctuary")) != -1)
 					{
-						UpdateAchievementProgress(ACH_PLAY_SANCTUARY, 100.0f);
+						QueueAchievementProgress(ACH_PLAY_SANCTUARY, 100.0f);
 					}
 				}
 				///////////////////////////////////////			
 
+				// All progress above goes to the backend as a single write
+				LocalPlayer->GetResultsWriter()->WritePendingAchievements();
+
 				const IOnlineEventsPtr Events = Online::GetEventsInterface(World);
 				const IOnlineIdentityPtr Identity = Online::GetIdentityInterface(World);
 
@@ -1356,7 +1431,7 @@ void AFightingVRPlayerController::UpdateLeaderboardsOnGameEnd()
 void AFightingVRPlayerController::UpdateStatsOnGameEnd(bool bIsWinner)
 {
 	const IOnlineStatsPtr Stats = Online::GetStatsInterface(GetWorld());
-	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
+	UFightingVRLocalPlayer* LocalPlayer = Cast<UFightingVRLocalPlayer>(Player);
 	AFightingVRPlayerState* FightingVRPlayerState = Cast<AFightingVRPlayerState>(PlayerState);
 
 	if (Stats.IsValid() && LocalPlayer != nullptr && FightingVRPlayerState != nullptr)
@@ -1365,9 +1440,7 @@ void AFightingVRPlayerController::UpdateStatsOnGameEnd(bool bIsWinner)
 
 		if (UniqueId.IsValid() )
 		{
-			TArray<FOnlineStatsUserUpdatedStats> UpdatedUserStats;
-
-			FOnlineStatsUserUpdatedStats& UpdatedStats = UpdatedUserStats.Emplace_GetRef( UniqueId.GetUniqueNetId().ToSharedRef() );
+			FOnlineStatsUserUpdatedStats UpdatedStats( UniqueId.GetUniqueNetId().ToSharedRef() );
 			UpdatedStats.Stats.Add( TEXT("Kills"), FOnlineStatUpdate( FightingVRPlayerState->GetKills(), FOnlineStatUpdate::EOnlineStatModificationType::Sum ) );
 			UpdatedStats.Stats.Add( TEXT("Deaths"), FOnlineStatUpdate( FightingVRPlayerState->GetDeaths(), FOnlineStatUpdate::EOnlineStatModificationType::Sum ) );
 			UpdatedStats.Stats.Add( TEXT("RoundsPlayed"), FOnlineStatUpdate( 1, FOnlineStatUpdate::EOnlineStatModificationType::Sum ) );
@@ -1376,7 +1449,9 @@ void AFightingVRPlayerController::UpdateStatsOnGameEnd(bool bIsWinner)
 				UpdatedStats.Stats.Add( TEXT("RoundsWon"), FOnlineStatUpdate( 1, FOnlineStatUpdate::EOnlineStatModificationType::Sum ) );
 			}
 
-			Stats->UpdateStats( UniqueId.GetUniqueNetId().ToSharedRef(), UpdatedUserStats, FOnlineStatsUpdateStatsComplete() );
+			UFightingVRResultsWriter* ResultsWriter = LocalPlayer->GetResultsWriter();
+			ResultsWriter->QueueStatsUpdate(MoveTemp(UpdatedStats));
+			ResultsWriter->WritePendingStats();
 		}
 	}
 }
@@ -1401,6 +1476,12 @@ void AFightingVRPlayerController::PreClientTravel(const FString& PendingURL, ETr
 {
 	Super::PreClientTravel( PendingURL, TravelType, bIsSeamlessTravel );
 
+	// the match may end and travel in the same frame, don't leave its results to a timer of the old world
+	if (TimerHandle_WriteMatchResults.IsValid())
+	{
+		WriteMatchResults();
+	}
+
 	if (const UWorld* World = GetWorld())
 	{
 		UFightingVRViewportClient* FightingVRViewport = Cast<UFightingVRViewportClient>( World->GetGameViewport() );
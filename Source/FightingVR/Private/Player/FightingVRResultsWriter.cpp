@@ -0,0 +1,259 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Player/FightingVRResultsWriter.h"
+#include "FightingVR.h"
+#include "OnlineAchievementsInterface.h"
+#include "OnlineSubsystemUtils.h"
+
+/** Failed achievement and stats writes are retried this many times before the results are dropped */
+static const int32 MaxResultWriteRetries = 3;
+
+/** Delay before the first retry of a failed write, doubled for every further retry */
+static const float ResultWriteRetryDelay = 2.0f;
+
+/** A write the backend has not answered after this long is treated as failed, so it can't block later writes */
+static const float ResultWriteTimeout = 30.0f;
+
+UFightingVRResultsWriter::UFightingVRResultsWriter()
+	: AchievementWriteRetries(0)
+	, AchievementWriteId(0)
+	, StatsWriteRetries(0)
+	, StatsWriteId(0)
+{
+}
+
+UWorld* UFightingVRResultsWriter::GetWorld() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? nullptr : GetOuterULocalPlayer()->GetWorld();
+}
+
+FTimerManager* UFightingVRResultsWriter::GetTimerManager() const
+{
+	UGameInstance* GameInstance = GetOuterULocalPlayer()->GetGameInstance();
+	return GameInstance ? &GameInstance->GetTimerManager() : nullptr;
+}
+
+void UFightingVRResultsWriter::QueueAchievementProgress(const FString& Id, float Percent)
+{
+	if (float* ExistingPercent = PendingAchievementProgress.Find(Id))
+	{
+		*ExistingPercent = FMath::Max(*ExistingPercent, Percent);
+	}
+	else
+	{
+		PendingAchievementProgress.Add(Id, Percent);
+	}
+}
+
+void UFightingVRResultsWriter::QueueStatsUpdate(FOnlineStatsUserUpdatedStats&& StatsUpdate)
+{
+	PendingStatsUpdates.Add(MoveTemp(StatsUpdate));
+}
+
+void UFightingVRResultsWriter::WritePendingAchievements()
+{
+	// A write in progress picks up anything queued meanwhile when it completes
+	if (PendingAchievementProgress.Num() == 0 || InFlightAchievementProgress.Num() > 0)
+	{
+		return;
+	}
+
+	IOnlineAchievementsPtr Achievements = Online::GetAchievementsInterface(GetWorld());
+	FUniqueNetIdRepl UserId = GetOuterULocalPlayer()->GetCachedUniqueNetId();
+
+	if (!Achievements.IsValid() || !UserId.IsValid())
+	{
+		UE_LOG(LogOnline, Warning, TEXT("No valid achievement interface or user id, dropping %d achievement updates."), PendingAchievementProgress.Num());
+		PendingAchievementProgress.Reset();
+		return;
+	}
+
+	WriteObject = MakeShareable(new FOnlineAchievementsWrite());
+	for (const TPair<FString, float>& Progress : PendingAchievementProgress)
+	{
+		WriteObject->SetFloatStat(*Progress.Key, Progress.Value);
+	}
+
+	InFlightAchievementProgress = MoveTemp(PendingAchievementProgress);
+	PendingAchievementProgress.Reset();
+
+	if (FTimerManager* TimerManager = GetTimerManager())
+	{
+		TimerManager->SetTimer(TimerHandle_AchievementsWriteTimeout, this, &UFightingVRResultsWriter::OnAchievementsWriteTimeout, ResultWriteTimeout, false);
+	}
+
+	FOnlineAchievementsWriteRef WriteObjectRef = WriteObject.ToSharedRef();
+	Achievements->WriteAchievements(*UserId, WriteObjectRef, FOnAchievementsWrittenDelegate::CreateUObject(this, &UFightingVRResultsWriter::OnAchievementsWritten, ++AchievementWriteId));
+}
+
+void UFightingVRResultsWriter::OnAchievementsWriteTimeout()
+{
+	UE_LOG(LogOnline, Warning, TEXT("Achievement write timed out after %.0f seconds."), ResultWriteTimeout);
+
+	FUniqueNetIdRepl UserId = GetOuterULocalPlayer()->GetCachedUniqueNetId();
+	if (UserId.IsValid())
+	{
+		OnAchievementsWritten(*UserId, false, AchievementWriteId);
+	}
+	else
+	{
+		InFlightAchievementProgress.Reset();
+		PendingAchievementProgress.Reset();
+	}
+}
+
+void UFightingVRResultsWriter::OnAchievementsWritten(const FUniqueNetId& PlayerId, bool bWasSuccessful, int32 WriteId)
+{
+	if (WriteId != AchievementWriteId || InFlightAchievementProgress.Num() == 0)
+	{
+		// late answer to a write that already timed out
+		return;
+	}
+
+	FTimerManager* TimerManager = GetTimerManager();
+	if (TimerManager)
+	{
+		TimerManager->ClearTimer(TimerHandle_AchievementsWriteTimeout);
+	}
+
+	if (!bWasSuccessful)
+	{
+		// Queue the failed batch again, keeping any higher progress queued since
+		for (const TPair<FString, float>& Progress : InFlightAchievementProgress)
+		{
+			QueueAchievementProgress(Progress.Key, Progress.Value);
+		}
+		InFlightAchievementProgress.Reset();
+
+		if (AchievementWriteRetries < MaxResultWriteRetries && TimerManager)
+		{
+			const float RetryDelay = ResultWriteRetryDelay * (1 << AchievementWriteRetries);
+			++AchievementWriteRetries;
+
+			UE_LOG(LogOnline, Log, TEXT("Achievement write failed, retrying in %.1f seconds."), RetryDelay);
+			TimerManager->SetTimer(TimerHandle_WritePendingAchievements, this, &UFightingVRResultsWriter::WritePendingAchievements, RetryDelay, false);
+		}
+		else
+		{
+			UE_LOG(LogOnline, Warning, TEXT("Achievement write failed %d times, dropping %d achievement updates."), AchievementWriteRetries + 1, PendingAchievementProgress.Num());
+			AchievementWriteRetries = 0;
+			PendingAchievementProgress.Reset();
+		}
+		return;
+	}
+
+	AchievementWriteRetries = 0;
+	InFlightAchievementProgress.Reset();
+
+	WritePendingAchievements();
+}
+
+void UFightingVRResultsWriter::WritePendingStats()
+{
+	// A write in progress picks up anything queued meanwhile when it completes
+	if (PendingStatsUpdates.Num() == 0 || InFlightStatsUpdates.Num() > 0)
+	{
+		return;
+	}
+
+	const IOnlineStatsPtr Stats = Online::GetStatsInterface(GetWorld());
+	FUniqueNetIdRepl UniqueId = GetOuterULocalPlayer()->GetCachedUniqueNetId();
+
+	if (!Stats.IsValid() || !UniqueId.IsValid())
+	{
+		UE_LOG(LogOnline, Warning, TEXT("No valid stats interface or user id, dropping %d stats updates."), PendingStatsUpdates.Num());
+		PendingStatsUpdates.Reset();
+		return;
+	}
+
+	InFlightStatsUpdates = MoveTemp(PendingStatsUpdates);
+	PendingStatsUpdates.Reset();
+
+	if (FTimerManager* TimerManager = GetTimerManager())
+	{
+		TimerManager->SetTimer(TimerHandle_StatsWriteTimeout, this, &UFightingVRResultsWriter::OnStatsWriteTimeout, ResultWriteTimeout, false);
+	}
+
+	Stats->UpdateStats(UniqueId.GetUniqueNetId().ToSharedRef(), InFlightStatsUpdates, FOnlineStatsUpdateStatsComplete::CreateUObject(this, &UFightingVRResultsWriter::OnStatsWritten, ++StatsWriteId));
+}
+
+void UFightingVRResultsWriter::OnStatsWriteTimeout()
+{
+	UE_LOG(LogOnline, Warning, TEXT("Stats write timed out after %.0f seconds."), ResultWriteTimeout);
+
+	// The write may still have landed on the backend, so sending Sum updates again could count kills and matches twice.
+	// Only the idempotent updates (Set, Largest, Smallest) are retried.
+	int32 NumDroppedStats = 0;
+	for (FOnlineStatsUserUpdatedStats& StatsUpdate : InFlightStatsUpdates)
+	{
+		for (auto It = StatsUpdate.Stats.CreateIterator(); It; ++It)
+		{
+			if (It.Value().GetModificationType() == FOnlineStatUpdate::EOnlineStatModificationType::Sum)
+			{
+				It.RemoveCurrent();
+				++NumDroppedStats;
+			}
+		}
+	}
+	InFlightStatsUpdates.RemoveAll([](const FOnlineStatsUserUpdatedStats& StatsUpdate) { return StatsUpdate.Stats.Num() == 0; });
+
+	if (NumDroppedStats > 0)
+	{
+		UE_LOG(LogOnline, Warning, TEXT("Dropping %d summed stats of the timed out write, they may already have been applied."), NumDroppedStats);
+	}
+
+	if (InFlightStatsUpdates.Num() > 0)
+	{
+		OnStatsWritten(FOnlineError(false), StatsWriteId);
+	}
+	else
+	{
+		// nothing left to retry, a late answer to the timed out write finds no write in flight and is ignored
+		StatsWriteRetries = 0;
+		WritePendingStats();
+	}
+}
+
+void UFightingVRResultsWriter::OnStatsWritten(const FOnlineError& ResultState, int32 WriteId)
+{
+	if (WriteId != StatsWriteId || InFlightStatsUpdates.Num() == 0)
+	{
+		// late answer to a write that already timed out
+		return;
+	}
+
+	FTimerManager* TimerManager = GetTimerManager();
+	if (TimerManager)
+	{
+		TimerManager->ClearTimer(TimerHandle_StatsWriteTimeout);
+	}
+
+	if (!ResultState.WasSuccessful())
+	{
+		// Queue the failed batch again ahead of anything queued since
+		InFlightStatsUpdates.Append(MoveTemp(PendingStatsUpdates));
+		PendingStatsUpdates = MoveTemp(InFlightStatsUpdates);
+		InFlightStatsUpdates.Reset();
+
+		if (StatsWriteRetries < MaxResultWriteRetries && TimerManager)
+		{
+			const float RetryDelay = ResultWriteRetryDelay * (1 << StatsWriteRetries);
+			++StatsWriteRetries;
+
+			UE_LOG(LogOnline, Log, TEXT("Stats write failed (%s), retrying in %.1f seconds."), *ResultState.ToLogString(), RetryDelay);
+			TimerManager->SetTimer(TimerHandle_WritePendingStats, this, &UFightingVRResultsWriter::WritePendingStats, RetryDelay, false);
+		}
+		else
+		{
+			UE_LOG(LogOnline, Warning, TEXT("Stats write failed %d times, dropping %d stats updates."), StatsWriteRetries + 1, PendingStatsUpdates.Num());
+			StatsWriteRetries = 0;
+			PendingStatsUpdates.Reset();
+		}
+		return;
+	}
+
+	StatsWriteRetries = 0;
+	InFlightStatsUpdates.Reset();
+
+	WritePendingStats();
+}
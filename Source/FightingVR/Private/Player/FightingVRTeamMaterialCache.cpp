@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Player/FightingVRTeamMaterialCache.h"
+#include "FightingVR.h"
+
+void UFightingVRTeamMaterialCache::Deinitialize()
+{
+	TeamMaterialMap.Reset();
+	TeamMaterials.Reset();
+
+	Super::Deinitialize();
+}
+
+UMaterialInstanceDynamic* UFightingVRTeamMaterialCache::GetTeamMaterial(UMaterialInterface* BaseMaterial, int32 TeamNum)
+{
+	static const FMaterialParameterInfo TeamColorIndexParam(TEXT("Team Color Index"));
+
+	if (BaseMaterial == nullptr)
+	{
+		return nullptr;
+	}
+
+	const TPair<UMaterialInterface*, int32> Key(BaseMaterial, TeamNum);
+	if (UMaterialInstanceDynamic** TeamMaterial = TeamMaterialMap.Find(Key))
+	{
+		return *TeamMaterial;
+	}
+
+	UMaterialInstanceDynamic* TeamMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+	TeamMaterial->SetScalarParameterValueByInfo(TeamColorIndexParam, (float)TeamNum);
+
+	TeamMaterialMap.Add(Key, TeamMaterial);
+	TeamMaterials.Add(TeamMaterial);
+
+	return TeamMaterial;
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** 1st person mesh placement as OnCameraUpdate used to compute it: default subobject lookup and FMatrix math */
+static FTransform PlaceMesh1PWithMatrices(UClass* CharacterClass, const FTransform& ActorToWorld, const FVector& CameraLocation, const FRotator& CameraRotation)
+{
+	USkeletalMeshComponent* DefMesh1P = Cast<USkeletalMeshComponent>(CharacterClass->GetDefaultSubobjectByName(TEXT("PawnMesh1P")));
+	const FMatrix DefMeshLS = FRotationTranslationMatrix(DefMesh1P->GetRelativeRotation(), DefMesh1P->GetRelativeLocation());
+	const FMatrix LocalToWorld = ActorToWorld.ToMatrixWithScale();
+
+	const FRotator RotCameraPitch(CameraRotation.Pitch, 0.0f, 0.0f);
+	const FRotator RotCameraYaw(0.0f, CameraRotation.Yaw, 0.0f);
+
+	const FMatrix LeveledCameraLS = FRotationTranslationMatrix(RotCameraYaw, CameraLocation) * LocalToWorld.Inverse();
+	const FMatrix PitchedCameraLS = FRotationMatrix(RotCameraPitch) * LeveledCameraLS;
+	const FMatrix MeshRelativeToCamera = DefMeshLS * LeveledCameraLS.Inverse();
+	const FMatrix PitchedMesh = MeshRelativeToCamera * PitchedCameraLS;
+
+	return FTransform(PitchedMesh.Rotator(), PitchedMesh.GetOrigin());
+}
+
+/** 1st person mesh placement as OnCameraUpdate computes it: cached default transform and FTransform math */
+static FTransform PlaceMesh1PWithTransforms(const FTransform& DefaultMesh1PTransform, const FTransform& ActorToWorld, const FVector& CameraLocation, const FRotator& CameraRotation)
+{
+	const FRotator RotCameraPitch(CameraRotation.Pitch, 0.0f, 0.0f);
+	const FRotator RotCameraYaw(0.0f, CameraRotation.Yaw, 0.0f);
+
+	const FTransform LeveledCameraLS = FTransform(RotCameraYaw, CameraLocation).GetRelativeTransform(ActorToWorld);
+	const FTransform PitchedCameraLS = FTransform(RotCameraPitch) * LeveledCameraLS;
+	const FTransform MeshRelativeToCamera = DefaultMesh1PTransform.GetRelativeTransform(LeveledCameraLS);
+	const FTransform PitchedMesh = MeshRelativeToCamera * PitchedCameraLS;
+
+	return FTransform(PitchedMesh.Rotator(), PitchedMesh.GetLocation());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRCameraUpdateTest, "FightingVR.Player.CameraUpdate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRCameraUpdateTest::RunTest(const FString& Parameters)
+{
+	const int32 NumPoses = 1024;
+	const int32 NumIterations = 100;
+
+	UClass* CharacterClass = AFightingVRCharacter::StaticClass();
+	const USkeletalMeshComponent* DefMesh1P = CastChecked<USkeletalMeshComponent>(CharacterClass->GetDefaultSubobjectByName(TEXT("PawnMesh1P")));
+	const FTransform DefaultMesh1PTransform(DefMesh1P->GetRelativeRotation(), DefMesh1P->GetRelativeLocation());
+
+	FRandomStream RandomStream(1234);
+	TArray<FTransform> ActorToWorlds;
+	TArray<FVector> CameraLocations;
+	TArray<FRotator> CameraRotations;
+	for (int32 PoseIdx = 0; PoseIdx < NumPoses; ++PoseIdx)
+	{
+		const FVector ActorLocation = RandomStream.VRand() * RandomStream.FRandRange(0.0f, 10000.0f);
+		ActorToWorlds.Add(FTransform(FRotator(0.0f, RandomStream.FRandRange(-180.0f, 180.0f), 0.0f), ActorLocation));
+		CameraLocations.Add(ActorLocation + FVector(0.0f, 0.0f, 64.0f) + RandomStream.VRand() * 10.0f);
+		CameraRotations.Add(FRotator(RandomStream.FRandRange(-89.0f, 89.0f), RandomStream.FRandRange(-180.0f, 180.0f), 0.0f));
+	}
+
+	// same placement both ways
+	for (int32 PoseIdx = 0; PoseIdx < NumPoses; ++PoseIdx)
+	{
+		const FTransform Expected = PlaceMesh1PWithMatrices(CharacterClass, ActorToWorlds[PoseIdx], CameraLocations[PoseIdx], CameraRotations[PoseIdx]);
+		const FTransform Actual = PlaceMesh1PWithTransforms(DefaultMesh1PTransform, ActorToWorlds[PoseIdx], CameraLocations[PoseIdx], CameraRotations[PoseIdx]);
+
+		if (!Expected.GetLocation().Equals(Actual.GetLocation(), 0.01f) || !Expected.Rotator().Equals(Actual.Rotator(), 0.01f))
+		{
+			AddError(FString::Printf(TEXT("Pose %d placed at %s %s, expected %s %s"), PoseIdx,
+				*Actual.GetLocation().ToString(), *Actual.Rotator().ToString(), *Expected.GetLocation().ToString(), *Expected.Rotator().ToString()));
+			return false;
+		}
+	}
+
+	// timing of both, the sum keeps the calls from being optimized away
+	FVector Sum = FVector::ZeroVector;
+
+	const double MatrixStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 PoseIdx = 0; PoseIdx < NumPoses; ++PoseIdx)
+		{
+			Sum += PlaceMesh1PWithMatrices(CharacterClass, ActorToWorlds[PoseIdx], CameraLocations[PoseIdx], CameraRotations[PoseIdx]).GetLocation();
+		}
+	}
+	const double MatrixTime = FPlatformTime::Seconds() - MatrixStartTime;
+
+	const double TransformStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 PoseIdx = 0; PoseIdx < NumPoses; ++PoseIdx)
+		{
+			Sum += PlaceMesh1PWithTransforms(DefaultMesh1PTransform, ActorToWorlds[PoseIdx], CameraLocations[PoseIdx], CameraRotations[PoseIdx]).GetLocation();
+		}
+	}
+	const double TransformTime = FPlatformTime::Seconds() - TransformStartTime;
+
+	const int32 NumCalls = NumPoses * NumIterations;
+	AddInfo(FString::Printf(TEXT("Camera update over %d calls: lookup + matrices %.1f ns/call, cached + transforms %.1f ns/call (checksum %.0f)"),
+		NumCalls, MatrixTime * 1e9 / NumCalls, TransformTime * 1e9 / NumCalls, Sum.Size()));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "CustomSettings.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ConfigCacheIni.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRCustomSettingsTest, "FightingVR.Settings.CustomSettings", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRCustomSettingsTest::RunTest(const FString& Parameters)
+{
+	UCustomSettings* Settings = GetMutableDefault<UCustomSettings>();
+	const FString Section = UCustomSettings::StaticClass()->GetPathName();
+	const TCHAR* Key = TEXT("bWithStandaloneHMD");
+
+	// leave the cached settings and the ini as they were
+	const bool bOriginalValue = Settings->bWithStandaloneHMD;
+	bool bOriginalIniValue = false;
+	const bool bHadIniValue = GConfig->GetBool(*Section, Key, bOriginalIniValue, GGameIni);
+
+	int32 NumChanged = 0;
+	const FDelegateHandle ChangedHandle = UCustomSettings::OnChanged.AddLambda([&NumChanged](const UCustomSettings*) { ++NumChanged; });
+
+	// getters read the cached value
+	TestEqual(TEXT("Getter matches the cached value"), UCustomSettings::GetWithStandaloneHMD(), Settings->bWithStandaloneHMD);
+
+	// a changed ini value is only picked up by a reload, which broadcasts once
+	GConfig->SetBool(*Section, Key, !bOriginalValue, GGameIni);
+	TestEqual(TEXT("Getter keeps the cached value until reloaded"), UCustomSettings::GetWithStandaloneHMD(), bOriginalValue);
+
+	UCustomSettings::Reload();
+	TestEqual(TEXT("Getter returns the reloaded value"), UCustomSettings::GetWithStandaloneHMD(), !bOriginalValue);
+	TestEqual(TEXT("OnChanged broadcasts per reload"), NumChanged, 1);
+
+	// a key missing from the ini keeps its current value, even when that is not the property default
+	GConfig->RemoveKey(*Section, Key, GGameIni);
+	Settings->bWithStandaloneHMD = false;
+
+	UCustomSettings::Reload();
+	TestFalse(TEXT("Missing key keeps the current value"), UCustomSettings::GetWithStandaloneHMD());
+	TestEqual(TEXT("OnChanged broadcasts per reload"), NumChanged, 2);
+
+	UCustomSettings::OnChanged.Remove(ChangedHandle);
+
+	if (bHadIniValue)
+	{
+		GConfig->SetBool(*Section, Key, bOriginalIniValue, GGameIni);
+	}
+	Settings->bWithStandaloneHMD = bOriginalValue;
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Weapons/FightingVRFireScheduler.h"
+#include "Weapons/FightingVRWeapon_Instant.h"
+#include "Weapons/FightingVRWeapon_Projectile.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/FightingVRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRFireSchedulerTest, "FightingVR.Weapons.FireScheduler", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRFireSchedulerTest::RunTest(const FString& Parameters)
+{
+	const float Duration = 10.0f;
+	const float StepRate = IConsoleManager::Get().FindConsoleVariable(TEXT("FightingVR.FireScheduler.StepRate"))->GetFloat();
+
+	FFightingVRScopedTestWorld World;
+	UFightingVRFireScheduler* FireScheduler = World->GetSubsystem<UFightingVRFireScheduler>();
+	if (!TestNotNull(TEXT("Fire scheduler"), FireScheduler))
+	{
+		return false;
+	}
+
+	// the schedule only needs distinct weapons to key shots by, the class defaults stand in for spawned ones
+	struct FTestWeapon
+	{
+		AFightingVRWeapon* Weapon;
+		float TimeBetweenShots;
+		TArray<double> ShotTimes;
+		double WorstLatency;
+	};
+
+	TArray<int32> NumShotsPerFrameRate[2];
+
+	for (const float FrameRate : { 30.0f, 60.0f, 144.0f })
+	{
+		FTestWeapon Weapons[2] = {
+			{ GetMutableDefault<AFightingVRWeapon_Instant>(), 0.1f, {}, 0.0 },
+			{ GetMutableDefault<AFightingVRWeapon_Projectile>(), 0.07f, {}, 0.0 } };
+
+		double Now = 0.0;
+		FireScheduler->ShotDispatchOverride = [&](AFightingVRWeapon* Weapon)
+		{
+			FTestWeapon& TestWeapon = Weapons[0].Weapon == Weapon ? Weapons[0] : Weapons[1];
+			const double ShotTime = FireScheduler->GetShotTime();
+
+			TestWeapon.ShotTimes.Add(ShotTime);
+			TestWeapon.WorstLatency = FMath::Max(TestWeapon.WorstLatency, Now - ShotTime);
+			FireScheduler->ScheduleFire(Weapon, UFightingVRFireScheduler::GetRefireTime(ShotTime, Now, TestWeapon.TimeBetweenShots, true));
+		};
+
+		// first shot fires right away, as OnBurstStarted does, and schedules the rest
+		for (FTestWeapon& TestWeapon : Weapons)
+		{
+			TestWeapon.ShotTimes.Add(Now);
+			FireScheduler->ScheduleFire(TestWeapon.Weapon, UFightingVRFireScheduler::GetRefireTime(Now, Now, TestWeapon.TimeBetweenShots, true));
+		}
+
+		const int32 NumFrames = FMath::RoundToInt(Duration * FrameRate);
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			Now = Frame / FrameRate;
+			FireScheduler->AdvanceTo(Now);
+		}
+
+		for (int32 WeaponIdx = 0; WeaponIdx < 2; ++WeaponIdx)
+		{
+			FTestWeapon& TestWeapon = Weapons[WeaponIdx];
+			FireScheduler->CancelFire(TestWeapon.Weapon);
+
+			for (int32 ShotIdx = 1; ShotIdx < TestWeapon.ShotTimes.Num(); ++ShotIdx)
+			{
+				const double Interval = TestWeapon.ShotTimes[ShotIdx] - TestWeapon.ShotTimes[ShotIdx - 1];
+				if (!FMath::IsNearlyEqual(Interval, (double)TestWeapon.TimeBetweenShots, 1e-6))
+				{
+					AddError(FString::Printf(TEXT("%.0f fps: shot %d of weapon %d came %.4f secs after the previous one, expected %.4f"), FrameRate, ShotIdx, WeaponIdx, Interval, TestWeapon.TimeBetweenShots));
+					break;
+				}
+			}
+
+			const int32 ExpectedShots = FMath::FloorToInt(Duration / TestWeapon.TimeBetweenShots) + 1;
+			TestTrue(FString::Printf(TEXT("%.0f fps: weapon %d fired %d shots, expected %d"), FrameRate, WeaponIdx, TestWeapon.ShotTimes.Num(), ExpectedShots), FMath::Abs(TestWeapon.ShotTimes.Num() - ExpectedShots) <= 1);
+			TestTrue(FString::Printf(TEXT("%.0f fps: weapon %d shots fired at most a frame and a step late (%.4f secs)"), FrameRate, WeaponIdx, TestWeapon.WorstLatency), TestWeapon.WorstLatency <= 1.0 / FrameRate + 1.0 / StepRate + KINDA_SMALL_NUMBER);
+
+			NumShotsPerFrameRate[WeaponIdx].Add(TestWeapon.ShotTimes.Num());
+		}
+
+		AddInfo(FString::Printf(TEXT("%.0f fps over %.0f secs: %d and %d shots"), FrameRate, Duration, Weapons[0].ShotTimes.Num(), Weapons[1].ShotTimes.Num()));
+	}
+
+	FireScheduler->ShotDispatchOverride = nullptr;
+
+	// the fire rate does not depend on the frame rate
+	for (int32 WeaponIdx = 0; WeaponIdx < 2; ++WeaponIdx)
+	{
+		const TArray<int32>& NumShots = NumShotsPerFrameRate[WeaponIdx];
+		TestTrue(FString::Printf(TEXT("Weapon %d fires the same number of shots at every frame rate"), WeaponIdx), FMath::Max(NumShots) - FMath::Min(NumShots) <= 1);
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Player/FightingVRLocalPlayerRegistry.h"
+#include "Player/FightingVRPlayerController.h"
+#include "Online/FightingVRPlayerState.h"
+#include "OnlineSubsystemTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/FightingVRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FUniqueNetIdRepl MakeTestUniqueId(int32 PlayerIdx)
+{
+	return FUniqueNetIdRepl(MakeShared<FUniqueNetIdString>(FString::Printf(TEXT("LocalPlayer%d"), PlayerIdx), FName(TEXT("Null"))));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRLocalPlayerRegistryTest, "FightingVR.Player.LocalPlayerRegistry", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRLocalPlayerRegistryTest::RunTest(const FString& Parameters)
+{
+	// 1 to 4 split screen players, each dispatch must reach exactly the local controllers
+	for (int32 NumLocalPlayers = 1; NumLocalPlayers <= 4; ++NumLocalPlayers)
+	{
+		FFightingVRScopedTestWorld World;
+
+		UFightingVRLocalPlayerRegistry* LocalPlayerRegistry = World->GetSubsystem<UFightingVRLocalPlayerRegistry>();
+		if (!TestNotNull(TEXT("Local player registry"), LocalPlayerRegistry))
+		{
+			return false;
+		}
+
+		TArray<AFightingVRPlayerController*> Controllers;
+		for (int32 PlayerIdx = 0; PlayerIdx < NumLocalPlayers; ++PlayerIdx)
+		{
+			AFightingVRPlayerController* Controller = World->SpawnActor<AFightingVRPlayerController>();
+			AFightingVRPlayerState* PlayerState = World->SpawnActor<AFightingVRPlayerState>();
+			PlayerState->SetUniqueId(MakeTestUniqueId(PlayerIdx));
+			Controller->PlayerState = PlayerState;
+
+			LocalPlayerRegistry->RegisterController(Controller);
+			LocalPlayerRegistry->RegisterController(Controller);
+			Controllers.Add(Controller);
+		}
+
+		// a remote player, never registered
+		AFightingVRPlayerState* RemotePlayerState = World->SpawnActor<AFightingVRPlayerState>();
+		RemotePlayerState->SetUniqueId(MakeTestUniqueId(100));
+
+		TestEqual(*FString::Printf(TEXT("%d local players: registered controllers"), NumLocalPlayers), LocalPlayerRegistry->GetLocalControllers(), Controllers);
+
+		for (int32 PlayerIdx = 0; PlayerIdx < NumLocalPlayers; ++PlayerIdx)
+		{
+			AFightingVRPlayerController* Controller = Controllers[PlayerIdx];
+			TestEqual(*FString::Printf(TEXT("%d local players: killer %d by player state"), NumLocalPlayers, PlayerIdx), LocalPlayerRegistry->FindByPlayerState(Controller->PlayerState), Controller);
+
+			// the copy a seamless travel leaves behind, or an inactive player state reused on reconnect
+			AFightingVRPlayerState* TravelledPlayerState = World->SpawnActor<AFightingVRPlayerState>();
+			TravelledPlayerState->SetUniqueId(MakeTestUniqueId(PlayerIdx));
+			TestEqual(*FString::Printf(TEXT("%d local players: killer %d by unique net id"), NumLocalPlayers, PlayerIdx), LocalPlayerRegistry->FindByPlayerState(TravelledPlayerState), Controller);
+		}
+
+		TestNull(*FString::Printf(TEXT("%d local players: remote killer"), NumLocalPlayers), LocalPlayerRegistry->FindByPlayerState(RemotePlayerState));
+		TestNull(*FString::Printf(TEXT("%d local players: no killer"), NumLocalPlayers), LocalPlayerRegistry->FindByPlayerState(nullptr));
+
+		// the last player leaves, the others keep getting dispatches
+		AFightingVRPlayerController* LeavingController = Controllers.Pop();
+		LocalPlayerRegistry->UnregisterController(LeavingController);
+		TestEqual(*FString::Printf(TEXT("%d local players: after unregister"), NumLocalPlayers), LocalPlayerRegistry->GetLocalControllers(), Controllers);
+		TestNull(*FString::Printf(TEXT("%d local players: unregistered killer"), NumLocalPlayers), LocalPlayerRegistry->FindByPlayerState(LeavingController->PlayerState));
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Widgets/SFightingVRMenuWidget.h"
+#include "Widgets/SVirtualWindow.h"
+#include "Debugging/SlateDebugging.h"
+#include "Tests/AutomationCommon.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Size of the offscreen window the menu is painted into */
+static const FVector2D MenuPaintWindowSize(1920.0f, 1080.0f);
+
+/** Long enough for the fade in and roll out animations of the menu to finish */
+static const float MenuSettleTime = 1.5f;
+
+/** Idle frames painted per measurement */
+static const int32 MenuPaintFrames = 10;
+
+/** Counts the volatile widgets below Widget, skipping menu items, which keep their small bound attributes on purpose */
+static int32 CountVolatileWidgets(const TSharedRef<SWidget>& Widget, TArray<FName>& OutVolatileTypes)
+{
+	int32 NumVolatile = 0;
+	FChildren* Children = Widget->GetChildren();
+	for (int32 ChildIndex = 0; ChildIndex < Children->Num(); ++ChildIndex)
+	{
+		const TSharedRef<SWidget> Child = Children->GetChildAt(ChildIndex);
+		if (Child->GetType() == TEXT("SFightingVRMenuItem"))
+		{
+			continue;
+		}
+
+		if (Child->IsVolatile())
+		{
+			OutVolatileTypes.Add(Child->GetType());
+			++NumVolatile;
+		}
+		NumVolatile += CountVolatileWidgets(Child, OutVolatileTypes);
+	}
+	return NumVolatile;
+}
+
+/** Painted widgets and elements built outside the invalidation cache, averaged over the measured frames */
+struct FFightingVRMenuPaintStats
+{
+	float PaintedWidgets;
+	float UncachedElements;
+};
+
+/** Paints the window offscreen, the way the viewport would, and returns what a single frame costs */
+static FFightingVRMenuPaintStats PaintMenuFrames(const TSharedRef<SVirtualWindow>& Window, int32 NumFrames)
+{
+	FFightingVRMenuPaintStats Stats = { 0.0f, 0.0f };
+
+	int32 PaintedWidgets = 0;
+#if WITH_SLATE_DEBUGGING
+	FDelegateHandle BeginWidgetPaintHandle = FSlateDebugging::BeginWidgetPaint.AddLambda([&PaintedWidgets](const SWidget*, const FPaintArgs&, const FGeometry&, const FSlateRect&, const FSlateWindowElementList&, int32)
+	{
+		++PaintedWidgets;
+	});
+#endif
+
+	int32 UncachedElements = 0;
+	const FGeometry WindowGeometry = FGeometry::MakeRoot(MenuPaintWindowSize, FSlateLayoutTransform());
+	const float DeltaTime = 1.0f / 60.0f;
+
+	// a first frame picks up anything changed while the test was waiting, the rest are idle
+	for (int32 Frame = 0; Frame <= NumFrames; ++Frame)
+	{
+		Window->GetHittestGrid().Clear();
+		Window->SlatePrepass(1.0f);
+
+		const int32 PaintedWidgetsBefore = PaintedWidgets;
+		FSlateWindowElementList ElementList(Window);
+		FPaintArgs PaintArgs(&Window.Get(), Window->GetHittestGrid(), FVector2D::ZeroVector, FSlateApplication::Get().GetCurrentTime(), DeltaTime);
+		Window->Paint(PaintArgs, WindowGeometry, FSlateRect(FVector2D::ZeroVector, MenuPaintWindowSize), ElementList, 0, FWidgetStyle(), true);
+
+		if (Frame == 0)
+		{
+			PaintedWidgets = PaintedWidgetsBefore;
+		}
+		else
+		{
+			UncachedElements += ElementList.GetUncachedDrawElements().Num();
+		}
+	}
+
+#if WITH_SLATE_DEBUGGING
+	FSlateDebugging::BeginWidgetPaint.Remove(BeginWidgetPaintHandle);
+#endif
+
+	Stats.PaintedWidgets = (float)PaintedWidgets / NumFrames;
+	Stats.UncachedElements = (float)UncachedElements / NumFrames;
+	return Stats;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_THREE_PARAMETER(FFightingVRMeasureMenuPaintCommand, FAutomationTestBase*, Test, TSharedRef<SVirtualWindow>, Window, TSharedRef<SFightingVRMenuWidget>, MenuWidget);
+
+bool FFightingVRMeasureMenuPaintCommand::Update()
+{
+	// only the menu items may stay volatile, everything else is pushed by UpdateAnimatedWidgets
+	TArray<FName> VolatileTypes;
+	const int32 NumVolatile = CountVolatileWidgets(MenuWidget, VolatileTypes);
+	TArray<FString> VolatileTypeNames;
+	for (const FName& Type : VolatileTypes)
+	{
+		VolatileTypeNames.Add(Type.ToString());
+	}
+	Test->TestEqual(*FString::Printf(TEXT("Volatile widgets outside the menu items (%s)"), *FString::Join(VolatileTypeNames, TEXT(", "))), NumVolatile, 0);
+
+	// before: everything below the menu repaints every frame
+	IConsoleVariable* InvalidationPanelsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Slate.EnableInvalidationPanels"));
+	if (!Test->TestNotNull(TEXT("Slate.EnableInvalidationPanels"), InvalidationPanelsCVar))
+	{
+		return true;
+	}
+
+	const int32 OldEnableInvalidationPanels = InvalidationPanelsCVar->GetInt();
+	InvalidationPanelsCVar->Set(0, ECVF_SetByCode);
+	const FFightingVRMenuPaintStats UncachedStats = PaintMenuFrames(Window, MenuPaintFrames);
+
+	// after: an idle menu only repaints its volatile menu items
+	InvalidationPanelsCVar->Set(1, ECVF_SetByCode);
+	const FFightingVRMenuPaintStats CachedStats = PaintMenuFrames(Window, MenuPaintFrames);
+
+	InvalidationPanelsCVar->Set(OldEnableInvalidationPanels, ECVF_SetByCode);
+
+	Test->AddInfo(FString::Printf(TEXT("Idle menu frame without caching: %.1f painted widgets, %.1f uncached elements"), UncachedStats.PaintedWidgets, UncachedStats.UncachedElements));
+	Test->AddInfo(FString::Printf(TEXT("Idle menu frame with caching: %.1f painted widgets, %.1f uncached elements"), CachedStats.PaintedWidgets, CachedStats.UncachedElements));
+
+	Test->TestTrue(TEXT("Painting the uncached menu builds elements"), UncachedStats.UncachedElements > 0.0f);
+	Test->TestTrue(TEXT("A cached idle menu builds fewer elements"), CachedStats.UncachedElements < UncachedStats.UncachedElements);
+#if WITH_SLATE_DEBUGGING
+	Test->TestTrue(TEXT("A cached idle menu paints fewer widgets"), CachedStats.PaintedWidgets < UncachedStats.PaintedWidgets);
+#endif
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRMenuWidgetPaintTest, "FightingVR.UI.MenuWidgetPaint", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRMenuWidgetPaintTest::RunTest(const FString& Parameters)
+{
+	if (!FSlateApplication::IsInitialized() || GEngine == nullptr)
+	{
+		AddWarning(TEXT("Slate is not initialized, the menu can't be painted."));
+		return true;
+	}
+
+	TSharedPtr<FFightingVRMenuItem> RootMenuItem;
+	TSharedPtr<FFightingVRMenuItem> OptionsItem = MenuHelper::AddMenuItem(RootMenuItem, FText::FromString(TEXT("OPTIONS")));
+	MenuHelper::AddMenuItem(OptionsItem, FText::FromString(TEXT("GAMEPLAY")));
+	MenuHelper::AddMenuItem(OptionsItem, FText::FromString(TEXT("AUDIO")));
+	MenuHelper::AddMenuItem(RootMenuItem, FText::FromString(TEXT("DEMOS")));
+	MenuHelper::AddMenuItem(RootMenuItem, FText::FromString(TEXT("QUIT")));
+
+	TSharedRef<SFightingVRMenuWidget> MenuWidget = SNew(SFightingVRMenuWidget).IsGameMenu(false);
+	MenuWidget->MainMenu = MenuWidget->CurrentMenu = RootMenuItem->SubMenu;
+	MenuWidget->CurrentMenuTitle = FText::FromString(TEXT("MAIN MENU"));
+
+	TSharedRef<SVirtualWindow> Window = SNew(SVirtualWindow).Size(MenuPaintWindowSize);
+	Window->SetContent(MenuWidget);
+	Window->GetHittestGrid().SetHittestArea(FVector2D::ZeroVector, MenuPaintWindowSize);
+
+	MenuWidget->BuildAndShowMenu();
+	PaintMenuFrames(Window, 1);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(MenuSettleTime));
+	ADD_LATENT_AUTOMATION_COMMAND(FFightingVRMeasureMenuPaintCommand(this, Window, MenuWidget));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Player/FightingVRPersistentUser.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Ids of the recently met list, most recent first */
+static TArray<FString> GetRecentlyMetIds(const UFightingVRPersistentUser* PersistentUser)
+{
+	TArray<FString> Ids;
+	for (const FFightingVRRecentlyMetPlayer& Player : PersistentUser->GetRecentlyMetPlayers())
+	{
+		Ids.Add(Player.UniqueId);
+	}
+	return Ids;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRRecentlyMetTest, "FightingVR.Player.RecentlyMet", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRRecentlyMetTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* MaxPlayersCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("FightingVR.RecentlyMet.MaxPlayers"));
+	if (!TestNotNull(TEXT("FightingVR.RecentlyMet.MaxPlayers"), MaxPlayersCVar))
+	{
+		return false;
+	}
+
+	const int32 OldMaxPlayers = MaxPlayersCVar->GetInt();
+	MaxPlayersCVar->Set(3, ECVF_SetByCode);
+
+	UFightingVRPersistentUser* PersistentUser = NewObject<UFightingVRPersistentUser>();
+
+	PersistentUser->AddRecentlyMetPlayer(TEXT("A"), TEXT("Alice"));
+	PersistentUser->AddRecentlyMetPlayer(TEXT("B"), TEXT("Bob"));
+	PersistentUser->AddRecentlyMetPlayer(TEXT("C"), TEXT("Carol"));
+	TestEqual(TEXT("Most recent first"), GetRecentlyMetIds(PersistentUser), TArray<FString>({ TEXT("C"), TEXT("B"), TEXT("A") }));
+
+	// meeting someone again moves them to the front without a duplicate
+	PersistentUser->AddRecentlyMetPlayer(TEXT("A"), TEXT("Alice"));
+	TestEqual(TEXT("Met again"), GetRecentlyMetIds(PersistentUser), TArray<FString>({ TEXT("A"), TEXT("C"), TEXT("B") }));
+
+	// a full list drops the least recently met
+	PersistentUser->AddRecentlyMetPlayer(TEXT("D"), TEXT("Dave"));
+	TestEqual(TEXT("Evicted the least recently met"), GetRecentlyMetIds(PersistentUser), TArray<FString>({ TEXT("D"), TEXT("A"), TEXT("C") }));
+
+	// a rename keeps the place in the list
+	PersistentUser->RenameRecentlyMetPlayer(TEXT("C"), TEXT("Caroline"));
+	TestEqual(TEXT("Renamed in place"), GetRecentlyMetIds(PersistentUser), TArray<FString>({ TEXT("D"), TEXT("A"), TEXT("C") }));
+	TestEqual(TEXT("New name"), PersistentUser->GetRecentlyMetPlayers()[2].PlayerName, FString(TEXT("Caroline")));
+
+	// renaming an evicted player does not bring them back
+	PersistentUser->RenameRecentlyMetPlayer(TEXT("B"), TEXT("Robert"));
+	TestEqual(TEXT("Rename of an unlisted player"), GetRecentlyMetIds(PersistentUser), TArray<FString>({ TEXT("D"), TEXT("A"), TEXT("C") }));
+
+	// lowering the limit trims on the next add
+	MaxPlayersCVar->Set(2, ECVF_SetByCode);
+	PersistentUser->AddRecentlyMetPlayer(TEXT("E"), TEXT("Eve"));
+	TestEqual(TEXT("Trimmed to the new limit"), GetRecentlyMetIds(PersistentUser), TArray<FString>({ TEXT("E"), TEXT("D") }));
+
+	PersistentUser->AddRecentlyMetPlayer(FString(), TEXT("Nobody"));
+	TestEqual(TEXT("Players without an id are skipped"), PersistentUser->GetRecentlyMetPlayers().Num(), 2);
+
+	MaxPlayersCVar->Set(OldMaxPlayers, ECVF_SetByCode);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Online/FightingVRReplayEvents.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Tests/FightingVRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRReplayEventsTest, "FightingVR.Online.ReplayEvents", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRReplayEventsTest::RunTest(const FString& Parameters)
+{
+	const FString StreamName = FString::Printf(TEXT("ReplayEventsTest_%s"), *FGuid::NewGuid().ToString());
+	const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Demos"), StreamName + TEXT(".events"));
+
+	TArray<FFightingVRReplayEvent> Events;
+	for (int32 EventIdx = 0; EventIdx < 100; ++EventIdx)
+	{
+		FFightingVRReplayEvent& Event = Events.AddDefaulted_GetRef();
+		Event.Time = EventIdx * 1.5f;
+		Event.Type = EventIdx % 10 == 0 ? EFightingVRReplayEventType::MatchState : (EventIdx % 2 ? EFightingVRReplayEventType::Death : EFightingVRReplayEventType::Kill);
+		Event.Description = FString::Printf(TEXT("Player%d > Player%d"), EventIdx % 7, EventIdx % 5);
+	}
+
+	TArray<FFightingVRReplayEvent> LoadedEvents;
+	TestFalse(TEXT("No side-car file yet"), UFightingVRReplayEventRecorder::LoadEvents(StreamName, LoadedEvents));
+
+	// round trip
+	TestTrue(TEXT("Save"), UFightingVRReplayEventRecorder::SaveEvents(StreamName, Events));
+	if (TestTrue(TEXT("Load"), UFightingVRReplayEventRecorder::LoadEvents(StreamName, LoadedEvents)) && TestEqual(TEXT("Event count"), LoadedEvents.Num(), Events.Num()))
+	{
+		for (int32 EventIdx = 0; EventIdx < Events.Num(); ++EventIdx)
+		{
+			const bool bSame = LoadedEvents[EventIdx].Time == Events[EventIdx].Time && LoadedEvents[EventIdx].Type == Events[EventIdx].Type && LoadedEvents[EventIdx].Description == Events[EventIdx].Description;
+			if (!bSame)
+			{
+				AddError(FString::Printf(TEXT("Event %d differs after the round trip"), EventIdx));
+				break;
+			}
+		}
+	}
+
+	// a file cut short by a crash is ignored as a whole
+	TArray<uint8> FileData;
+	if (TestTrue(TEXT("Read the side-car file"), FFileHelper::LoadFileToArray(FileData, *Filename)))
+	{
+		FileData.SetNum(FileData.Num() / 2);
+		FFileHelper::SaveArrayToFile(FileData, *Filename);
+		TestFalse(TEXT("Truncated file"), UFightingVRReplayEventRecorder::LoadEvents(StreamName, LoadedEvents));
+		TestEqual(TEXT("No events from a truncated file"), LoadedEvents.Num(), 0);
+
+		FileData.Init(0xFF, 64);
+		FFileHelper::SaveArrayToFile(FileData, *Filename);
+		TestFalse(TEXT("Unknown format"), UFightingVRReplayEventRecorder::LoadEvents(StreamName, LoadedEvents));
+	}
+
+	UFightingVRReplayEventRecorder::DeleteEvents(StreamName);
+	TestFalse(TEXT("Deleted"), FPaths::FileExists(Filename));
+
+	// without a recording, events are dropped and nothing is written
+	{
+		FFightingVRScopedTestWorld World;
+
+		UFightingVRReplayEventRecorder* ReplayEvents = World->GetSubsystem<UFightingVRReplayEventRecorder>();
+		if (TestNotNull(TEXT("Replay event recorder"), ReplayEvents))
+		{
+			ReplayEvents->RecordEvent(EFightingVRReplayEventType::MatchState, TEXT("InProgress"));
+			ReplayEvents->Flush();
+		}
+	}
+	TestFalse(TEXT("Nothing written without a recording"), FPaths::FileExists(Filename));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Online/FightingVRState.h"
+#include "Online/FightingVRPlayerState.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/FightingVRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** One line of the scripted kill log */
+struct FFightingVRScriptedKill
+{
+	int32 Frame;
+	int32 Killer;
+	int32 Victim;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRScoreFlushTest, "FightingVR.Online.ScoreFlush", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRScoreFlushTest::RunTest(const FString& Parameters)
+{
+	const int32 NumPlayers = 32;
+	const int32 NumTeams = 2;
+	const int32 NumFrames = 60;
+	const int32 KillsPerFrame = 8;
+	const int32 KillPoints = 10;
+	const int32 DeathPoints = -1;
+
+	FFightingVRScopedTestWorld World;
+
+	AFightingVRState* GameState = World->SpawnActor<AFightingVRState>();
+	World->SetGameState(GameState);
+
+	TArray<AFightingVRPlayerState*> PlayerStates;
+	for (int32 PlayerIdx = 0; PlayerIdx < NumPlayers; ++PlayerIdx)
+	{
+		AFightingVRPlayerState* PlayerState = World->SpawnActor<AFightingVRPlayerState>();
+		PlayerState->SetTeamNum(PlayerIdx % NumTeams);
+		PlayerStates.Add(PlayerState);
+	}
+
+	// a fixed, bot heavy kill log: several kills per frame, the same players often scoring twice in one frame
+	TArray<FFightingVRScriptedKill> KillLog;
+	FRandomStream Random(43);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (int32 KillIdx = 0; KillIdx < KillsPerFrame; ++KillIdx)
+		{
+			const int32 Killer = Random.RandRange(0, NumPlayers / 4 - 1);
+			const int32 Victim = (Killer + 1 + Random.RandRange(0, NumPlayers - 2)) % NumPlayers;
+			KillLog.Add({ Frame, Killer, Victim });
+		}
+	}
+
+	TArray<int32> ExpectedPlayerScores;
+	ExpectedPlayerScores.AddZeroed(NumPlayers);
+	TArray<int32> ExpectedTeamScores;
+	ExpectedTeamScores.AddZeroed(NumTeams);
+
+	// property updates the old path made (team score and player score on every event) and the flushed path makes
+	int32 NumPerEventUpdates = 0;
+	int32 NumFlushedUpdates = 0;
+
+	int32 KillIdx = 0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const TArray<int32> TeamScoresBefore = GameState->TeamScores;
+		TArray<float> PlayerScoresBefore;
+		for (const AFightingVRPlayerState* PlayerState : PlayerStates)
+		{
+			PlayerScoresBefore.Add(PlayerState->GetScore());
+		}
+
+		for (; KillIdx < KillLog.Num() && KillLog[KillIdx].Frame == Frame; ++KillIdx)
+		{
+			const FFightingVRScriptedKill& Kill = KillLog[KillIdx];
+			PlayerStates[Kill.Killer]->ScoreKill(PlayerStates[Kill.Victim], KillPoints);
+			PlayerStates[Kill.Victim]->ScoreDeath(PlayerStates[Kill.Killer], DeathPoints);
+
+			ExpectedPlayerScores[Kill.Killer] += KillPoints;
+			ExpectedPlayerScores[Kill.Victim] += DeathPoints;
+			ExpectedTeamScores[Kill.Killer % NumTeams] += KillPoints;
+			ExpectedTeamScores[Kill.Victim % NumTeams] += DeathPoints;
+			NumPerEventUpdates += 4;
+		}
+
+		if (!TestTrue(*FString::Printf(TEXT("Frame %d: team scores unchanged before the flush"), Frame), GameState->TeamScores == TeamScoresBefore))
+		{
+			return false;
+		}
+
+		GameState->FlushPendingScores();
+
+		for (int32 TeamIdx = 0; TeamIdx < GameState->TeamScores.Num(); ++TeamIdx)
+		{
+			if (!TeamScoresBefore.IsValidIndex(TeamIdx) || GameState->TeamScores[TeamIdx] != TeamScoresBefore[TeamIdx])
+			{
+				++NumFlushedUpdates;
+			}
+		}
+		for (int32 PlayerIdx = 0; PlayerIdx < NumPlayers; ++PlayerIdx)
+		{
+			if (PlayerStates[PlayerIdx]->GetScore() != PlayerScoresBefore[PlayerIdx])
+			{
+				++NumFlushedUpdates;
+			}
+		}
+	}
+
+	TestEqual(TEXT("Team score count"), GameState->TeamScores.Num(), NumTeams);
+	for (int32 TeamIdx = 0; TeamIdx < NumTeams && TeamIdx < GameState->TeamScores.Num(); ++TeamIdx)
+	{
+		TestEqual(*FString::Printf(TEXT("Team %d score"), TeamIdx), GameState->TeamScores[TeamIdx], ExpectedTeamScores[TeamIdx]);
+	}
+
+	int32 PlayerScoreTotal = 0;
+	for (int32 PlayerIdx = 0; PlayerIdx < NumPlayers; ++PlayerIdx)
+	{
+		TestEqual(*FString::Printf(TEXT("Player %d score"), PlayerIdx), FMath::RoundToInt(PlayerStates[PlayerIdx]->GetScore()), ExpectedPlayerScores[PlayerIdx]);
+		PlayerScoreTotal += FMath::RoundToInt(PlayerStates[PlayerIdx]->GetScore());
+	}
+	TestEqual(TEXT("Player scores add up to the team scores"), PlayerScoreTotal, ExpectedTeamScores[0] + ExpectedTeamScores[1]);
+
+	// every player and team changes at most once per frame
+	TestTrue(TEXT("At most one update per property per frame"), NumFlushedUpdates <= NumFrames * (NumPlayers + NumTeams));
+	TestTrue(TEXT("Fewer updates than scoring every event"), NumFlushedUpdates < NumPerEventUpdates);
+
+	AddInfo(FString::Printf(TEXT("%d kills over %d frames: %d property updates scoring every event, %d flushed"), KillLog.Num(), NumFrames, NumPerEventUpdates, NumFlushedUpdates));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "LoadText.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Store path relative to the project dir, as the LoadText functions take it */
+static const TCHAR* ScoreStoreTestPath = TEXT("Saved/Automation/FightingVRScoreStoreTest.bin");
+
+static TArray<FScoreData> MakeRandomScores(int32 NumScores, int32 Seed)
+{
+	FRandomStream RandomStream(Seed);
+
+	TArray<FScoreData> Scores;
+	Scores.SetNumUninitialized(NumScores);
+	for (int32 ScoreIdx = 0; ScoreIdx < NumScores; ++ScoreIdx)
+	{
+		FScoreData& Score = Scores[ScoreIdx];
+		Score.masterNumber = ScoreIdx;
+		// few distinct values, so the damage tie breakers get exercised
+		Score.scoreValue = (float)RandomStream.RandRange(0, 100);
+		Score.damageValue = (float)RandomStream.RandRange(0, 10);
+		Score.takenDamageValue = (float)RandomStream.RandRange(0, 10);
+	}
+	return Scores;
+}
+
+static bool ScoresMatch(const FScoreData& A, const FScoreData& B)
+{
+	return A.scoreValue == B.scoreValue && A.damageValue == B.damageValue && A.takenDamageValue == B.takenDamageValue;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRScoreStoreTest, "FightingVR.LoadText.ScoreStore", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRScoreStoreTest::RunTest(const FString& Parameters)
+{
+	const FString Filename = FPaths::ProjectDir() + ScoreStoreTestPath;
+	IFileManager::Get().Delete(*Filename, false, true, true);
+
+	const TArray<FScoreData> Scores = MakeRandomScores(200, 1);
+
+	// appends round trip
+	for (const FScoreData& Score : Scores)
+	{
+		TestTrue(TEXT("Append"), ULoadText::ScoreAppend(Score, ScoreStoreTestPath));
+	}
+
+	TArray<FScoreData> Loaded;
+	TestTrue(TEXT("Load"), ULoadText::ScoreLoad(ScoreStoreTestPath, Loaded));
+	TestEqual(TEXT("Loaded records"), Loaded.Num(), Scores.Num());
+
+	// a torn tail is dropped on load and cut off by the next append
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename, FILEWRITE_Append));
+		uint8 TornBytes[5] = { 1, 2, 3, 4, 5 };
+		Writer->Serialize(TornBytes, sizeof(TornBytes));
+	}
+
+	TestTrue(TEXT("Load with a torn record"), ULoadText::ScoreLoad(ScoreStoreTestPath, Loaded));
+	TestEqual(TEXT("Torn record dropped"), Loaded.Num(), Scores.Num());
+
+	TestTrue(TEXT("Append after a torn record"), ULoadText::ScoreAppend(Scores[0], ScoreStoreTestPath));
+	TestTrue(TEXT("Load after the repair"), ULoadText::ScoreLoad(ScoreStoreTestPath, Loaded));
+	TestEqual(TEXT("Appended record follows the whole ones"), Loaded.Num(), Scores.Num() + 1);
+	TestTrue(TEXT("Appended record intact"), Loaded.Num() > 0 && ScoresMatch(Loaded.Last(), Scores[0]));
+
+	// a file of another format is left alone
+	const TArray<uint8> ForeignData = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
+	FFileHelper::SaveArrayToFile(ForeignData, *Filename);
+	TestFalse(TEXT("Append to a foreign file"), ULoadText::ScoreAppend(Scores[0], ScoreStoreTestPath));
+	TestEqual(TEXT("Foreign file untouched"), IFileManager::Get().FileSize(*Filename), (int64)ForeignData.Num());
+
+	IFileManager::Get().Delete(*Filename, false, true, true);
+
+	// top K and rank queries agree with a full sort, ranked array queries agree with the scans
+	TArray<FScoreData> Sorted = Scores;
+	ULoadText::ScoreRankSort(Sorted);
+
+	TArray<FScoreData> TopScores;
+	ULoadText::ScoreTopK(Scores, 10, TopScores);
+	TestEqual(TEXT("Top K count"), TopScores.Num(), 10);
+	for (int32 TopIdx = 0; TopIdx < TopScores.Num(); ++TopIdx)
+	{
+		TestTrue(TEXT("Top K matches the sorted prefix"), ScoresMatch(TopScores[TopIdx], Sorted[TopIdx]));
+	}
+
+	TArray<FScoreData> Ranked;
+	for (const FScoreData& Score : Scores)
+	{
+		ULoadText::ScoreInsertRanked(Ranked, Score);
+	}
+
+	for (int32 RankIdx = 0; RankIdx < Ranked.Num(); ++RankIdx)
+	{
+		if (!ScoresMatch(Ranked[RankIdx], Sorted[RankIdx]))
+		{
+			AddError(FString::Printf(TEXT("Ranked insert differs from the sort at %d"), RankIdx));
+			break;
+		}
+	}
+
+	for (const FScoreData& Score : Scores)
+	{
+		TestEqual(TEXT("Rank of a ranked array matches the scan"), ULoadText::ScoreRankOfRanked(Ranked, Score), ULoadText::ScoreRankOf(Scores, Score));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRScoreStoreBenchmark, "FightingVR.LoadText.ScoreStoreBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FFightingVRScoreStoreBenchmark::RunTest(const FString& Parameters)
+{
+	const FString Filename = FPaths::ProjectDir() + ScoreStoreTestPath;
+	const int32 NumAppends = 1000;
+	const int32 NumQueries = 1000;
+	const int32 TopCount = 100;
+
+	for (const int32 NumScores : { 10000, 1000000 })
+	{
+		const TArray<FScoreData> Scores = MakeRandomScores(NumScores, NumScores);
+		IFileManager::Get().Delete(*Filename, false, true, true);
+
+		double StartTime = FPlatformTime::Seconds();
+		TestTrue(TEXT("Compact"), ULoadText::ScoreCompact(Scores, ScoreStoreTestPath));
+		const double CompactMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 AppendIdx = 0; AppendIdx < NumAppends; ++AppendIdx)
+		{
+			ULoadText::ScoreAppend(Scores[AppendIdx], ScoreStoreTestPath);
+		}
+		const double AppendUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / NumAppends;
+
+		TArray<FScoreData> Loaded;
+		StartTime = FPlatformTime::Seconds();
+		TestTrue(TEXT("Load"), ULoadText::ScoreLoad(ScoreStoreTestPath, Loaded));
+		const double LoadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		TestEqual(TEXT("Loaded records"), Loaded.Num(), NumScores + NumAppends);
+
+		TArray<FScoreData> Ranked = Scores;
+		StartTime = FPlatformTime::Seconds();
+		ULoadText::ScoreRankSort(Ranked);
+		const double SortMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TArray<FScoreData> TopScores;
+		StartTime = FPlatformTime::Seconds();
+		ULoadText::ScoreTopK(Scores, TopCount, TopScores);
+		const double TopKMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		// rank queries, by scan and on the ranked array, the sum keeps the calls from being optimized away
+		int64 RankSum = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; ++QueryIdx)
+		{
+			RankSum += ULoadText::ScoreRankOf(Scores, Scores[QueryIdx]);
+		}
+		const double RankOfUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / NumQueries;
+
+		int64 RankedSum = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; ++QueryIdx)
+		{
+			RankedSum += ULoadText::ScoreRankOfRanked(Ranked, Scores[QueryIdx]);
+		}
+		const double RankOfRankedUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / NumQueries;
+		TestEqual(TEXT("Ranked and scanned ranks agree"), RankedSum, RankSum);
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; ++QueryIdx)
+		{
+			ULoadText::ScoreInsertRanked(Ranked, Scores[QueryIdx]);
+		}
+		const double InsertRankedUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / NumQueries;
+
+		AddInfo(FString::Printf(TEXT("%d scores: compact %.1f ms, append %.1f us, load %.1f ms, sort %.1f ms, top %d %.1f ms, rank scan %.1f us, rank ranked %.2f us, insert ranked %.1f us"),
+			NumScores, CompactMs, AppendUs, LoadMs, SortMs, TopCount, TopKMs, RankOfUs, RankOfRankedUs, InsertRankedUs));
+	}
+
+	IFileManager::Get().Delete(*Filename, false, true, true);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
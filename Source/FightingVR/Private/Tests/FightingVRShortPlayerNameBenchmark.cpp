@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Online/FightingVRPlayerState.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/FightingVRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Forwards to the engine allocator, counting the allocations made on the game thread while installed */
+class FFightingVRCountingMalloc : public FMalloc
+{
+public:
+	explicit FFightingVRCountingMalloc(FMalloc* InInnerMalloc)
+		: InnerMalloc(InInnerMalloc)
+		, NumAllocations(0)
+	{
+	}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return InnerMalloc->Malloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return InnerMalloc->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+	virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return TEXT("FightingVRCountingMalloc"); }
+
+	int32 GetNumAllocations() const { return NumAllocations; }
+	void ResetNumAllocations() { NumAllocations = 0; }
+
+private:
+	void CountAllocation()
+	{
+		if (IsInGameThread())
+		{
+			++NumAllocations;
+		}
+	}
+
+	FMalloc* InnerMalloc;
+	int32 NumAllocations;
+};
+
+/** Short name as GetShortPlayerName used to build it on every call */
+static FString BuildShortPlayerName(const APlayerState* PlayerState)
+{
+	if (PlayerState->GetPlayerName().Len() > MAX_PLAYER_NAME_LENGTH)
+	{
+		return PlayerState->GetPlayerName().Left(MAX_PLAYER_NAME_LENGTH) + "...";
+	}
+	return PlayerState->GetPlayerName();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRShortPlayerNameBenchmark, "FightingVR.Online.ShortPlayerNameBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FFightingVRShortPlayerNameBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumPlayers = 32;
+	const int32 NumFrames = 1000;
+
+	FFightingVRScopedTestWorld World;
+
+	// half of the names long enough to be truncated
+	TArray<AFightingVRPlayerState*> PlayerStates;
+	for (int32 PlayerIdx = 0; PlayerIdx < NumPlayers; ++PlayerIdx)
+	{
+		AFightingVRPlayerState* PlayerState = World->SpawnActor<AFightingVRPlayerState>();
+		PlayerState->SetPlayerName(PlayerIdx % 2 ? FString::Printf(TEXT("Player%02d"), PlayerIdx) : FString::Printf(TEXT("AVeryLongPlayerName%02dThatIsCut"), PlayerIdx));
+		PlayerStates.Add(PlayerState);
+	}
+
+	for (const AFightingVRPlayerState* PlayerState : PlayerStates)
+	{
+		if (PlayerState->GetShortPlayerName() != BuildShortPlayerName(PlayerState) || !PlayerState->GetShortPlayerNameText().ToString().Equals(PlayerState->GetShortPlayerName()))
+		{
+			AddError(FString::Printf(TEXT("Cached short name \"%s\" of \"%s\" does not match"), *PlayerState->GetShortPlayerName(), *PlayerState->GetPlayerName()));
+			return false;
+		}
+	}
+
+	// a frame reads every short name as a string (hud, death messages) and as text (scoreboard, roster),
+	// the sum of the lengths keeps the calls from being optimized away
+	int32 Sum = 0;
+
+	FFightingVRCountingMalloc CountingMalloc(GMalloc);
+	FMalloc* const EngineMalloc = GMalloc;
+	GMalloc = &CountingMalloc;
+
+	const double BuiltStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (const AFightingVRPlayerState* PlayerState : PlayerStates)
+		{
+			const FString ShortName = BuildShortPlayerName(PlayerState);
+			const FText ShortNameText = FText::FromString(ShortName);
+			Sum += ShortName.Len() + ShortNameText.ToString().Len();
+		}
+	}
+	const double BuiltTime = FPlatformTime::Seconds() - BuiltStartTime;
+	const int32 NumBuiltAllocations = CountingMalloc.GetNumAllocations();
+
+	CountingMalloc.ResetNumAllocations();
+
+	const double CachedStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (const AFightingVRPlayerState* PlayerState : PlayerStates)
+		{
+			const FString& ShortName = PlayerState->GetShortPlayerName();
+			const FText& ShortNameText = PlayerState->GetShortPlayerNameText();
+			Sum += ShortName.Len() + ShortNameText.ToString().Len();
+		}
+	}
+	const double CachedTime = FPlatformTime::Seconds() - CachedStartTime;
+	const int32 NumCachedAllocations = CountingMalloc.GetNumAllocations();
+
+	GMalloc = EngineMalloc;
+
+	AddInfo(FString::Printf(TEXT("%d players over %d frames: built per call %.1f allocations/frame %.2f us/frame, cached %.1f allocations/frame %.2f us/frame (checksum %d)"),
+		NumPlayers, NumFrames,
+		(float)NumBuiltAllocations / NumFrames, BuiltTime * 1e6 / NumFrames,
+		(float)NumCachedAllocations / NumFrames, CachedTime * 1e6 / NumFrames, Sum));
+
+	TestEqual(TEXT("Allocations reading the cached short names"), NumCachedAllocations, 0);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
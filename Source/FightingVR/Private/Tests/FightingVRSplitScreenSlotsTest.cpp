@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "FightingVRSplitScreenSlots.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Slots as a short string: J<controller> joined, S<controller> signing in, O open, C closed */
+static FString DescribeSlots(const FFightingVRSplitScreenSlots& Slots)
+{
+	TArray<FString> Descriptions;
+	for (int32 SlotIndex = 0; SlotIndex < FFightingVRSplitScreenSlots::MaxSlots; ++SlotIndex)
+	{
+		const FFightingVRLobbySlot Slot = Slots.GetSlot(SlotIndex);
+		switch (Slot.State)
+		{
+		case EFightingVRLobbySlotState::Joined:		Descriptions.Add(FString::Printf(TEXT("J%d"), Slot.ControllerId)); break;
+		case EFightingVRLobbySlotState::SigningIn:	Descriptions.Add(FString::Printf(TEXT("S%d"), Slot.ControllerId)); break;
+		case EFightingVRLobbySlotState::Open:		Descriptions.Add(TEXT("O")); break;
+		default:									Descriptions.Add(TEXT("C")); break;
+		}
+	}
+	return FString::Join(Descriptions, TEXT(" "));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRSplitScreenSlotsTest, "FightingVR.UI.SplitScreenSlots", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRSplitScreenSlotsTest::RunTest(const FString& Parameters)
+{
+	FFightingVRSplitScreenSlots Slots;
+
+	TArray<int32> ChangedSlots;
+	Slots.OnSlotChanged.BindLambda([&ChangedSlots](int32 SlotIndex) { ChangedSlots.Add(SlotIndex); });
+
+	TestEqual(TEXT("All closed before the maximum is known"), DescribeSlots(Slots), FString(TEXT("C C C C")));
+
+	Slots.SetNumSupportedSlots(3);
+	TestEqual(TEXT("Open up to the maximum"), DescribeSlots(Slots), FString(TEXT("O O O C")));
+	TestEqual(TEXT("Opening reports the opened slots"), ChangedSlots, TArray<int32>({ 0, 1, 2 }));
+
+	// join sequence: sign-in takes the first open slot, the joined player replaces it
+	ChangedSlots.Reset();
+	TestTrue(TEXT("Controller 0 signs in"), Slots.BeginSignIn(0));
+	TestTrue(TEXT("Signing in again keeps the slot"), Slots.BeginSignIn(0));
+	TestEqual(TEXT("Signing in"), DescribeSlots(Slots), FString(TEXT("S0 O O C")));
+	Slots.PlayerJoined(0, FText::FromString(TEXT("Alice")));
+	TestEqual(TEXT("Joined"), DescribeSlots(Slots), FString(TEXT("J0 O O C")));
+	TestEqual(TEXT("Sign-in and join only touch slot 0"), ChangedSlots, TArray<int32>({ 0, 0 }));
+	TestFalse(TEXT("A joined controller can not sign in again"), Slots.BeginSignIn(0));
+
+	// a controller joining while another is still signing in goes before it
+	TestTrue(TEXT("Controller 2 signs in"), Slots.BeginSignIn(2));
+	TestTrue(TEXT("Controller 1 signs in"), Slots.BeginSignIn(1));
+	TestEqual(TEXT("Two signing in"), DescribeSlots(Slots), FString(TEXT("J0 S2 S1 C")));
+	TestFalse(TEXT("No slot left"), Slots.BeginSignIn(3));
+	TestEqual(TEXT("Full"), Slots.FindSlot(3), INDEX_NONE);
+
+	ChangedSlots.Reset();
+	Slots.PlayerJoined(1, FText::FromString(TEXT("Bob")));
+	TestEqual(TEXT("Joined player goes before the pending sign-in"), DescribeSlots(Slots), FString(TEXT("J0 J1 S2 C")));
+	TestEqual(TEXT("Join reorders slots 1 and 2"), ChangedSlots, TArray<int32>({ 1, 2 }));
+
+	// login failure sequence: the failed sign-in frees its slot, nothing else moves
+	ChangedSlots.Reset();
+	Slots.SignInFailed(2);
+	TestEqual(TEXT("Sign-in failed"), DescribeSlots(Slots), FString(TEXT("J0 J1 O C")));
+	TestEqual(TEXT("Failure only touches slot 2"), ChangedSlots, TArray<int32>({ 2 }));
+
+	ChangedSlots.Reset();
+	Slots.SignInFailed(2);
+	Slots.SignInFailed(0);
+	TestEqual(TEXT("Failures of unknown or joined controllers are ignored"), DescribeSlots(Slots), FString(TEXT("J0 J1 O C")));
+	TestEqual(TEXT("Ignored failures report nothing"), ChangedSlots.Num(), 0);
+
+	// failed sign-in in the middle, later ones move up
+	TestTrue(TEXT("Controller 3 signs in"), Slots.BeginSignIn(3));
+	Slots.SetNumSupportedSlots(4);
+	TestTrue(TEXT("Controller 2 signs in"), Slots.BeginSignIn(2));
+	TestEqual(TEXT("Two pending"), DescribeSlots(Slots), FString(TEXT("J0 J1 S3 S2")));
+	Slots.SignInFailed(3);
+	TestEqual(TEXT("Later sign-in moved up"), DescribeSlots(Slots), FString(TEXT("J0 J1 S2 O")));
+
+	// rename only touches the renamed slot
+	ChangedSlots.Reset();
+	Slots.PlayerRenamed(1, FText::FromString(TEXT("Robert")));
+	TestEqual(TEXT("Rename touches slot 1"), ChangedSlots, TArray<int32>({ 1 }));
+	TestTrue(TEXT("New name"), Slots.GetSlot(1).DisplayName.EqualTo(FText::FromString(TEXT("Robert"))));
+	ChangedSlots.Reset();
+	Slots.PlayerJoined(1, FText::FromString(TEXT("Robert")));
+	TestEqual(TEXT("Joining again with the same name reports nothing"), ChangedSlots.Num(), 0);
+
+	// leave sequence: the players after the one leaving move up
+	ChangedSlots.Reset();
+	Slots.PlayerLeft(0);
+	TestEqual(TEXT("Left"), DescribeSlots(Slots), FString(TEXT("J1 S2 O O")));
+	TestEqual(TEXT("Leaving moves up slots 0 to 2"), ChangedSlots, TArray<int32>({ 0, 1, 2 }));
+	Slots.PlayerLeft(2);
+	TestEqual(TEXT("A controller still signing in can not leave"), DescribeSlots(Slots), FString(TEXT("J1 S2 O O")));
+
+	// closing slots hides the players past the maximum
+	Slots.SetNumSupportedSlots(1);
+	TestEqual(TEXT("Closed down to one slot"), DescribeSlots(Slots), FString(TEXT("J1 C C C")));
+
+	ChangedSlots.Reset();
+	Slots.Reset();
+	TestEqual(TEXT("Reset"), DescribeSlots(Slots), FString(TEXT("O C C C")));
+	TestEqual(TEXT("Reset touches slot 0"), ChangedSlots, TArray<int32>({ 0 }));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Player/FightingVRTeamMaterialCache.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectIterator.h"
+#include "Tests/FightingVRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static int32 CountMaterialInstanceDynamics()
+{
+	int32 Count = 0;
+	for (TObjectIterator<UMaterialInstanceDynamic> It; It; ++It)
+	{
+		++Count;
+	}
+	return Count;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRTeamMaterialCacheTest, "FightingVR.Player.TeamMaterialCache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightingVRTeamMaterialCacheTest::RunTest(const FString& Parameters)
+{
+	// 64 pawns split over 2 teams, each with 3 material slots like the player mesh
+	const int32 NumPawns = 64;
+	const int32 NumTeams = 2;
+	const int32 NumSlots = 3;
+
+	FFightingVRScopedTestWorld World;
+
+	UFightingVRTeamMaterialCache* TeamMaterialCache = World->GetSubsystem<UFightingVRTeamMaterialCache>();
+	if (!TestNotNull(TEXT("Team material cache"), TeamMaterialCache))
+	{
+		return false;
+	}
+
+	TArray<UMaterialInterface*> BaseMaterials;
+	for (int32 SlotIdx = 0; SlotIdx < NumSlots; ++SlotIdx)
+	{
+		BaseMaterials.Add(UMaterialInstanceDynamic::Create(UMaterial::GetDefaultMaterial(MD_Surface), World.Get()));
+	}
+
+	const int32 NumMIDsBefore = CountMaterialInstanceDynamics();
+
+	TMap<TPair<int32, int32>, UMaterialInstanceDynamic*> FirstTeamMaterials;
+	for (int32 PawnIdx = 0; PawnIdx < NumPawns; ++PawnIdx)
+	{
+		const int32 TeamNum = PawnIdx % NumTeams;
+		for (int32 SlotIdx = 0; SlotIdx < NumSlots; ++SlotIdx)
+		{
+			UMaterialInstanceDynamic* TeamMaterial = TeamMaterialCache->GetTeamMaterial(BaseMaterials[SlotIdx], TeamNum);
+			UMaterialInstanceDynamic*& FirstTeamMaterial = FirstTeamMaterials.FindOrAdd(TPair<int32, int32>(SlotIdx, TeamNum), TeamMaterial);
+			TestTrue(TEXT("Pawns of a team share the instance of a slot"), TeamMaterial != nullptr && TeamMaterial == FirstTeamMaterial);
+		}
+	}
+
+	const int32 NumMIDsCreated = CountMaterialInstanceDynamics() - NumMIDsBefore;
+	AddInfo(FString::Printf(TEXT("%d pawns created %d material instances (%d without sharing)"), NumPawns, NumMIDsCreated, NumPawns * NumSlots));
+
+	TestEqual(TEXT("Team materials in the cache"), TeamMaterialCache->GetNumTeamMaterials(), NumSlots * NumTeams);
+	TestEqual(TEXT("Material instances created"), NumMIDsCreated, NumSlots * NumTeams);
+	TestNull(TEXT("No instance for a missing base material"), TeamMaterialCache->GetTeamMaterial(nullptr, 0));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerCorpseBudget.h"
+#include "FightingVR.h"
+#include "Online/FightingVRMode.h"
+#include "Player/FightingVRCharacter.h"
+#include "Player/FightingVRCorpseManager.h"
+
+/** Time between kills, long enough for the death animation to hand over to the ragdoll */
+static const float CorpseBudgetKillInterval = 0.5f;
+
+static int32 GetCorpseBudgetValue(const TCHAR* Name)
+{
+	IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(Name);
+	return CVar ? CVar->GetInt() : 0;
+}
+
+void UFightingVRTestControllerCorpseBudget::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch           = false;
+	NumKills           = 0;
+	PeakCorpses        = 0;
+	PeakActiveRagdolls = 0;
+	PeakFrameTime      = 0.0f;
+	TimeSinceLastKill  = 0.0f;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("TargetNumOfKills"), TargetNumOfKills))
+	{
+		TargetNumOfKills = 50;
+	}
+}
+
+void UFightingVRTestControllerCorpseBudget::OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
+{
+	Super::OnUserCanPlayOnline(UserId, Privilege, PrivilegeResults);
+
+	if (PrivilegeResults == (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures)
+	{
+		HostGame();
+	}
+}
+
+void UFightingVRTestControllerCorpseBudget::OnPostMapChange(UWorld* World)
+{
+	if (IsInGame())
+	{
+		bInMatch = true;
+	}
+}
+
+void UFightingVRTestControllerCorpseBudget::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (!bInMatch)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	AFightingVRMode* GameMode = World ? World->GetAuthGameMode<AFightingVRMode>() : nullptr;
+	UFightingVRCorpseManager* CorpseManager = World ? World->GetSubsystem<UFightingVRCorpseManager>() : nullptr;
+	ULocalPlayer* LocalPlayer = GetFirstLocalPlayer();
+	APlayerController* PlayerController = LocalPlayer ? LocalPlayer->PlayerController : nullptr;
+	if (GameMode == nullptr || CorpseManager == nullptr || PlayerController == nullptr)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  No authority game mode, corpse manager or local player controller in the match!"));
+		EndTest(-1);
+		return;
+	}
+
+	const int32 MaxCorpses = GetCorpseBudgetValue(TEXT("FightingVR.Corpses.MaxCorpses"));
+	const int32 MaxActiveRagdolls = GetCorpseBudgetValue(TEXT("FightingVR.Corpses.MaxActiveRagdolls"));
+
+	PeakCorpses = FMath::Max(PeakCorpses, CorpseManager->GetNumCorpses());
+	PeakActiveRagdolls = FMath::Max(PeakActiveRagdolls, CorpseManager->GetNumActiveRagdolls());
+	if (NumKills > 0)
+	{
+		PeakFrameTime = FMath::Max(PeakFrameTime, TimeDelta);
+	}
+
+	if (PeakCorpses > MaxCorpses || PeakActiveRagdolls > MaxActiveRagdolls)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Corpse budget exceeded, %d corpses (max %d), %d active ragdolls (max %d)!"), PeakCorpses, MaxCorpses, PeakActiveRagdolls, MaxActiveRagdolls);
+		FinishTest(false);
+		return;
+	}
+
+	TimeSinceLastKill += TimeDelta;
+
+	if (NumKills < TargetNumOfKills)
+	{
+		if (TimeSinceLastKill < CorpseBudgetKillInterval)
+		{
+			return;
+		}
+
+		if (AFightingVRCharacter* Pawn = Cast<AFightingVRCharacter>(PlayerController->GetPawn()))
+		{
+			Pawn->Suicide();
+			++NumKills;
+			TimeSinceLastKill = 0.0f;
+		}
+
+		GameMode->RestartPlayer(PlayerController);
+		return;
+	}
+
+	// all kills done, wait for the last ragdolls to settle
+	float SettleTime = 0.0f;
+	if (IConsoleVariable* SettleTimeCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("FightingVR.Corpses.SettleTime")))
+	{
+		SettleTime = SettleTimeCVar->GetFloat();
+	}
+
+	if (TimeSinceLastKill > SettleTime + CorpseBudgetKillInterval + 1.0f)
+	{
+		const int32 NumActiveRagdolls = CorpseManager->GetNumActiveRagdolls();
+		if (NumActiveRagdolls > 0)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  %d ragdolls still simulating %.1f secs after the last kill!"), NumActiveRagdolls, TimeSinceLastKill);
+		}
+		FinishTest(NumActiveRagdolls == 0);
+	}
+}
+
+void UFightingVRTestControllerCorpseBudget::FinishTest(bool bSuccess)
+{
+	UE_LOG(LogGauntlet, Display, TEXT("Corpse budget over %d kills: peak %d corpses, peak %d active ragdolls, worst frame %.2f ms"),
+		NumKills, PeakCorpses, PeakActiveRagdolls, PeakFrameTime * 1000.0f);
+
+	EndTest(bSuccess ? 0 : -1);
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerFrontEndLoad.h"
+#include "FightingVR.h"
+#include "FightingVRInstance.h"
+
+/** Time spent in a match before heading back to the front end, so the match world is fully up */
+static const float FrontEndLoadMatchTime = 5.0f;
+
+void UFightingVRTestControllerFrontEndLoad::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch              = false;
+	bLoadingFrontEnd      = false;
+	NumFrontEndLoads      = 0;
+	MatchStartTime        = 0.0;
+	FrontEndLoadStartTime = 0.0;
+	WorstFrameTime        = 0.0f;
+	TotalFrontEndLoadSecs = 0.0;
+	PeakFrontEndLoadSecs  = 0.0f;
+	PeakFrameTime         = 0.0f;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("TargetNumOfFrontEndLoads"), TargetNumOfFrontEndLoads))
+	{
+		TargetNumOfFrontEndLoads = 3;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MaxFrontEndLoadSecs"), MaxFrontEndLoadSecs))
+	{
+		MaxFrontEndLoadSecs = 60.0f;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MaxFrontEndFrameMs"), MaxFrontEndFrameMs))
+	{
+		MaxFrontEndFrameMs = 0.0f;
+	}
+}
+
+void UFightingVRTestControllerFrontEndLoad::OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
+{
+	Super::OnUserCanPlayOnline(UserId, Privilege, PrivilegeResults);
+
+	if (PrivilegeResults == (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures && NumFrontEndLoads == 0)
+	{
+		HostGame();
+	}
+}
+
+void UFightingVRTestControllerFrontEndLoad::OnPostMapChange(UWorld* World)
+{
+	if (IsInGame())
+	{
+		bInMatch = true;
+		MatchStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UFightingVRTestControllerFrontEndLoad::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	UFightingVRInstance* GameInstance = GetGameInstance();
+	if (GameInstance == nullptr)
+	{
+		return;
+	}
+
+	if (bLoadingFrontEnd)
+	{
+		WorstFrameTime = FMath::Max(WorstFrameTime, TimeDelta);
+
+		const float LoadSecs = FPlatformTime::Seconds() - FrontEndLoadStartTime;
+		if (LoadSecs > MaxFrontEndLoadSecs)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Front end load %d did not finish after %.0f secs!"), NumFrontEndLoads + 1, LoadSecs);
+			EndTest(-1);
+			return;
+		}
+
+		if (GetGameInstanceState() == FightingVRInstanceState::MainMenu && !GameInstance->IsFrontEndTransitionPending())
+		{
+			FinishFrontEndLoad();
+		}
+		return;
+	}
+
+	if (bInMatch && IsInGame() && FPlatformTime::Seconds() - MatchStartTime > FrontEndLoadMatchTime)
+	{
+		StartFrontEndLoad();
+	}
+	else if (!bInMatch && GetTimeInCurrentState() > 300)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+		EndTest(-1);
+	}
+}
+
+void UFightingVRTestControllerFrontEndLoad::StartFrontEndLoad()
+{
+	bInMatch = false;
+	bLoadingFrontEnd = true;
+	WorstFrameTime = 0.0f;
+	FrontEndLoadStartTime = FPlatformTime::Seconds();
+
+	GetGameInstance()->GotoState(FightingVRInstanceState::MainMenu);
+}
+
+void UFightingVRTestControllerFrontEndLoad::FinishFrontEndLoad()
+{
+	const float LoadSecs = FPlatformTime::Seconds() - FrontEndLoadStartTime;
+
+	bLoadingFrontEnd = false;
+	++NumFrontEndLoads;
+	TotalFrontEndLoadSecs += LoadSecs;
+	PeakFrontEndLoadSecs = FMath::Max(PeakFrontEndLoadSecs, LoadSecs);
+	PeakFrameTime = FMath::Max(PeakFrameTime, WorstFrameTime);
+
+	UE_LOG(LogGauntlet, Display, TEXT("Front end load %d: %.2f secs, worst frame %.2f ms"), NumFrontEndLoads, LoadSecs, WorstFrameTime * 1000.0f);
+
+	if (MaxFrontEndFrameMs > 0.0f && WorstFrameTime * 1000.0f > MaxFrontEndFrameMs)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Front end load %d hitched for %.2f ms, budget is %.2f ms!"), NumFrontEndLoads, WorstFrameTime * 1000.0f, MaxFrontEndFrameMs);
+		EndTest(-1);
+		return;
+	}
+
+	if (NumFrontEndLoads >= TargetNumOfFrontEndLoads)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Front end loads over %d transitions: avg %.2f secs, peak %.2f secs, worst frame %.2f ms"),
+			NumFrontEndLoads, TotalFrontEndLoadSecs / NumFrontEndLoads, PeakFrontEndLoadSecs, PeakFrameTime * 1000.0f);
+		EndTest(0);
+		return;
+	}
+
+	HostGame();
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerPickupReplication.h"
+#include "FightingVR.h"
+#include "Pickups/FightingVRPickup.h"
+#include "Pickups/FightingVRPickupRespawnScheduler.h"
+#include "Engine/NetConnection.h"
+#include "EngineUtils.h"
+
+/** Seconds left for the spawned pickups to replicate once before sampling starts */
+static const float PickupReplicationWarmupTime = 5.0f;
+
+/** Spacing of the cloned pickups around the ones placed in the level */
+static const float PickupCloneSpacing = 150.0f;
+
+void UFightingVRTestControllerPickupReplication::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch               = false;
+	bSpawnedPickups        = false;
+	TimeSinceSpawn         = 0.0f;
+	NumSamples             = 0;
+	TotalGameThreadMs      = 0.0;
+	TotalOutBytesPerSecond = 0.0;
+	PeakOutBytesPerSecond  = 0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("NumPickups"), NumPickups))
+	{
+		NumPickups = 200;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("SampleSeconds"), SampleSeconds))
+	{
+		SampleSeconds = 30.0f;
+	}
+}
+
+void UFightingVRTestControllerPickupReplication::OnPostMapChange(UWorld* World)
+{
+	if (IsInGame())
+	{
+		bInMatch = true;
+	}
+}
+
+bool UFightingVRTestControllerPickupReplication::SpawnPickups()
+{
+	UWorld* World = GetWorld();
+
+	TArray<AFightingVRPickup*> LevelPickups;
+	for (TActorIterator<AFightingVRPickup> It(World); It; ++It)
+	{
+		LevelPickups.Add(*It);
+	}
+
+	if (LevelPickups.Num() == 0)
+	{
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// rings of copies around each placed pickup, so they stay on walkable ground
+	for (int32 CloneIdx = 0; LevelPickups.Num() + CloneIdx < NumPickups; ++CloneIdx)
+	{
+		const AFightingVRPickup* Template = LevelPickups[CloneIdx % LevelPickups.Num()];
+		const int32 Ring = CloneIdx / LevelPickups.Num();
+		const FVector Offset = FRotator(0.0f, Ring * 45.0f, 0.0f).RotateVector(FVector((1 + Ring / 8) * PickupCloneSpacing, 0.0f, 0.0f));
+
+		World->SpawnActor<AFightingVRPickup>(Template->GetClass(), Template->GetActorLocation() + Offset, Template->GetActorRotation(), SpawnParams);
+	}
+
+	return true;
+}
+
+void UFightingVRTestControllerPickupReplication::OnTick(float TimeDelta)
+{
+	if (!bInMatch)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == nullptr || !NetDriver->IsServer())
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Pickup replication test needs to run on the server!"));
+		EndTest(-1);
+		return;
+	}
+
+	// nothing is replicated until a client is there to receive it
+	if (NetDriver->ClientConnections.Num() == 0)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  No client connected after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	if (!bSpawnedPickups)
+	{
+		if (!SpawnPickups())
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Level has no pickups to clone!"));
+			EndTest(-1);
+			return;
+		}
+		bSpawnedPickups = true;
+	}
+
+	TimeSinceSpawn += TimeDelta;
+	if (TimeSinceSpawn < PickupReplicationWarmupTime)
+	{
+		return;
+	}
+
+	TotalGameThreadMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	TotalOutBytesPerSecond += (double)NetDriver->OutBytesPerSecond / NetDriver->ClientConnections.Num();
+	PeakOutBytesPerSecond = FMath::Max(PeakOutBytesPerSecond, NetDriver->OutBytesPerSecond);
+	++NumSamples;
+
+	if (TimeSinceSpawn >= PickupReplicationWarmupTime + SampleSeconds)
+	{
+		int32 NumLivePickups = 0;
+		for (TActorIterator<AFightingVRPickup> It(GetWorld()); It; ++It)
+		{
+			++NumLivePickups;
+		}
+
+		const UFightingVRPickupRespawnScheduler* RespawnScheduler = GetWorld()->GetSubsystem<UFightingVRPickupRespawnScheduler>();
+		UE_LOG(LogGauntlet, Display, TEXT("Pickup replication with %d pickups and %d clients: avg %.0f bytes/s out per connection, peak %u bytes/s out, game thread avg %.2f ms, %d pending respawns"),
+			NumLivePickups, NetDriver->ClientConnections.Num(), TotalOutBytesPerSecond / NumSamples, PeakOutBytesPerSecond, TotalGameThreadMs / NumSamples,
+			RespawnScheduler ? RespawnScheduler->GetNumPendingRespawns() : 0);
+		EndTest(0);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerReconnectClient.h"
+#include "FightingVR.h"
+#include "FightingVREngine.h"
+
+void UFightingVRTestControllerReconnectClient::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch                      = false;
+	bLostConnection               = false;
+	bReconnected                  = false;
+	NumNetworkFailuresBeforeMatch = 0;
+	LostConnectionTime            = 0.0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MaxReconnectSecs"), MaxReconnectSecs))
+	{
+		MaxReconnectSecs = 120.0f;
+	}
+}
+
+void UFightingVRTestControllerReconnectClient::OnPostMapChange(UWorld* World)
+{
+	// only a map loaded after the connection was lost is the way back into the match
+	if (bLostConnection && IsConnectedToServer())
+	{
+		bReconnected = true;
+	}
+}
+
+int32 UFightingVRTestControllerReconnectClient::GetNumNetworkFailures() const
+{
+	TArray<FFightingVRNetworkFailureRecord> NetworkFailureHistory;
+	if (const UFightingVREngine* Engine = Cast<UFightingVREngine>(GEngine))
+	{
+		Engine->GetNetworkFailureHistory(NetworkFailureHistory);
+	}
+	return NetworkFailureHistory.Num();
+}
+
+bool UFightingVRTestControllerReconnectClient::IsConnectedToServer() const
+{
+	UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr;
+	return IsInGame() && NetDriver && NetDriver->ServerConnection && GetWorld()->GetNetMode() == NM_Client;
+}
+
+void UFightingVRTestControllerReconnectClient::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (!bInMatch)
+	{
+		if (IsConnectedToServer())
+		{
+			bInMatch = true;
+			NumNetworkFailuresBeforeMatch = GetNumNetworkFailures();
+			UE_LOG(LogGauntlet, Display, TEXT("Joined the server, waiting for the connection to be lost"));
+		}
+		else if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Did not join a server after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	if (!bLostConnection)
+	{
+		if (GetNumNetworkFailures() > NumNetworkFailuresBeforeMatch)
+		{
+			bLostConnection = true;
+			LostConnectionTime = FPlatformTime::Seconds();
+			UE_LOG(LogGauntlet, Display, TEXT("Lost the connection, waiting for the reconnect"));
+		}
+		else if (GetTimeInCurrentState() > 600)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  The connection was not lost after 600 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	const double ReconnectSecs = FPlatformTime::Seconds() - LostConnectionTime;
+	if (bReconnected)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Reconnected after %.1f secs and %d network failures"), ReconnectSecs, GetNumNetworkFailures() - NumNetworkFailuresBeforeMatch);
+		EndTest(0);
+	}
+	else if (GetGameInstanceState() == FightingVRInstanceState::MainMenu)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Fell back to the main menu instead of reconnecting!"));
+		EndTest(-1);
+	}
+	else if (ReconnectSecs > MaxReconnectSecs)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Did not reconnect within %.0f secs!"), MaxReconnectSecs);
+		EndTest(-1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerReconnectServer.h"
+#include "FightingVR.h"
+#include "Engine/NetConnection.h"
+
+/** Seconds a client has to stay after coming back for the reconnect to count */
+static const float ReconnectedClientHoldTime = 10.0f;
+
+void UFightingVRTestControllerReconnectServer::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch        = false;
+	bDroppedClients = false;
+	bKillServer     = FParse::Param(FCommandLine::Get(), TEXT("KillServer"));
+	PhaseTime       = 0.0f;
+	ReconnectedTime = 0.0f;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("KillServerAfter"), KillServerAfter))
+	{
+		KillServerAfter = 15.0f;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MaxReconnectSecs"), MaxReconnectSecs))
+	{
+		MaxReconnectSecs = 120.0f;
+	}
+}
+
+void UFightingVRTestControllerReconnectServer::OnPostMapChange(UWorld* World)
+{
+	if (IsInGame())
+	{
+		bInMatch = true;
+	}
+}
+
+int32 UFightingVRTestControllerReconnectServer::GetNumClients() const
+{
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	return NetDriver ? NetDriver->ClientConnections.Num() : 0;
+}
+
+void UFightingVRTestControllerReconnectServer::OnTick(float TimeDelta)
+{
+	if (!bInMatch)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	if (GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Reconnect test needs a dedicated server!"));
+		EndTest(-1);
+		return;
+	}
+
+	const int32 NumClients = GetNumClients();
+
+	if (!bDroppedClients)
+	{
+		if (NumClients == 0)
+		{
+			PhaseTime = 0.0f;
+			if (GetTimeInCurrentState() > 300)
+			{
+				UE_LOG(LogGauntlet, Error, TEXT("Failed!  No client joined after 300 secs!"));
+				EndTest(-1);
+			}
+			return;
+		}
+
+		PhaseTime += TimeDelta;
+		if (PhaseTime < KillServerAfter)
+		{
+			return;
+		}
+
+		if (bKillServer)
+		{
+			UE_LOG(LogGauntlet, Display, TEXT("Killing the server with %d clients"), NumClients);
+			FPlatformMisc::RequestExit(true);
+			return;
+		}
+
+		UE_LOG(LogGauntlet, Display, TEXT("Dropping %d clients"), NumClients);
+		TArray<UNetConnection*> ClientConnections = GetWorld()->GetNetDriver()->ClientConnections;
+		for (UNetConnection* Connection : ClientConnections)
+		{
+			Connection->Close();
+		}
+
+		bDroppedClients = true;
+		PhaseTime = 0.0f;
+		return;
+	}
+
+	if (NumClients == 0)
+	{
+		ReconnectedTime = 0.0f;
+
+		PhaseTime += TimeDelta;
+		if (PhaseTime > MaxReconnectSecs)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  No client reconnected within %.0f secs!"), MaxReconnectSecs);
+			EndTest(-1);
+		}
+		return;
+	}
+
+	// a client back for the hold time is past the travel and the session join
+	ReconnectedTime += TimeDelta;
+	if (ReconnectedTime >= ReconnectedClientHoldTime)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("%d clients reconnected after %.1f secs"), NumClients, PhaseTime);
+		EndTest(0);
+	}
+}
\ No newline at end of file
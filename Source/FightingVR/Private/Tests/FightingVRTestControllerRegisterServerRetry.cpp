@@ -0,0 +1,221 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerRegisterServerRetry.h"
+#include "FightingVR.h"
+#include "OnlineSubsystemUtils.h"
+
+void UFightingVRTestControllerRegisterServerRetry::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch           = false;
+	bInjected          = false;
+	bRegistering       = false;
+	NumCycles          = 0;
+	NumCreateFailures  = 0;
+	NumCreateSuccesses = 0;
+	NumDestroys        = 0;
+	NumBroadcasts      = 0;
+	NumEarlyRetries    = 0;
+	CycleStartTime     = 0.0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("NumInjectedFailures"), NumInjectedFailures))
+	{
+		NumInjectedFailures = 3;
+	}
+}
+
+void UFightingVRTestControllerRegisterServerRetry::OnPostMapChange(UWorld* World)
+{
+	if (!IsInGame() || bInMatch)
+	{
+		return;
+	}
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	AFightingVRSession* GameSession = GetGameSession();
+	if (Sessions.IsValid() && GameSession)
+	{
+		bInMatch = true;
+
+		OnCreateSessionCompleteDelegateHandle = Sessions->AddOnCreateSessionCompleteDelegate_Handle(FOnCreateSessionCompleteDelegate::CreateUObject(this, &UFightingVRTestControllerRegisterServerRetry::OnCreateSessionComplete));
+		OnDestroySessionCompleteDelegateHandle = Sessions->AddOnDestroySessionCompleteDelegate_Handle(FOnDestroySessionCompleteDelegate::CreateUObject(this, &UFightingVRTestControllerRegisterServerRetry::OnDestroySessionComplete));
+		OnRegisterServerBroadcastDelegateHandle = GameSession->OnCreatePresenceSessionComplete().AddUObject(this, &UFightingVRTestControllerRegisterServerRetry::OnRegisterServerBroadcast);
+	}
+}
+
+void UFightingVRTestControllerRegisterServerRetry::OnCreateSessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (!bRegistering || SessionName != NAME_GameSession)
+	{
+		return;
+	}
+
+	// every attempt after a failure has to wait for the failed session to be destroyed
+	if (NumCreateFailures > NumDestroys)
+	{
+		++NumEarlyRetries;
+	}
+
+	if (bWasSuccessful)
+	{
+		++NumCreateSuccesses;
+	}
+	else
+	{
+		++NumCreateFailures;
+	}
+}
+
+void UFightingVRTestControllerRegisterServerRetry::OnDestroySessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (bRegistering && SessionName == NAME_GameSession)
+	{
+		++NumDestroys;
+	}
+}
+
+void UFightingVRTestControllerRegisterServerRetry::OnRegisterServerBroadcast(FName SessionName, bool bWasSuccessful)
+{
+	if (bRegistering && SessionName == NAME_GameSession)
+	{
+		++NumBroadcasts;
+	}
+}
+
+void UFightingVRTestControllerRegisterServerRetry::InjectFailure()
+{
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+
+	Sessions->DestroySession(NAME_GameSession);
+
+	FOnlineSessionSettings BlockingSettings;
+	BlockingSettings.NumPublicConnections = 1;
+	BlockingSettings.bIsDedicated = true;
+	BlockingSettings.bIsLANMatch = true;
+	Sessions->CreateSession(0, NAME_GameSession, BlockingSettings);
+
+	bInjected = true;
+}
+
+void UFightingVRTestControllerRegisterServerRetry::CheckCycle()
+{
+	UE_LOG(LogGauntlet, Display, TEXT("Register server cycle %d: %d failed and %d successful creates, %d destroys, %d broadcasts in %.1f secs"),
+		NumCycles + 1, NumCreateFailures, NumCreateSuccesses, NumDestroys, NumBroadcasts, FPlatformTime::Seconds() - CycleStartTime);
+
+	if (NumCreateFailures != 1 || NumCreateSuccesses != 1)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Expected one failed and one successful create, got %d and %d!"), NumCreateFailures, NumCreateSuccesses);
+		FinishTest(-1);
+		return;
+	}
+
+	if (NumDestroys != 1)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  The failed create was cleaned up %d times!"), NumDestroys);
+		FinishTest(-1);
+		return;
+	}
+
+	if (NumEarlyRetries > 0)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  %d retries were made before the failed session was destroyed!"), NumEarlyRetries);
+		FinishTest(-1);
+		return;
+	}
+
+	if (NumBroadcasts != 1)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  The registration was broadcast %d times!"), NumBroadcasts);
+		FinishTest(-1);
+		return;
+	}
+
+	++NumCycles;
+	bRegistering = false;
+	bInjected = false;
+}
+
+void UFightingVRTestControllerRegisterServerRetry::FinishTest(int32 ExitCode)
+{
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (Sessions.IsValid())
+	{
+		Sessions->ClearOnCreateSessionCompleteDelegate_Handle(OnCreateSessionCompleteDelegateHandle);
+		Sessions->ClearOnDestroySessionCompleteDelegate_Handle(OnDestroySessionCompleteDelegateHandle);
+	}
+
+	if (AFightingVRSession* GameSession = GetGameSession())
+	{
+		GameSession->OnCreatePresenceSessionComplete().Remove(OnRegisterServerBroadcastDelegateHandle);
+	}
+
+	EndTest(ExitCode);
+}
+
+void UFightingVRTestControllerRegisterServerRetry::OnTick(float TimeDelta)
+{
+	if (!bInMatch)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	if (GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Register server retry test needs a dedicated server!"));
+		FinishTest(-1);
+		return;
+	}
+
+	if (bRegistering)
+	{
+		if (NumCreateSuccesses > 0)
+		{
+			CheckCycle();
+		}
+		else if (FPlatformTime::Seconds() - CycleStartTime > 120.0)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Server did not register again within 120 secs (%d failed creates)!"), NumCreateFailures);
+			FinishTest(-1);
+		}
+		return;
+	}
+
+	if (NumCycles >= NumInjectedFailures)
+	{
+		UE_LOG(LogGauntlet, Display, TEXT("Register server retry test passed after %d injected failures"), NumCycles);
+		FinishTest(0);
+		return;
+	}
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (!bInjected)
+	{
+		// the server registers itself when the match starts
+		if (Sessions->GetNamedSession(NAME_GameSession))
+		{
+			InjectFailure();
+		}
+		else if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Server did not register after 300 secs!"));
+			FinishTest(-1);
+		}
+		return;
+	}
+
+	// a tick after the injection, so its own session events are not counted
+	NumCreateFailures  = 0;
+	NumCreateSuccesses = 0;
+	NumDestroys        = 0;
+	NumBroadcasts      = 0;
+	NumEarlyRetries    = 0;
+	CycleStartTime     = FPlatformTime::Seconds();
+	bRegistering       = true;
+
+	static_cast<AGameSession*>(GetGameSession())->RegisterServer();
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerReplayProfiles.h"
+#include "FightingVR.h"
+#include "FightingVRInstance.h"
+#include "Bots/FightingVRAIController.h"
+
+/** Time given to the replay streamer to finish writing the last demo file before the sizes are read */
+static const float ReplayFileCloseDelay = 5.0f;
+
+/** Demo file the local file replay streamer writes for ReplayName */
+static FString GetReplayProfileDemoFilename(const FString& ReplayName)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Demos"), ReplayName + TEXT(".replay"));
+}
+
+void UFightingVRTestControllerReplayProfiles::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch             = false;
+	PhaseIndex           = 0;
+	SampledTime          = 0.0f;
+	NumSamples           = 0;
+	TotalGameThreadMs    = 0.0;
+	PeakGameThreadMs     = 0.0;
+	BaselineGameThreadMs = 0.0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MinBots"), MinBots))
+	{
+		MinBots = 8;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("RecordSeconds"), RecordSeconds))
+	{
+		RecordSeconds = 60.0f;
+	}
+}
+
+void UFightingVRTestControllerReplayProfiles::OnPostMapChange(UWorld* World)
+{
+	if (IsInGame())
+	{
+		bInMatch = true;
+	}
+}
+
+int32 UFightingVRTestControllerReplayProfiles::GetNumBotPawns() const
+{
+	int32 NumBotPawns = 0;
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		const AFightingVRAIController* BotController = Cast<AFightingVRAIController>(It->Get());
+		if (BotController && BotController->GetPawn())
+		{
+			++NumBotPawns;
+		}
+	}
+	return NumBotPawns;
+}
+
+void UFightingVRTestControllerReplayProfiles::OnTick(float TimeDelta)
+{
+	if (!bInMatch)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Replay profile test needs to run on the server!"));
+		EndTest(-1);
+		return;
+	}
+
+	UFightingVRInstance* GameInstance = Cast<UFightingVRInstance>(GetGameInstance());
+	if (GameInstance == nullptr)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  No FightingVR game instance!"));
+		EndTest(-1);
+		return;
+	}
+
+	if (PhaseIndex == 0 && NumSamples == 0 && GetNumBotPawns() < MinBots)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Only %d of %d bots spawned after 300 secs!"), GetNumBotPawns(), MinBots);
+			EndTest(-1);
+		}
+		return;
+	}
+
+	// all profiles recorded, log the demo file sizes once the last one is closed
+	if (PhaseIndex > GameInstance->GetReplayProfiles().Num())
+	{
+		SampledTime += TimeDelta;
+		if (SampledTime < ReplayFileCloseDelay)
+		{
+			return;
+		}
+
+		bool bAllReplaysWritten = true;
+		for (int32 ReplayIndex = 0; ReplayIndex < RecordedReplayNames.Num(); ++ReplayIndex)
+		{
+			const FString DemoFilename = GetReplayProfileDemoFilename(RecordedReplayNames[ReplayIndex]);
+			const int64 DemoFileSize = IFileManager::Get().FileSize(*DemoFilename);
+			if (DemoFileSize <= 0)
+			{
+				UE_LOG(LogGauntlet, Error, TEXT("Replay profile %s wrote no demo file to %s"), *RecordedProfileNames[ReplayIndex].ToString(), *DemoFilename);
+				bAllReplaysWritten = false;
+				continue;
+			}
+
+			UE_LOG(LogGauntlet, Display, TEXT("Replay profile %s: %.1f KB over %.0f secs (%.1f KB/min)"),
+				*RecordedProfileNames[ReplayIndex].ToString(), DemoFileSize / 1024.0, RecordSeconds, DemoFileSize / 1024.0 * 60.0 / RecordSeconds);
+		}
+
+		EndTest(bAllReplaysWritten ? 0 : -1);
+		return;
+	}
+
+	const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	TotalGameThreadMs += GameThreadMs;
+	PeakGameThreadMs = FMath::Max(PeakGameThreadMs, GameThreadMs);
+	++NumSamples;
+
+	SampledTime += TimeDelta;
+	if (SampledTime >= RecordSeconds)
+	{
+		EndPhase();
+	}
+}
+
+void UFightingVRTestControllerReplayProfiles::EndPhase()
+{
+	UFightingVRInstance* GameInstance = CastChecked<UFightingVRInstance>(GetGameInstance());
+	const TArray<FFightingVRReplayProfile>& ReplayProfiles = GameInstance->GetReplayProfiles();
+	const double AverageGameThreadMs = TotalGameThreadMs / FMath::Max(NumSamples, 1);
+
+	if (PhaseIndex == 0)
+	{
+		BaselineGameThreadMs = AverageGameThreadMs;
+		UE_LOG(LogGauntlet, Display, TEXT("Not recording with %d bots: game thread avg %.2f ms, peak %.2f ms over %d frames"),
+			GetNumBotPawns(), AverageGameThreadMs, PeakGameThreadMs, NumSamples);
+	}
+	else
+	{
+		GameInstance->StopRecordingReplay();
+		UE_LOG(LogGauntlet, Display, TEXT("Replay profile %s with %d bots: game thread avg %.2f ms (%+.2f ms), peak %.2f ms over %d frames"),
+			*RecordedProfileNames.Last().ToString(), GetNumBotPawns(), AverageGameThreadMs, AverageGameThreadMs - BaselineGameThreadMs, PeakGameThreadMs, NumSamples);
+	}
+
+	++PhaseIndex;
+	SampledTime       = 0.0f;
+	NumSamples        = 0;
+	TotalGameThreadMs = 0.0;
+	PeakGameThreadMs  = 0.0;
+
+	if (ReplayProfiles.IsValidIndex(PhaseIndex - 1))
+	{
+		const FName ProfileName = ReplayProfiles[PhaseIndex - 1].ProfileName;
+		const FString ReplayName = FString::Printf(TEXT("ReplayProfileTest_%s"), *ProfileName.ToString());
+
+		// don't measure a file left over from an earlier run
+		IFileManager::Get().Delete(*GetReplayProfileDemoFilename(ReplayName));
+
+		TArray<FString> RecordingOptions;
+		RecordingOptions.Add(FString::Printf(TEXT("ReplayProfile=%s"), *ProfileName.ToString()));
+		GameInstance->StartRecordingReplay(ReplayName, ReplayName, RecordingOptions);
+
+		RecordedReplayNames.Add(ReplayName);
+		RecordedProfileNames.Add(ProfileName);
+	}
+}
\ No newline at end of file
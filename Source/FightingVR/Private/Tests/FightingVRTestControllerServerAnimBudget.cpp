@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerServerAnimBudget.h"
+#include "FightingVR.h"
+#include "Bots/FightingVRAIController.h"
+
+void UFightingVRTestControllerServerAnimBudget::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch          = false;
+	SampledTime       = 0.0f;
+	NumSamples        = 0;
+	TotalGameThreadMs = 0.0;
+	PeakGameThreadMs  = 0.0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("MinBots"), MinBots))
+	{
+		MinBots = 32;
+	}
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("SampleSeconds"), SampleSeconds))
+	{
+		SampleSeconds = 60.0f;
+	}
+}
+
+void UFightingVRTestControllerServerAnimBudget::OnPostMapChange(UWorld* World)
+{
+	if (IsInGame())
+	{
+		bInMatch = true;
+	}
+}
+
+int32 UFightingVRTestControllerServerAnimBudget::GetNumBotPawns() const
+{
+	int32 NumBotPawns = 0;
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		const AFightingVRAIController* BotController = Cast<AFightingVRAIController>(It->Get());
+		if (BotController && BotController->GetPawn())
+		{
+			++NumBotPawns;
+		}
+	}
+	return NumBotPawns;
+}
+
+void UFightingVRTestControllerServerAnimBudget::OnTick(float TimeDelta)
+{
+	if (!bInMatch)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	if (GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Server anim budget test needs a dedicated server!"));
+		EndTest(-1);
+		return;
+	}
+
+	if (NumSamples == 0 && GetNumBotPawns() < MinBots)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Only %d of %d bots spawned after 300 secs!"), GetNumBotPawns(), MinBots);
+			EndTest(-1);
+		}
+		return;
+	}
+
+	const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	TotalGameThreadMs += GameThreadMs;
+	PeakGameThreadMs = FMath::Max(PeakGameThreadMs, GameThreadMs);
+	++NumSamples;
+
+	SampledTime += TimeDelta;
+	if (SampledTime >= SampleSeconds)
+	{
+		IConsoleVariable* AnimBudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("FightingVR.ServerAnimBudget"));
+		UE_LOG(LogGauntlet, Display, TEXT("Server anim budget %d with %d bots: game thread avg %.2f ms, peak %.2f ms over %d frames"),
+			AnimBudgetCVar ? AnimBudgetCVar->GetInt() : 0, GetNumBotPawns(), TotalGameThreadMs / NumSamples, PeakGameThreadMs, NumSamples);
+		EndTest(0);
+	}
+}
\ No newline at end of file
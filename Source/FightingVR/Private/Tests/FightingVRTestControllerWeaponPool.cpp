@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVRTestControllerWeaponPool.h"
+#include "FightingVR.h"
+#include "Online/FightingVRMode.h"
+#include "Player/FightingVRCharacter.h"
+#include "Weapons/FightingVRWeapon.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/NetConnection.h"
+#include "EngineUtils.h"
+
+void UFightingVRTestControllerWeaponPool::OnInit()
+{
+	Super::OnInit();
+
+	bInMatch                   = false;
+	bWaitingForRespawn         = false;
+	NumRespawns                = 0;
+	NumWeaponSpawns            = 0;
+	NumWeaponSpawnsAfterWarmup = 0;
+	NumWeaponDestroys          = 0;
+	NumWeaponChannelOpens      = 0;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("TargetNumOfRespawns"), TargetNumOfRespawns))
+	{
+		TargetNumOfRespawns = 100;
+	}
+}
+
+void UFightingVRTestControllerWeaponPool::OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
+{
+	Super::OnUserCanPlayOnline(UserId, Privilege, PrivilegeResults);
+
+	if (PrivilegeResults == (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures)
+	{
+		HostGame();
+	}
+}
+
+void UFightingVRTestControllerWeaponPool::OnPostMapChange(UWorld* World)
+{
+	if (!IsInGame() || bInMatch)
+	{
+		return;
+	}
+
+	bInMatch = true;
+	ActorSpawnedDelegateHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UFightingVRTestControllerWeaponPool::OnActorSpawned));
+
+	// weapons of the pawn that is already spawned count as the warm up
+	for (TActorIterator<AFightingVRWeapon> It(World); It; ++It)
+	{
+		OnActorSpawned(*It);
+	}
+}
+
+void UFightingVRTestControllerWeaponPool::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (!bInMatch)
+	{
+		if (GetTimeInCurrentState() > 300)
+		{
+			UE_LOG(LogGauntlet, Error, TEXT("Failed!  Match did not start after 300 secs!"));
+			EndTest(-1);
+		}
+		return;
+	}
+
+	AFightingVRMode* GameMode = GetWorld() ? GetWorld()->GetAuthGameMode<AFightingVRMode>() : nullptr;
+	ULocalPlayer* LocalPlayer = GetFirstLocalPlayer();
+	APlayerController* PlayerController = LocalPlayer ? LocalPlayer->PlayerController : nullptr;
+	if (GameMode == nullptr || PlayerController == nullptr)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  No authority game mode or local player controller in the match!"));
+		EndTest(-1);
+		return;
+	}
+
+	CountWeaponChannelOpens();
+
+	// one step per tick, so parked weapons go dormant and channels update between a death and the respawn
+	if (bWaitingForRespawn)
+	{
+		bWaitingForRespawn = false;
+		GameMode->RestartPlayer(PlayerController);
+
+		if (++NumRespawns >= TargetNumOfRespawns)
+		{
+			FinishTest();
+		}
+	}
+	else if (AFightingVRCharacter* Pawn = Cast<AFightingVRCharacter>(PlayerController->GetPawn()))
+	{
+		Pawn->Suicide();
+		bWaitingForRespawn = true;
+	}
+}
+
+void UFightingVRTestControllerWeaponPool::OnActorSpawned(AActor* Actor)
+{
+	if (AFightingVRWeapon* Weapon = Cast<AFightingVRWeapon>(Actor))
+	{
+		++NumWeaponSpawns;
+		if (NumRespawns > 0)
+		{
+			++NumWeaponSpawnsAfterWarmup;
+		}
+
+		Weapon->OnDestroyed.AddDynamic(this, &UFightingVRTestControllerWeaponPool::OnWeaponDestroyed);
+	}
+}
+
+void UFightingVRTestControllerWeaponPool::OnWeaponDestroyed(AActor* DestroyedActor)
+{
+	++NumWeaponDestroys;
+}
+
+void UFightingVRTestControllerWeaponPool::CountWeaponChannelOpens()
+{
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == nullptr)
+	{
+		return;
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		TSet<TWeakObjectPtr<AFightingVRWeapon>>& PreviousChannels = WeaponChannels.FindOrAdd(Connection);
+		TSet<TWeakObjectPtr<AFightingVRWeapon>> CurrentChannels;
+
+		for (const auto& ActorChannel : Connection->ActorChannelMap())
+		{
+			if (AFightingVRWeapon* Weapon = Cast<AFightingVRWeapon>(ActorChannel.Key))
+			{
+				CurrentChannels.Add(Weapon);
+				if (!PreviousChannels.Contains(Weapon))
+				{
+					++NumWeaponChannelOpens;
+				}
+			}
+		}
+
+		PreviousChannels = MoveTemp(CurrentChannels);
+	}
+}
+
+void UFightingVRTestControllerWeaponPool::FinishTest()
+{
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedDelegateHandle);
+
+	UE_LOG(LogGauntlet, Display, TEXT("Weapon pool over %d respawns: %d weapon spawns (%d after the first respawn), %d destroys, %d weapon channel opens on %d connections"),
+		NumRespawns, NumWeaponSpawns, NumWeaponSpawnsAfterWarmup, NumWeaponDestroys, NumWeaponChannelOpens, WeaponChannels.Num());
+
+	if (NumWeaponSpawnsAfterWarmup > 0 || NumWeaponDestroys > 0)
+	{
+		UE_LOG(LogGauntlet, Error, TEXT("Failed!  Respawns still spawn or destroy weapon actors with the pool warm!"));
+		EndTest(-1);
+		return;
+	}
+
+	EndTest(0);
+}
\ No newline at end of file
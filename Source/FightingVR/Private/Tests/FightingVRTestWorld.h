@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/World.h"
+
+/** Transient game world for automation tests, with its world subsystems initialized. Destroyed when it goes out of scope. */
+struct FFightingVRScopedTestWorld
+{
+	FFightingVRScopedTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("FightingVRTestWorld"));
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FFightingVRScopedTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	UWorld* operator->() const { return World; }
+	UWorld* Get() const { return World; }
+
+private:
+	UWorld* World;
+};
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#include "FightingVR.h"
+#include "Vivox/VivoxHUD.h"
+#include "Online/FightingVRPlayerState.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/FightingVRTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Team roster as DrawVivoxRoster used to build it on every frame, with the comparator it had */
+static void BuildRosterPerFrame(AFightingVRState* MyGameState, AFightingVRPlayerState* MyPlayerState, TArray<AFightingVRPlayerState*>& TeamArray)
+{
+	const int32 TeamIndex = MyPlayerState->GetTeamNum();
+	const FString LocalNickname = MyPlayerState->GetShortPlayerName();
+
+	TeamArray.Reset();
+	for (int32 i = 0; i < MyGameState->PlayerArray.Num(); ++i)
+	{
+		AFightingVRPlayerState* CurPlayerState = Cast<AFightingVRPlayerState>(MyGameState->PlayerArray[i]);
+		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		{
+			TeamArray.Add(CurPlayerState);
+		}
+	}
+
+	TeamArray.Sort([&LocalNickname](const AFightingVRPlayerState& One, const AFightingVRPlayerState& Two) {
+		if (One.GetShortPlayerName().Equals(LocalNickname))
+			return true;
+		else if ((One.IsABot() && Two.IsABot()) || (!One.IsABot() && !Two.IsABot()))
+			return One.GetPlayerName().Compare(Two.GetPlayerName(), ESearchCase::IgnoreCase) < 0;
+		else
+			return (bool)Two.IsABot();
+	});
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightingVRVivoxRosterBenchmark, "FightingVR.Vivox.RosterBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FFightingVRVivoxRosterBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumFrames = 10000;
+
+	// a roster event (join, leave, team change or rename) every this many frames
+	const int32 FramesPerRosterEvent = 600;
+
+	for (const int32 NumPlayers : { 16, 64 })
+	{
+		FFightingVRScopedTestWorld World;
+
+		AFightingVRState* GameState = World->SpawnActor<AFightingVRState>();
+		World->SetGameState(GameState);
+
+		AVivoxHUD* HUD = World->SpawnActor<AVivoxHUD>();
+
+		// two teams, half of each team bots, names out of order
+		TArray<AFightingVRPlayerState*> PlayerStates;
+		for (int32 PlayerIdx = 0; PlayerIdx < NumPlayers; ++PlayerIdx)
+		{
+			AFightingVRPlayerState* PlayerState = World->SpawnActor<AFightingVRPlayerState>();
+			PlayerState->SetPlayerName(FString::Printf(TEXT("Player%02d"), (PlayerIdx * 7) % NumPlayers));
+			PlayerState->SetIsABot(PlayerIdx % 4 >= 2);
+			PlayerState->SetTeamNum(PlayerIdx % 2);
+			PlayerStates.Add(PlayerState);
+		}
+
+		if (!TestEqual(TEXT("Player states registered with the game state"), GameState->PlayerArray.Num(), NumPlayers))
+		{
+			return false;
+		}
+
+		AFightingVRPlayerState* MyPlayerState = PlayerStates[0];
+
+		// the cached roster draws in the same order as the per frame one
+		TArray<AFightingVRPlayerState*> TeamArray;
+		BuildRosterPerFrame(GameState, MyPlayerState, TeamArray);
+		HUD->RebuildRoster(GameState, MyPlayerState);
+
+		TestEqual(TEXT("Roster size"), HUD->Roster.Num(), TeamArray.Num());
+		for (int32 EntryIdx = 0; EntryIdx < FMath::Min(HUD->Roster.Num(), TeamArray.Num()); ++EntryIdx)
+		{
+			if (HUD->Roster[EntryIdx].PlayerState.Get() != TeamArray[EntryIdx])
+			{
+				AddError(FString::Printf(TEXT("%d players: roster entry %d is %s, expected %s"), NumPlayers, EntryIdx,
+					*HUD->Roster[EntryIdx].SortName, *TeamArray[EntryIdx]->GetPlayerName()));
+				break;
+			}
+		}
+
+		// a rename is a roster event
+		HUD->bRosterDirty = false;
+		MyPlayerState->OnRep_PlayerName();
+		TestTrue(TEXT("Rename marks the roster dirty"), HUD->bRosterDirty);
+
+		// per frame: what each draw pays before drawing, the sum keeps the work from being optimized away
+		int64 Checksum = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			BuildRosterPerFrame(GameState, MyPlayerState, TeamArray);
+			for (const AFightingVRPlayerState* PlayerState : TeamArray)
+			{
+				Checksum += PlayerState->GetUniqueId().ToString().Len() + PlayerState->GetShortPlayerName().Len();
+			}
+		}
+		const double PerFrameUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / NumFrames;
+
+		int32 NumRebuilds = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			if (Frame % FramesPerRosterEvent == 0)
+			{
+				HUD->OnRosterChanged(MyPlayerState);
+			}
+
+			if (HUD->bRosterDirty || HUD->RosterOwner != MyPlayerState)
+			{
+				HUD->RebuildRoster(GameState, MyPlayerState);
+				++NumRebuilds;
+			}
+
+			for (const AVivoxHUD::FVivoxRosterEntry& Entry : HUD->Roster)
+			{
+				Checksum += Entry.ParticipantId.Len() + Entry.DisplayName.ToString().Len();
+			}
+		}
+		const double CachedUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / NumFrames;
+
+		AddInfo(FString::Printf(TEXT("%d players, %d frames: rebuilt every frame %.2f us/frame, cached %.2f us/frame with %d rebuilds (checksum %lld)"),
+			NumPlayers, NumFrames, PerFrameUs, CachedUs, NumRebuilds, Checksum));
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
\ No newline at end of file
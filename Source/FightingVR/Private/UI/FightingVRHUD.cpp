@@ -25,6 +25,8 @@ AFightingVRHUD::AFightingVRHUD(const FObjectInitializer& ObjectInitializer) : Su
 	NoAmmoNotifyTime = -NoAmmoFadeOutTime;
 	LastKillTime = - KillFadeOutTime;
 	LastEnemyHitTime = -LastEnemyHitDisplayTime;
+	KilledText = LOCTEXT("killed"," killed ");
+	KilledTextSize = FVector2D::ZeroVector;
 
 	/*OnPlayerTalkingStateChangedDelegate = FOnPlayerTalkingStateChangedDelegate::CreateUObject(this, &AFightingVRHUD::OnPlayerTalkingStateChanged);
 
@@ -763,9 +765,6 @@ void AFightingVRHUD::DrawDeathMessages()
 	const FColor RedTeamColor = FColor(152, 70, 70, 255);
 	const FColor OwnerColor = HUDLight;
 
-	const FString KilledText = LOCTEXT("killed"," killed ").ToString();
-	FVector2D KilledTextSize(0.0f, 0.0f);
-
 	const float GameTime = GetWorld()->GetTimeSeconds();
 	const float LinePadding = 6.0f;
 	const float BoxPadding = 2.0f;
@@ -776,25 +775,33 @@ void AFightingVRHUD::DrawDeathMessages()
 	// draw messages
 	float CurrentY = InitialY;
 
-	Canvas->StrLen(NormalFont, KilledText, KilledTextSize.X, KilledTextSize.Y);
+	// text sizes only depend on the font, so they are measured once and cached
+	if (KilledTextSize.IsZero())
+	{
+		Canvas->StrLen(NormalFont, KilledText.ToString(), KilledTextSize.X, KilledTextSize.Y);
+	}
 
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 	for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
 	{
-		const FDeathMessage& Message = DeathMessages[i];
+		FDeathMessage& Message = DeathMessages[i];
+		if (!Message.bTextSizeCached)
+		{
+			Canvas->StrLen(NormalFont, Message.KillerDesc, Message.KillerTextSize.X, Message.KillerTextSize.Y);
+			Canvas->StrLen(NormalFont, Message.VictimDesc, Message.VictimTextSize.X, Message.VictimTextSize.Y);
+			Message.bTextSizeCached = true;
+		}
+
 		float CurrentX = InitialX;
-		FVector2D KillerSize(0.0f, 0.0f);
-		FVector2D VictimNameSize(0.0f, 0.0f);
 		float TextScale = 1.00f;
-		Canvas->StrLen(NormalFont, Message.KillerDesc, KillerSize.X, KillerSize.Y);
 		TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.SetColor(Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
 
-		TextItem.Text = FText::FromString( Message.KillerDesc );
+		TextItem.Text = Message.KillerText;
 		Canvas->DrawItem(TextItem, CurrentX, CurrentY);
-		CurrentX += KillerSize.X * TextScale * ScaleUI;
+		CurrentX += Message.KillerTextSize.X * TextScale * ScaleUI;
 		
 		if (Message.DamageType.IsValid())
 		{
@@ -807,7 +814,7 @@ void AFightingVRHUD::DrawDeathMessages()
 		}
 		else
 		{
-			TextItem.Text = FText::FromString( KilledText );
+			TextItem.Text = KilledText;
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDDark);
@@ -818,8 +825,7 @@ void AFightingVRHUD::DrawDeathMessages()
 			
 		TextItem.SetColor(Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));		
 
-		Canvas->StrLen(NormalFont, Message.VictimDesc, VictimNameSize.X, VictimNameSize.Y);
-		TextItem.Text = FText::FromString( Message.VictimDesc );
+		TextItem.Text = Message.VictimText;
 		Canvas->DrawItem( TextItem, CurrentX, CurrentY );
 		CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
 	}
@@ -845,6 +851,8 @@ void AFightingVRHUD::ShowDeathMessage(class AFightingVRPlayerState* KillerPlayer
 			FDeathMessage NewMessage;
 			NewMessage.KillerDesc = KillerPlayerState->GetShortPlayerName();
 			NewMessage.VictimDesc = VictimPlayerState->GetShortPlayerName();
+			NewMessage.KillerText = FText::FromString(NewMessage.KillerDesc);
+			NewMessage.VictimText = FText::FromString(NewMessage.VictimDesc);
 			NewMessage.KillerTeamNum = KillerPlayerState->GetTeamNum();
 			NewMessage.VictimTeamNum = VictimPlayerState->GetTeamNum();
 			NewMessage.bKillerIsOwner = MyPlayerState == KillerPlayerState;
@@ -857,7 +865,7 @@ void AFightingVRHUD::ShowDeathMessage(class AFightingVRPlayerState* KillerPlayer
 			if (KillerPlayerState == MyPlayerState && VictimPlayerState != MyPlayerState)
 			{
 				LastKillTime = GetWorld()->GetTimeSeconds();
-				CenteredKillMessage = FText::FromString(NewMessage.VictimDesc);
+				CenteredKillMessage = NewMessage.VictimText;
 			}
 		}
 	}
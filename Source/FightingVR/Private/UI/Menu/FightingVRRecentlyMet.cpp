@@ -8,10 +8,16 @@
 #include "FightingVRUserSettings.h"
 #include "FightingVRPersistentUser.h"
 #include "Player/FightingVRLocalPlayer.h"
+#include "Online/FightingVRPlayerState.h"
 #include "OnlineSubsystemUtils.h"
 
 #define LOCTEXT_NAMESPACE "FightingVR.HUD.Menu"
 
+FFightingVRRecentlyMet::~FFightingVRRecentlyMet()
+{
+	AFightingVRPlayerState::NotifyRosterChanged.Remove(OnRosterChangedDelegateHandle);
+}
+
 void FFightingVRRecentlyMet::Construct(ULocalPlayer* _PlayerOwner, int32 LocalUserNum_)
 {
 	RecentlyMetStyle = &FFightingVRStyle::Get().GetWidgetStyle<FFightingVROptionsStyle>("DefaultFightingVROptionsStyle");
@@ -25,13 +31,26 @@ void FFightingVRRecentlyMet::Construct(ULocalPlayer* _PlayerOwner, int32 LocalUs
 	/** Recently Met menu items */
 	RecentlyMetRoot = FFightingVRMenuItem::CreateRoot();
 	RecentlyMetItem = MenuHelper::AddMenuItem(RecentlyMetRoot, LOCTEXT("Recently Met", "RECENTLY MET"));
+	CloseItem = MenuHelper::AddMenuItemSP(RecentlyMetItem, LOCTEXT("Close", "CLOSE"), this, &FFightingVRRecentlyMet::OnApplySettings);
 
 	/** Init online items */
 	if (PlayerOwner)
 	{
 		OnlineSub = Online::GetSubsystem(PlayerOwner->GetWorld());
+
+		// players already in the match joined before we started listening
+		const AGameStateBase* const GameState = PlayerOwner->GetWorld() ? PlayerOwner->GetWorld()->GetGameState() : nullptr;
+		if (GameState)
+		{
+			for (const APlayerState* PlayerState : GameState->PlayerArray)
+			{
+				RememberPlayer(PlayerState);
+			}
+		}
 	}
 
+	OnRosterChangedDelegateHandle = AFightingVRPlayerState::NotifyRosterChanged.AddSP(this, &FFightingVRRecentlyMet::OnRosterChanged);
+
 	UserSettings = CastChecked<UFightingVRUserSettings>(GEngine->GetGameUserSettings());	
 }
 
@@ -70,49 +89,98 @@ UFightingVRPersistentUser* FFightingVRRecentlyMet::GetPersistentUser() const
 	return SLP ? SLP->GetPersistentUser() : nullptr;
 }
 
-void FFightingVRRecentlyMet::UpdateRecentlyMet(int32 NewOwnerIndex)
+void FFightingVRRecentlyMet::OnRosterChanged(AFightingVRPlayerState* PlayerState)
 {
-	LocalUserNum = NewOwnerIndex;
-	
-	if (OnlineSub)
+	RememberPlayer(PlayerState);
+}
+
+void FFightingVRRecentlyMet::RememberPlayer(const APlayerState* PlayerState)
+{
+	if (PlayerState == nullptr || PlayerOwner == nullptr || PlayerState->GetWorld() != PlayerOwner->GetWorld())
 	{
-		IOnlineIdentityPtr Identity = OnlineSub->GetIdentityInterface();
-		if (Identity.IsValid())
+		return;
+	}
+
+	if (PlayerState->IsABot() || !PlayerState->GetUniqueId().IsValid())
+	{
+		return;
+	}
+
+	// never list ourselves or a split-screen player sharing this machine
+	const APlayerController* const PC = Cast<APlayerController>(PlayerState->GetOwner());
+	if ((PC && PC->IsLocalController()) || PlayerState->GetUniqueId() == PlayerOwner->GetPreferredUniqueNetId())
+	{
+		return;
+	}
+
+	UFightingVRPersistentUser* const PersistentUser = GetPersistentUser();
+	if (PersistentUser)
+	{
+		// later roster events of a player already met in this match (like a rename) must not move them to the front again
+		const FString UniqueId = PlayerState->GetUniqueId().ToString();
+		bool bAlreadyMet = false;
+		MetThisMatchIds.Add(UniqueId, &bAlreadyMet);
+
+		if (bAlreadyMet)
+		{
+			PersistentUser->RenameRecentlyMetPlayer(UniqueId, PlayerState->GetPlayerName());
+		}
+		else
 		{
-			LocalUsername = Identity->GetPlayerNickname(LocalUserNum);
+			PersistentUser->AddRecentlyMetPlayer(UniqueId, PlayerState->GetPlayerName());
 		}
 	}
-	
-	MenuHelper::ClearSubMenu(RecentlyMetItem);
-	MaxRecentlyMetIndex = 0;
+}
+
+void FFightingVRRecentlyMet::UpdateRecentlyMet(int32 NewOwnerIndex)
+{
+	LocalUserNum = NewOwnerIndex;
 
-	AFightingVRState* const MyGameState = PlayerOwner->GetWorld()->GetGameState<AFightingVRState>();
-	if (MyGameState != nullptr)
+	static const TArray<FFightingVRRecentlyMetPlayer> NoPlayers;
+	const UFightingVRPersistentUser* const PersistentUser = GetPersistentUser();
+	const TArray<FFightingVRRecentlyMetPlayer>& MetPlayers = PersistentUser ? PersistentUser->GetRecentlyMetPlayers() : NoPlayers;
+
+	// reuse the items of players that are still listed so only new and renamed players touch their widgets
+	TMap<FString, TSharedPtr<FFightingVRMenuItem>> ExistingItems;
+	ExistingItems.Reserve(MetPlayerIds.Num());
+	for (int32 i = 0; i < MetPlayerIds.Num() && RecentlyMetItem->SubMenu.IsValidIndex(i); ++i)
+	{
+		ExistingItems.Add(MetPlayerIds[i], RecentlyMetItem->SubMenu[i]);
+	}
+
+	TArray<TSharedPtr<FFightingVRMenuItem>> NewSubMenu;
+	NewSubMenu.Reserve(MetPlayers.Num() + 1);
+	MetPlayerIds.Reset(MetPlayers.Num());
+
+	for (const FFightingVRRecentlyMetPlayer& MetPlayer : MetPlayers)
 	{
-		MetPlayerArray = MyGameState->PlayerArray;
+		const FText Username = FText::FromString(MetPlayer.PlayerName);
 
-		for (int32 i = 0; i < MetPlayerArray.Num(); ++i)
+		TSharedPtr<FFightingVRMenuItem> UserItem;
+		if (ExistingItems.RemoveAndCopyValue(MetPlayer.UniqueId, UserItem))
 		{
-			const APlayerState* PlayerState = MetPlayerArray[i];
-			FString Username = PlayerState->GetHumanReadableName();
-			if (Username != LocalUsername && PlayerState->IsABot() == false)
+			if (!UserItem->GetText().EqualTo(Username))
 			{
-				TSharedPtr<FFightingVRMenuItem> UserItem = MenuHelper::AddMenuItem(RecentlyMetItem, FText::FromString(Username));
-				UserItem->OnControllerDownInputPressed.BindRaw(this, &FFightingVRRecentlyMet::IncrementRecentlyMetCounter);
-				UserItem->OnControllerUpInputPressed.BindRaw(this, &FFightingVRRecentlyMet::DecrementRecentlyMetCounter);
-				UserItem->OnControllerFacebuttonDownPressed.BindRaw(this, &FFightingVRRecentlyMet::ViewSelectedUsersProfile);
-			}
-			else
-			{
-				MetPlayerArray.RemoveAt(i);
-				--i; //we just deleted an item, so we need to go make sure i doesn't increment again, otherwise it would skip the player that was supposed to be looked at next
+				UserItem->SetText(Username);
 			}
 		}
+		else
+		{
+			UserItem = MakeShareable(new FFightingVRMenuItem(Username));
+			UserItem->OnControllerDownInputPressed.BindRaw(this, &FFightingVRRecentlyMet::IncrementRecentlyMetCounter);
+			UserItem->OnControllerUpInputPressed.BindRaw(this, &FFightingVRRecentlyMet::DecrementRecentlyMetCounter);
+			UserItem->OnControllerFacebuttonDownPressed.BindRaw(this, &FFightingVRRecentlyMet::ViewSelectedUsersProfile);
+		}
 
-		MaxRecentlyMetIndex = MetPlayerArray.Num() - 1;
+		NewSubMenu.Add(UserItem);
+		MetPlayerIds.Add(MetPlayer.UniqueId);
 	}
 
-	MenuHelper::AddMenuItemSP(RecentlyMetItem, LOCTEXT("Close", "CLOSE"), this, &FFightingVRRecentlyMet::OnApplySettings);
+	NewSubMenu.Add(CloseItem);
+	RecentlyMetItem->SubMenu = MoveTemp(NewSubMenu);
+
+	MaxRecentlyMetIndex = MetPlayerIds.Num() - 1;
+	CurrRecentlyMetIndex = FMath::Clamp(CurrRecentlyMetIndex, MinRecentlyMetIndex, FMath::Max(MaxRecentlyMetIndex, MinRecentlyMetIndex));
 }
 
 void FFightingVRRecentlyMet::IncrementRecentlyMetCounter()
@@ -134,12 +202,10 @@ void FFightingVRRecentlyMet::ViewSelectedUsersProfile()
 	if (OnlineSub)
 	{
 		IOnlineIdentityPtr Identity = OnlineSub->GetIdentityInterface();
-		if (Identity.IsValid() && MetPlayerArray.IsValidIndex(CurrRecentlyMetIndex))
+		if (Identity.IsValid() && MetPlayerIds.IsValidIndex(CurrRecentlyMetIndex))
 		{
-			const APlayerState* PlayerState = MetPlayerArray[CurrRecentlyMetIndex];
-		
 			TSharedPtr<const FUniqueNetId> Requestor = Identity->GetUniquePlayerId(LocalUserNum);
-			TSharedPtr<const FUniqueNetId> Requestee = PlayerState->GetUniqueId().GetUniqueNetId();
+			TSharedPtr<const FUniqueNetId> Requestee = Identity->CreateUniquePlayerId(MetPlayerIds[CurrRecentlyMetIndex]);
 			
 			IOnlineExternalUIPtr ExternalUI = OnlineSub->GetExternalUIInterface();
 			if (ExternalUI.IsValid() && Requestor.IsValid() && Requestee.IsValid())
@@ -7,6 +7,7 @@
 
 class UFightingVRUserSettings;
 class UFightingVRPersistentUser;
+class AFightingVRPlayerState;
 
 /** delegate called when changes are applied */
 DECLARE_DELEGATE(FOnApplyChanges);
@@ -26,10 +27,12 @@ DECLARE_DELEGATE(FOnOnControllerFacebuttonDownPressed);
 class FFightingVRRecentlyMet : public TSharedFromThis<FFightingVRRecentlyMet>
 {
 public:
+	~FFightingVRRecentlyMet();
+
 	/** sets owning player controller */
 	void Construct(ULocalPlayer* _PlayerOwner, int32 LocalUserNum);
 
-	/** get current Friends values for display */
+	/** refreshes the menu from the persisted recently met list, only touching items that changed */
 	void UpdateRecentlyMet(int32 NewOwnerIndex);
 
 	/** UI callback for applying settings, plays sound */
@@ -76,13 +79,27 @@ public:
 	int32 MinRecentlyMetIndex;
 	int32 MaxRecentlyMetIndex;
 
-	FString LocalUsername;
-
-	TArray<class APlayerState*> MetPlayerArray;
+	/** unique ids of the listed players, in the same order as the items of RecentlyMetItem */
+	TArray<FString> MetPlayerIds;
 
 	IOnlineSubsystem* OnlineSub;
 
 protected:
+	/** remembers players as they join or change name */
+	void OnRosterChanged(AFightingVRPlayerState* PlayerState);
+
+	/** adds a player to the persisted recently met list, skipping bots and players on this machine */
+	void RememberPlayer(const APlayerState* PlayerState);
+
+	/** unique ids of the players already remembered in this match */
+	TSet<FString> MetThisMatchIds;
+
+	/** handle of the roster changed binding */
+	FDelegateHandle OnRosterChangedDelegateHandle;
+
+	/** trailing item closing the sub-menu, kept across updates */
+	TSharedPtr<FFightingVRMenuItem> CloseItem;
+
 	/** User settings pointer */
 	UFightingVRUserSettings* UserSettings;
 
@@ -8,15 +8,83 @@
 #include "FightingVRInstance.h"
 #include "NetworkReplayStreaming.h"
 #include "FightingVRViewportClient.h"
+#include "Online/FightingVRReplayIndex.h"
+#include "Online/FightingVRReplayEvents.h"
+#include "Algo/BinarySearch.h"
 
 #define LOCTEXT_NAMESPACE "FightingVR.HUD.Menu"
 
+/** number of enumerated streams merged into the list per tick */
+static const int32 DemoListPageSize = 64;
+
 struct FDemoEntry
 {
 	FNetworkReplayStreamInfo StreamInfo;
-	FString		Date;
-	FString		Size;
-	int32		ResultsIndex;
+
+	/** display texts, formatted the first time the row is shown */
+	FText		NameText;
+	FText		ViewersText;
+	FText		DateText;
+	FText		LengthText;
+	FText		SizeText;
+	bool		bFormatted;
+
+	/** cleared before merging enumeration results, entries not found again are removed */
+	bool		bSeen;
+
+	FDemoEntry(const FNetworkReplayStreamInfo& InStreamInfo)
+		: StreamInfo(InStreamInfo)
+		, bFormatted(false)
+		, bSeen(true)
+	{
+	}
+
+	void UpdateStreamInfo(const FNetworkReplayStreamInfo& InStreamInfo)
+	{
+		StreamInfo = InStreamInfo;
+		bFormatted = false;
+	}
+
+	void FormatIfNeeded()
+	{
+		if (bFormatted)
+		{
+			return;
+		}
+		bFormatted = true;
+
+		FString NameString = StreamInfo.FriendlyName.IsEmpty() ? StreamInfo.Name : StreamInfo.FriendlyName;
+
+		const int MAX_DEMO_NAME_DISPLAY_LEN = 18;
+		if ( NameString.Len() > MAX_DEMO_NAME_DISPLAY_LEN )
+		{
+			NameString = NameString.Left( MAX_DEMO_NAME_DISPLAY_LEN ) + TEXT( "..." );
+		}
+
+		if (StreamInfo.bIsLive)
+		{
+			NameString += " (Live)";
+		}
+
+		const float SizeInKilobytes = StreamInfo.SizeInBytes / 1024.0f;
+		const int32 Minutes = StreamInfo.LengthInMS / ( 1000 * 60 );
+		const int32 Seconds = ( StreamInfo.LengthInMS / 1000 ) % 60;
+
+		NameText	= FText::FromString( NameString );
+		ViewersText	= FText::FromString( FString::Printf( TEXT( "%i" ), StreamInfo.NumViewers ) );
+		DateText	= FText::FromString( StreamInfo.Timestamp.ToString( TEXT( "%m/%d/%Y %h:%M %A" ) ) );	// UTC time
+		LengthText	= FText::FromString( FString::Printf( TEXT( "%02i:%02i" ), Minutes, Seconds ) );
+		SizeText	= FText::FromString( SizeInKilobytes >= 1024.0f ? FString::Printf( TEXT("%2.2f MB" ), SizeInKilobytes / 1024.0f ) : FString::Printf( TEXT("%i KB" ), (int)SizeInKilobytes ) );
+	}
+};
+
+/** Sorts demo entries by date, newest first */
+struct FCompareDemoEntryDate
+{
+	FORCEINLINE bool operator()( const TSharedPtr<FDemoEntry> & A, const TSharedPtr<FDemoEntry> & B ) const
+	{
+		return A->StreamInfo.Timestamp.GetTicks() > B->StreamInfo.Timestamp.GetTicks();
+	}
 };
 
 void SFightingVRDemoList::Construct(const FArguments& InArgs)
@@ -25,6 +93,8 @@ void SFightingVRDemoList::Construct(const FArguments& InArgs)
 	OwnerWidget			= InArgs._OwnerWidget;
 	bUpdatingDemoList	= false;
 	StatusText			= FText::GetEmpty();
+	PendingStreamIndex	= 0;
+	EnumerateRequestId	= 0;
 	
 	EnumerateStreamsVersion = FNetworkVersion::GetReplayVersion();
 
@@ -92,46 +162,96 @@ void SFightingVRDemoList::Construct(const FArguments& InArgs)
 
 	ReplayStreamer = FNetworkReplayStreaming::Get().GetFactory().CreateReplayStreamer();
 
-	BuildDemoList();
+	BuildDemoList(true);
 }
 
-void SFightingVRDemoList::OnEnumerateStreamsComplete(const FEnumerateStreamsResult& Result )
+void SFightingVRDemoList::OnEnumerateStreamsComplete(const FEnumerateStreamsResult& Result, uint32 RequestId)
 {
+	if (RequestId != EnumerateRequestId)
+	{
+		// superseded by a newer request, e.g. the version checkbox was toggled
+		return;
+	}
+
 	check(bUpdatingDemoList); // should not be called otherwise
 
-	bool bFinished = true;
+	if (!Result.WasSuccessful())
+	{
+		// keep showing the cached list
+		OnBuildDemoListFinished();
+		return;
+	}
+
+	for (const TSharedPtr<FDemoEntry>& DemoEntry : DemoList)
+	{
+		DemoEntry->bSeen = false;
+	}
+
+	// merged a page per tick, so hundreds of replays don't stall the menu
+	PendingStreams = Result.FoundStreams;
+	PendingStreamIndex = 0;
+	MergeNextPendingStreams();
+}
+
+void SFightingVRDemoList::MergeNextPendingStreams()
+{
+	const int32 EndIndex = FMath::Min(PendingStreamIndex + DemoListPageSize, PendingStreams.Num());
 
-	for ( const auto& StreamInfo : Result.FoundStreams )
+	for (; PendingStreamIndex < EndIndex; ++PendingStreamIndex)
 	{
-		float SizeInKilobytes = StreamInfo.SizeInBytes / 1024.0f;
+		const FNetworkReplayStreamInfo& StreamInfo = PendingStreams[PendingStreamIndex];
+
+		TSharedPtr<FDemoEntry>* ExistingEntry = DemoEntriesByName.Find(StreamInfo.Name);
+		if (ExistingEntry && FFightingVRReplayIndex::IsSameStream((*ExistingEntry)->StreamInfo, StreamInfo))
+		{
+			(*ExistingEntry)->UpdateStreamInfo(StreamInfo);
+			(*ExistingEntry)->bSeen = true;
+			continue;
+		}
+
+		if (ExistingEntry)
+		{
+			// same name recorded again
+			DemoList.Remove(*ExistingEntry);
+		}
+
+		TSharedPtr<FDemoEntry> NewDemoEntry = MakeShareable( new FDemoEntry( StreamInfo ) );
 
-		TSharedPtr<FDemoEntry> NewDemoEntry = MakeShareable( new FDemoEntry() );
+		// keep the list sorted by date without sorting it again
+		const int32 InsertIndex = Algo::LowerBound( DemoList, NewDemoEntry, FCompareDemoEntryDate() );
+		DemoList.Insert( NewDemoEntry, InsertIndex );
+		DemoEntriesByName.Add( StreamInfo.Name, NewDemoEntry );
+	}
 
-		NewDemoEntry->StreamInfo	= StreamInfo;
-		NewDemoEntry->Date			= StreamInfo.Timestamp.ToString( TEXT( "%m/%d/%Y %h:%M %A" ) );	// UTC time
-		NewDemoEntry->Size			= SizeInKilobytes >= 1024.0f ? FString::Printf( TEXT("%2.2f MB" ), SizeInKilobytes / 1024.0f ) : FString::Printf( TEXT("%i KB" ), (int)SizeInKilobytes );
+	DemoListWidget->RequestListRefresh();
 
-		DemoList.Add( NewDemoEntry );
+	if (PendingStreamIndex < PendingStreams.Num())
+	{
+		return;
 	}
 
-	// Sort demo names by date
-	struct FCompareDateTime
+	// drop streams that no longer exist
+	for (int32 i = DemoList.Num() - 1; i >= 0; --i)
 	{
-		FORCEINLINE bool operator()( const TSharedPtr<FDemoEntry> & A, const TSharedPtr<FDemoEntry> & B ) const
+		if (!DemoList[i]->bSeen)
 		{
-			return A->StreamInfo.Timestamp.GetTicks() > B->StreamInfo.Timestamp.GetTicks();
+			DemoEntriesByName.Remove(DemoList[i]->StreamInfo.Name);
+			DemoList.RemoveAt(i, 1, false);
 		}
-	};
+	}
 
-	Sort( DemoList.GetData(), DemoList.Num(), FCompareDateTime() );
+	TArray<FNetworkReplayStreamInfo> FoundStreams;
+	FoundStreams.Reserve(DemoList.Num());
+	for (const TSharedPtr<FDemoEntry>& DemoEntry : DemoList)
+	{
+		FoundStreams.Add(DemoEntry->StreamInfo);
+	}
+	FFightingVRReplayIndex::Get().SetStreams(EnumerateStreamsVersion, MoveTemp(FoundStreams));
 
-	//StatusText = "";
-	StatusText = LOCTEXT("DemoSelectionInfo","Press ENTER to Play. Press DEL to delete.");
+	PendingStreams.Reset();
+	PendingStreamIndex = 0;
 
-	if ( bFinished )
-	{		
-		OnBuildDemoListFinished();
-	}
+	OnBuildDemoListFinished();
 }
 
 FText SFightingVRDemoList::GetBottomText() const
@@ -149,6 +269,11 @@ FText SFightingVRDemoList::GetBottomText() const
 void SFightingVRDemoList::Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime )
 {
 	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (PendingStreams.Num() > 0)
+	{
+		MergeNextPendingStreams();
+	}
 }
 
 ECheckBoxState SFightingVRDemoList::IsShowAllReplaysChecked() const
@@ -173,18 +298,40 @@ void SFightingVRDemoList::OnShowAllReplaysChecked(ECheckBoxState NewCheckedState
 		EnumerateStreamsVersion.NetworkVersion = 0;
 	}
 
-	BuildDemoList();
+	BuildDemoList(true);
 }
 
 /** Populates the demo list */
-void SFightingVRDemoList::BuildDemoList()
+void SFightingVRDemoList::BuildDemoList(bool bShowCachedStreams)
 {
-	bUpdatingDemoList = true;
-	DemoList.Empty();
+	if (bShowCachedStreams)
+	{
+		// show what was found last time straight away, the enumeration below refreshes it
+		DemoList.Reset();
+		DemoEntriesByName.Reset();
+
+		for (const FNetworkReplayStreamInfo& StreamInfo : FFightingVRReplayIndex::Get().GetStreams(EnumerateStreamsVersion))
+		{
+			TSharedPtr<FDemoEntry> NewDemoEntry = MakeShareable( new FDemoEntry( StreamInfo ) );
+			DemoList.Add( NewDemoEntry );
+			DemoEntriesByName.Add( StreamInfo.Name, NewDemoEntry );
+		}
+
+		if (DemoList.Num() > 0)
+		{
+			StatusText = LOCTEXT("DemoSelectionInfo","Press ENTER to Play. Press DEL to delete.");
+		}
+
+		DemoListWidget->RequestListRefresh();
+	}
+
+	PendingStreams.Reset();
+	PendingStreamIndex = 0;
 
 	if ( ReplayStreamer.IsValid() )
 	{
-		ReplayStreamer->EnumerateStreams(EnumerateStreamsVersion, INDEX_NONE, FString(), TArray<FString>(), FEnumerateStreamsCallback::CreateSP(this, &SFightingVRDemoList::OnEnumerateStreamsComplete));
+		bUpdatingDemoList = true;
+		ReplayStreamer->EnumerateStreams(EnumerateStreamsVersion, INDEX_NONE, FString(), TArray<FString>(), FEnumerateStreamsCallback::CreateSP(this, &SFightingVRDemoList::OnEnumerateStreamsComplete, ++EnumerateRequestId));
 	}
 }
 
@@ -192,6 +339,7 @@ void SFightingVRDemoList::BuildDemoList()
 void SFightingVRDemoList::OnBuildDemoListFinished()
 {
 	bUpdatingDemoList = false;
+	StatusText = LOCTEXT("DemoSelectionInfo","Press ENTER to Play. Press DEL to delete.");
 
 	int32 SelectedItemIndex = DemoList.IndexOfByKey(SelectedItem);
 
@@ -205,12 +353,7 @@ void SFightingVRDemoList::OnBuildDemoListFinished()
 
 void SFightingVRDemoList::PlayDemo()
 {
-	if (bUpdatingDemoList)
-	{
-		// We're still building the list
-		return;
-	}
-
+	// cached entries can be played while the list refreshes in the background
 	if (SelectedItem.IsValid())
 	{
 		UFightingVRInstance* const GI = Cast<UFightingVRInstance>(PlayerOwner->GetGameInstance());
@@ -262,7 +405,18 @@ FReply SFightingVRDemoList::OnDemoDeleteConfirm()
 	if (SelectedItem.IsValid() && ReplayStreamer.IsValid())
 	{
 		bUpdatingDemoList = true;
-		DemoList.Empty();
+
+		// an enumeration still being merged may list the stream, drop it, the list is enumerated again once the delete is done
+		PendingStreams.Reset();
+		PendingStreamIndex = 0;
+		++EnumerateRequestId;
+
+		// remove the entry right away instead of waiting for the list to be enumerated again
+		FFightingVRReplayIndex::Get().RemoveStream(SelectedItem->StreamInfo.Name);
+		UFightingVRReplayEventRecorder::DeleteEvents(SelectedItem->StreamInfo.Name);
+		DemoEntriesByName.Remove(SelectedItem->StreamInfo.Name);
+		DemoList.Remove(SelectedItem);
+		DemoListWidget->RequestListRefresh();
 
 		ReplayStreamer->DeleteFinishedStream(SelectedItem->StreamInfo.Name, FDeleteFinishedStreamCallback::CreateSP(this, &SFightingVRDemoList::OnDeleteFinishedStreamComplete));
 	}
@@ -341,7 +495,7 @@ void SFightingVRDemoList::MoveSelection(int32 MoveBy)
 
 FReply SFightingVRDemoList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyboardEvent) 
 {
-	if (bUpdatingDemoList) // lock input
+	if (bUpdatingDemoList && DemoList.Num() == 0) // lock input until there is something to select
 	{
 		return FReply::Handled();
 	}
@@ -364,7 +518,10 @@ FReply SFightingVRDemoList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEve
 	else if (Key == EKeys::SpaceBar || Key == EKeys::Gamepad_FaceButton_Left)
 	{
 		// Refresh demo list
-		BuildDemoList();
+		if (!bUpdatingDemoList)
+		{
+			BuildDemoList();
+		}
 	}
 	else if (Key == EKeys::Up || Key == EKeys::Gamepad_DPad_Up || Key == EKeys::Gamepad_LeftStick_Up)
 	{
@@ -395,49 +552,40 @@ TSharedRef<ITableRow> SFightingVRDemoList::MakeListViewWidget(TSharedPtr<FDemoEn
 
 		TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName)
 		{
-			FText ItemText = FText::GetEmpty();
+			return SNew(STextBlock)
+				.Text(this, &SDemoEntryWidget::GetColumnText, ColumnName)
+				.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuServerListTextStyle");
+		}
+
+		/** texts are bound rather than copied, so entries updated by a background refresh show their new values */
+		FText GetColumnText(FName ColumnName) const
+		{
+			Item->FormatIfNeeded();
 
 			if (ColumnName == "DemoName")
 			{
-				FString NameString = Item->StreamInfo.FriendlyName.IsEmpty() ? Item->StreamInfo.Name : Item->StreamInfo.FriendlyName;
-
-				const int MAX_DEMO_NAME_DISPLAY_LEN = 18;
-				if ( NameString.Len() > MAX_DEMO_NAME_DISPLAY_LEN )
-				{
-					NameString = NameString.Left( MAX_DEMO_NAME_DISPLAY_LEN ) + TEXT( "..." );
-				}
-
-				if (Item->StreamInfo.bIsLive)
-				{
-					NameString += " (Live)";
-				}
-
-				ItemText = FText::FromString(NameString);
+				return Item->NameText;
 			}
 			else if (ColumnName == "Viewers")
 			{
-				ItemText = FText::FromString( FString::Printf( TEXT( "%i" ), Item->StreamInfo.NumViewers ) );
+				return Item->ViewersText;
 			}
 			else if (ColumnName == "Date")
 			{
-				ItemText = FText::FromString(Item->Date);
+				return Item->DateText;
 			}
 			else if (ColumnName == "Length")
 			{
-				const int32 Minutes = Item->StreamInfo.LengthInMS / ( 1000 * 60 );
-				const int32 Seconds = ( Item->StreamInfo.LengthInMS / 1000 ) % 60;
-
-				ItemText = FText::FromString( FString::Printf( TEXT( "%02i:%02i" ), Minutes, Seconds ) );
+				return Item->LengthText;
 			}
 			else if (ColumnName == "Size")
 			{
-				ItemText = FText::FromString(Item->Size);
+				return Item->SizeText;
 			}
 
-			return SNew(STextBlock)
-				.Text(ItemText)
-				.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuServerListTextStyle");
+			return FText::GetEmpty();
 		}
+
 		TSharedPtr<FDemoEntry> Item;
 	};
 	return SNew(SDemoEntryWidget, OwnerTable, Item);
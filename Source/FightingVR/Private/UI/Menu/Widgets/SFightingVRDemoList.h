@@ -50,14 +50,21 @@ public:
 	/** Updates the list until it's completely populated */
 	void UpdateBuildDemoListStatus();
 
-	/** Populates the demo list */
-	void BuildDemoList();
+	/**
+	 * Populates the demo list, refreshing it from the replay streamer in the background.
+	 *
+	 * @param	bShowCachedStreams	Replace the list with the streams cached in the replay index first.
+	 */
+	void BuildDemoList(bool bShowCachedStreams = false);
 
 	/** Called when demo list building finished */
 	void OnBuildDemoListFinished();
 
 	/** Called when we get results from the replay streaming interface */
-	void OnEnumerateStreamsComplete(const FEnumerateStreamsResult& Result);
+	void OnEnumerateStreamsComplete(const FEnumerateStreamsResult& Result, uint32 RequestId);
+
+	/** Merges the next page of enumerated streams into the list */
+	void MergeNextPendingStreams();
 
 	/** Play chosen demo */
 	void PlayDemo();
@@ -101,9 +108,21 @@ protected:
 	/** Whether we're building the demo list or not */
 	bool bUpdatingDemoList;
 
-	/** action bindings array */
+	/** action bindings array, newest demo first */
 	TArray< TSharedPtr<FDemoEntry> > DemoList;
 
+	/** entries of DemoList by stream name, used to merge enumeration results */
+	TMap< FString, TSharedPtr<FDemoEntry> > DemoEntriesByName;
+
+	/** enumerated streams still to be merged into DemoList */
+	TArray<FNetworkReplayStreamInfo> PendingStreams;
+
+	/** next entry of PendingStreams to merge */
+	int32 PendingStreamIndex;
+
+	/** id of the latest enumeration request, results of older requests are ignored */
+	uint32 EnumerateRequestId;
+
 	/** action bindings list slate widget */
 	TSharedPtr< SListView< TSharedPtr<FDemoEntry> > > DemoListWidget; 
 
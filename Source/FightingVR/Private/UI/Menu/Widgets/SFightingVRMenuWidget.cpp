@@ -12,6 +12,7 @@
 #include "Player/FightingVRLocalPlayer.h"
 #include "FightingVRUserSettings.h"
 #include "Slate/SceneViewport.h"
+#include "Widgets/SInvalidationPanel.h"
 
 #define LOCTEXT_NAMESPACE "SFightingVRMenuWidget"
 
@@ -43,158 +44,164 @@ void SFightingVRMenuWidget::Construct(const FArguments& InArgs)
 	const FSlateFontInfo ProfileSwapFontInfo = FFightingVRStyle::Get().GetWidgetStyle<FTextBlockStyle>("FightingVR.MenuServerListTextStyle").Font;
 	MenuProfileWidth = FMath::Max( FontMeasure->Measure( PlayerName, PlayerNameFontInfo, 1.0f ).X, FontMeasure->Measure( ProfileSwap.ToString(), ProfileSwapFontInfo, 1.0f ).X ) + 32.0f;
 
+	// The menu is static most of the time, so its draw elements are cached and only the widgets
+	// changed by UpdateAnimatedWidgets (or volatile ones, like the pulsing item backgrounds) repaint.
+	// Animated values start hidden and are pushed on the first tick, once the animations are set up.
 	ChildSlot
 	[
-		SNew(SOverlay)
-		+ SOverlay::Slot()
-		.HAlign(HAlign_Right)
-		.VAlign(VAlign_Top)
+		SNew(SInvalidationPanel)
 		[
 			SNew(SOverlay)
 			+ SOverlay::Slot()
 			.HAlign(HAlign_Right)
-			.VAlign(VAlign_Fill)
-			.Padding( GetProfileSwapOffset() )
-			[
-				SNew(SBox)
-				.WidthOverride(MenuProfileWidth)
-				[
-					SNew(SImage)
-					.Visibility(this, &SFightingVRMenuWidget::GetProfileSwapVisibility)
-					.ColorAndOpacity(this, &SFightingVRMenuWidget::GetHeaderColor)
-					.Image(&MenuStyle->HeaderBackgroundBrush)
-				]
-			]
-			+ SOverlay::Slot()
-			.HAlign(HAlign_Right)
-			.VAlign(VAlign_Fill)
-			.Padding( GetProfileSwapOffset() )
+			.VAlign(VAlign_Top)
 			[
-				SNew(SVerticalBox)
-				.Visibility(this, &SFightingVRMenuWidget::GetProfileSwapVisibility)
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				.Padding( 16.0f, 10.0f, 16.0f, 1.0f )
+				SNew(SOverlay)
+				+ SOverlay::Slot()
 				.HAlign(HAlign_Right)
-				.VAlign(VAlign_Top)
+				.VAlign(VAlign_Fill)
+				.Padding( GetProfileSwapOffset() )
 				[
-					SNew(STextBlock)
-					.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuProfileNameStyle")
-					.ColorAndOpacity(MenuTitleTextColor)
-					.Text(PlayerName)
+					SNew(SBox)
+					.WidthOverride(MenuProfileWidth)
+					[
+						SAssignNew(ProfileSwapImage, SImage)
+						.Visibility(GetProfileSwapVisibility())
+						.ColorAndOpacity(GetHeaderColor())
+						.Image(&MenuStyle->HeaderBackgroundBrush)
+					]
 				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
+				+ SOverlay::Slot()
 				.HAlign(HAlign_Right)
-				.VAlign(VAlign_Bottom)
-				.Padding( 16.0f, 1.0f, 16.0f, 10.0f )
+				.VAlign(VAlign_Fill)
+				.Padding( GetProfileSwapOffset() )
 				[
-					SNew(STextBlock)
-					.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuServerListTextStyle")
-					.ColorAndOpacity(MenuTitleTextColor)
-					.Text(ProfileSwap)
+					SAssignNew(ProfileSwapBox, SVerticalBox)
+					.Visibility(GetProfileSwapVisibility())
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding( 16.0f, 10.0f, 16.0f, 1.0f )
+					.HAlign(HAlign_Right)
+					.VAlign(VAlign_Top)
+					[
+						SNew(STextBlock)
+						.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuProfileNameStyle")
+						.ColorAndOpacity(MenuTitleTextColor)
+						.Text(PlayerName)
+					]
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.HAlign(HAlign_Right)
+					.VAlign(VAlign_Bottom)
+					.Padding( 16.0f, 1.0f, 16.0f, 10.0f )
+					[
+						SNew(STextBlock)
+						.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuServerListTextStyle")
+						.ColorAndOpacity(MenuTitleTextColor)
+						.Text(ProfileSwap)
+					]
 				]
 			]
-		]
-		+ SOverlay::Slot()
-		.HAlign(HAlign_Fill)
-		.VAlign(VAlign_Fill)
-		[
-			SNew(SVerticalBox)
-			+ SVerticalBox::Slot()
-			.HAlign(HAlign_Left)
-			.VAlign(VAlign_Top)
-			.Padding(TAttribute<FMargin>(this,&SFightingVRMenuWidget::GetMenuOffset))
+			+ SOverlay::Slot()
+			.HAlign(HAlign_Fill)
+			.VAlign(VAlign_Fill)
 			[
-				SNew(SVerticalBox)
+				SAssignNew(MenuBox, SVerticalBox)
 				+ SVerticalBox::Slot()
-				.AutoHeight()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Top)
+				.Expose(MenuSlot)
 				[
-					SNew(SOverlay)
-					+ SOverlay::Slot()
-					.HAlign(HAlign_Left)
-					.VAlign(VAlign_Fill)
+					SNew(SVerticalBox)
+					+ SVerticalBox::Slot()
+					.AutoHeight()
 					[
-						SNew(SBox)
-						.WidthOverride(MenuHeaderWidth)
-						.HeightOverride(MenuHeaderHeight)
+						SNew(SOverlay)
+						+ SOverlay::Slot()
+						.HAlign(HAlign_Left)
+						.VAlign(VAlign_Fill)
 						[
-							SNew(SImage)
-							.ColorAndOpacity(this, &SFightingVRMenuWidget::GetHeaderColor)
-							.Image(&MenuStyle->HeaderBackgroundBrush)
+							SNew(SBox)
+							.WidthOverride(MenuHeaderWidth)
+							.HeightOverride(MenuHeaderHeight)
+							[
+								SAssignNew(HeaderImage, SImage)
+								.ColorAndOpacity(GetHeaderColor())
+								.Image(&MenuStyle->HeaderBackgroundBrush)
+							]
 						]
-					]
-					+ SOverlay::Slot()
-					.HAlign(HAlign_Left)
-					.VAlign(VAlign_Fill)
-					[
-						SNew(SBox)
-						.WidthOverride(MenuHeaderWidth)
-						.HeightOverride(MenuHeaderHeight)
-						.VAlign(VAlign_Center)
-						.HAlign(HAlign_Center)
+						+ SOverlay::Slot()
+						.HAlign(HAlign_Left)
+						.VAlign(VAlign_Fill)
 						[
-							SNew(STextBlock)
-							.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuHeaderTextStyle")
-							.ColorAndOpacity(MenuTitleTextColor)
-							.Text(this,&SFightingVRMenuWidget::GetMenuTitle)
+							SNew(SBox)
+							.WidthOverride(MenuHeaderWidth)
+							.HeightOverride(MenuHeaderHeight)
+							.VAlign(VAlign_Center)
+							.HAlign(HAlign_Center)
+							[
+								SAssignNew(HeaderText, STextBlock)
+								.TextStyle(FFightingVRStyle::Get(), "FightingVR.MenuHeaderTextStyle")
+								.ColorAndOpacity(MenuTitleTextColor)
+								.Text(GetMenuTitle())
+							]
 						]
 					]
-				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					SNew(SBorder)
-					.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
-					.ColorAndOpacity(this, &SFightingVRMenuWidget::GetBottomColor)
-					.VAlign(VAlign_Top)
-					.HAlign(HAlign_Left)
+					+ SVerticalBox::Slot()
+					.AutoHeight()
 					[
-						SNew(SHorizontalBox)
-						+ SHorizontalBox::Slot()
-						.AutoWidth()
+						SAssignNew(BottomBorder, SBorder)
+						.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+						.ColorAndOpacity(FLinearColor(1,1,1,0))
+						.VAlign(VAlign_Top)
+						.HAlign(HAlign_Left)
 						[
-							SNew(SVerticalBox)
-							.Clipping(EWidgetClipping::ClipToBounds)
-
-							+ SVerticalBox::Slot()
-							.AutoHeight()
-							.Padding(TAttribute<FMargin>(this,&SFightingVRMenuWidget::GetLeftMenuOffset))
+							SNew(SHorizontalBox)
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
 							[
-								SNew(SBorder)
-								.BorderImage(&MenuStyle->LeftBackgroundBrush)
-								.BorderBackgroundColor(FLinearColor(1.0f, 1.0f, 1.0f, 1.0f))
-								.Padding(FMargin(OutlineWidth))
-								.DesiredSizeScale(this, &SFightingVRMenuWidget::GetBottomScale)
-								.VAlign(VAlign_Top)
-								.HAlign(HAlign_Left)
+								SAssignNew(LeftPanelBox, SVerticalBox)
+								.Clipping(EWidgetClipping::ClipToBounds)
+	
+								+ SVerticalBox::Slot()
+								.AutoHeight()
+								.Expose(LeftPanelSlot)
 								[
-									SAssignNew(LeftBox, SVerticalBox)
-									.Clipping(EWidgetClipping::ClipToBounds)
+									SAssignNew(LeftPanelBorder, SBorder)
+									.BorderImage(&MenuStyle->LeftBackgroundBrush)
+									.BorderBackgroundColor(FLinearColor(1.0f, 1.0f, 1.0f, 1.0f))
+									.Padding(FMargin(OutlineWidth))
+									.DesiredSizeScale(FVector2D::ZeroVector)
+									.VAlign(VAlign_Top)
+									.HAlign(HAlign_Left)
+									[
+										SAssignNew(LeftBox, SVerticalBox)
+										.Clipping(EWidgetClipping::ClipToBounds)
+									]
 								]
 							]
-						]
-						
-						+ SHorizontalBox::Slot()
-						.AutoWidth()
-						[
-							SNew(SVerticalBox)
-							.Clipping(EWidgetClipping::ClipToBounds)
-
-							+ SVerticalBox::Slot()
-							.Padding(TAttribute<FMargin>(this,&SFightingVRMenuWidget::GetSubMenuOffset))
-							.AutoHeight()
+							
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
 							[
-								SNew(SBorder)
-								.BorderImage(&MenuStyle->RightBackgroundBrush)
-								.BorderBackgroundColor(FLinearColor(1.0f, 1.0f, 1.0f, 1.0f))
-								.Padding(FMargin(OutlineWidth))
-								.DesiredSizeScale(this, &SFightingVRMenuWidget::GetBottomScale)
-								.VAlign(VAlign_Top)
-								.HAlign(HAlign_Left)
+								SAssignNew(RightPanelBox, SVerticalBox)
+								.Clipping(EWidgetClipping::ClipToBounds)
+	
+								+ SVerticalBox::Slot()
+								.Expose(RightPanelSlot)
+								.AutoHeight()
 								[
-									SAssignNew(RightBox, SVerticalBox)
-									.Clipping(EWidgetClipping::ClipToBounds)
+									SAssignNew(RightPanelBorder, SBorder)
+									.BorderImage(&MenuStyle->RightBackgroundBrush)
+									.BorderBackgroundColor(FLinearColor(1.0f, 1.0f, 1.0f, 1.0f))
+									.Padding(FMargin(OutlineWidth))
+									.DesiredSizeScale(FVector2D::ZeroVector)
+									.VAlign(VAlign_Top)
+									.HAlign(HAlign_Left)
+									[
+										SAssignNew(RightBox, SVerticalBox)
+										.Clipping(EWidgetClipping::ClipToBounds)
+									]
 								]
 							]
 						]
@@ -389,6 +396,7 @@ void SFightingVRMenuWidget::BuildLeftPanel(bool bInGoingBack)
 		return;
 	}
 	LeftBox->ClearChildren();
+	LeftBox->Invalidate(EInvalidateWidgetReason::ChildOrder);
 	int32 PreviousIndex = -1;
 	if (bLeftMenuChanging)
 	{
@@ -478,6 +486,7 @@ FText SFightingVRMenuWidget::GetOptionText(TSharedPtr<FFightingVRMenuItem> MenuI
 void SFightingVRMenuWidget::BuildRightPanel()
 {
 	RightBox->ClearChildren();
+	RightBox->Invalidate(EInvalidateWidgetReason::ChildOrder);
 	
 	if (NextMenu.Num() == 0) return;
 
@@ -538,6 +547,9 @@ void SFightingVRMenuWidget::UpdateArrows(TSharedPtr<FFightingVRMenuItem> MenuIte
 	{
 		MenuItem->Widget->RightArrowVisible = EVisibility::Collapsed;
 	}
+
+	// the option padding depends on the arrows and is not re-read while the menu is cached
+	MenuItem->Widget->Invalidate(EInvalidateWidgetReason::Layout);
 }
 
 void SFightingVRMenuWidget::EnterSubMenu()
@@ -700,6 +712,7 @@ void SFightingVRMenuWidget::Tick( const FGeometry& AllottedGeometry, const doubl
 				}
 				bLeftMenuChanging = false;
 				RightBox->ClearChildren();
+				RightBox->Invalidate(EInvalidateWidgetReason::ChildOrder);
 			}
 		}
 		if (bSubMenuChanging)
@@ -719,6 +732,37 @@ void SFightingVRMenuWidget::Tick( const FGeometry& AllottedGeometry, const doubl
 			}
 		}
 	}
+
+	UpdateAnimatedWidgets();
+}
+
+/** Sets the padding of a slot, invalidating the layout of its panel only if the padding changed */
+static void SetSlotPadding(SVerticalBox::FSlot* Slot, SWidget& Panel, const FMargin& Padding)
+{
+	if (Slot != nullptr && !(Slot->SlotPadding.Get() == Padding))
+	{
+		Slot->Padding(Padding);
+		Panel.Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+void SFightingVRMenuWidget::UpdateAnimatedWidgets()
+{
+	// the setters only invalidate when the value changes, so a static menu stays cached
+	SetSlotPadding(MenuSlot, *MenuBox, GetMenuOffset());
+	SetSlotPadding(LeftPanelSlot, *LeftPanelBox, GetLeftMenuOffset());
+	SetSlotPadding(RightPanelSlot, *RightPanelBox, GetSubMenuOffset());
+
+	BottomBorder->SetColorAndOpacity(GetBottomColor());
+	LeftPanelBorder->SetDesiredSizeScale(GetBottomScale());
+	RightPanelBorder->SetDesiredSizeScale(GetBottomScale());
+
+	HeaderImage->SetColorAndOpacity(GetHeaderColor());
+	HeaderText->SetText(GetMenuTitle());
+
+	ProfileSwapImage->SetVisibility(GetProfileSwapVisibility());
+	ProfileSwapImage->SetColorAndOpacity(GetHeaderColor());
+	ProfileSwapBox->SetVisibility(GetProfileSwapVisibility());
 }
 
 FMargin SFightingVRMenuWidget::GetMenuOffset() const
@@ -144,6 +144,9 @@ private:
 	/** sets hit test invisibility when console is up */
 	EVisibility GetSlateVisibility() const;
 
+	/** pushes the animated and title dependent values below to their widgets, which repaint only if a value changed */
+	void UpdateAnimatedWidgets();
+
 	/** getters used for animating the menu */
 	FVector2D GetBottomScale() const;
 	FLinearColor GetBottomColor() const;
@@ -261,6 +264,21 @@ private:
 	/** right(sub) menu layout box */
 	TSharedPtr<SVerticalBox> RightBox;
 
+	/** animated widgets and slots, updated by UpdateAnimatedWidgets instead of bound attributes so the menu can be cached */
+	TSharedPtr<SVerticalBox> MenuBox;
+	SVerticalBox::FSlot* MenuSlot;
+	TSharedPtr<SBorder> BottomBorder;
+	TSharedPtr<SVerticalBox> LeftPanelBox;
+	SVerticalBox::FSlot* LeftPanelSlot;
+	TSharedPtr<SBorder> LeftPanelBorder;
+	TSharedPtr<SVerticalBox> RightPanelBox;
+	SVerticalBox::FSlot* RightPanelSlot;
+	TSharedPtr<SBorder> RightPanelBorder;
+	TSharedPtr<SImage> HeaderImage;
+	TSharedPtr<STextBlock> HeaderText;
+	TSharedPtr<SImage> ProfileSwapImage;
+	TSharedPtr<SVerticalBox> ProfileSwapBox;
+
 	/** style for the menu widget */
 	const struct FFightingVRMenuStyle *MenuStyle;
 };
@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FightingVRSplitScreenSlots.h"
+#include "FightingVR.h"
+
+FFightingVRSplitScreenSlots::FFightingVRSplitScreenSlots()
+	: NumSupportedSlots(0)
+{
+}
+
+void FFightingVRSplitScreenSlots::SetNumSupportedSlots(int32 InNumSupportedSlots)
+{
+	ChangeSlots([this, InNumSupportedSlots]()
+	{
+		NumSupportedSlots = FMath::Clamp(InNumSupportedSlots, 0, MaxSlots);
+	});
+}
+
+bool FFightingVRSplitScreenSlots::BeginSignIn(int32 ControllerId)
+{
+	const int32 SlotIndex = FindSlot(ControllerId);
+	if (SlotIndex != INDEX_NONE)
+	{
+		// asking again while signing in, e.g. after the login UI closed, keeps the slot
+		return ActiveSlots[SlotIndex].State == EFightingVRLobbySlotState::SigningIn;
+	}
+
+	if (ActiveSlots.Num() >= NumSupportedSlots)
+	{
+		return false;
+	}
+
+	ChangeSlots([this, ControllerId]()
+	{
+		FFightingVRLobbySlot& NewSlot = ActiveSlots.AddDefaulted_GetRef();
+		NewSlot.State = EFightingVRLobbySlotState::SigningIn;
+		NewSlot.ControllerId = ControllerId;
+	});
+
+	return true;
+}
+
+void FFightingVRSplitScreenSlots::SignInFailed(int32 ControllerId)
+{
+	const int32 SlotIndex = FindSlot(ControllerId);
+	if (SlotIndex == INDEX_NONE || ActiveSlots[SlotIndex].State != EFightingVRLobbySlotState::SigningIn)
+	{
+		return;
+	}
+
+	ChangeSlots([this, SlotIndex]()
+	{
+		ActiveSlots.RemoveAt(SlotIndex);
+	});
+}
+
+void FFightingVRSplitScreenSlots::PlayerJoined(int32 ControllerId, const FText& DisplayName)
+{
+	const int32 SlotIndex = FindSlot(ControllerId);
+	if (SlotIndex != INDEX_NONE && ActiveSlots[SlotIndex].State == EFightingVRLobbySlotState::Joined)
+	{
+		PlayerRenamed(ControllerId, DisplayName);
+		return;
+	}
+
+	ChangeSlots([this, SlotIndex, ControllerId, &DisplayName]()
+	{
+		if (SlotIndex != INDEX_NONE)
+		{
+			ActiveSlots.RemoveAt(SlotIndex);
+		}
+
+		// new local players are appended, so they go right after the players that joined before them
+		FFightingVRLobbySlot JoinedSlot;
+		JoinedSlot.State = EFightingVRLobbySlotState::Joined;
+		JoinedSlot.ControllerId = ControllerId;
+		JoinedSlot.DisplayName = DisplayName;
+		ActiveSlots.Insert(MoveTemp(JoinedSlot), GetNumJoined());
+	});
+}
+
+void FFightingVRSplitScreenSlots::PlayerLeft(int32 ControllerId)
+{
+	const int32 SlotIndex = FindSlot(ControllerId);
+	if (SlotIndex == INDEX_NONE || ActiveSlots[SlotIndex].State != EFightingVRLobbySlotState::Joined)
+	{
+		return;
+	}
+
+	ChangeSlots([this, SlotIndex]()
+	{
+		ActiveSlots.RemoveAt(SlotIndex);
+	});
+}
+
+void FFightingVRSplitScreenSlots::PlayerRenamed(int32 ControllerId, const FText& DisplayName)
+{
+	const int32 SlotIndex = FindSlot(ControllerId);
+	if (SlotIndex == INDEX_NONE || ActiveSlots[SlotIndex].State != EFightingVRLobbySlotState::Joined)
+	{
+		return;
+	}
+
+	ChangeSlots([this, SlotIndex, &DisplayName]()
+	{
+		ActiveSlots[SlotIndex].DisplayName = DisplayName;
+	});
+}
+
+void FFightingVRSplitScreenSlots::Reset()
+{
+	ChangeSlots([this]()
+	{
+		ActiveSlots.Reset();
+	});
+}
+
+FFightingVRLobbySlot FFightingVRSplitScreenSlots::GetSlot(int32 SlotIndex) const
+{
+	if (SlotIndex < 0 || SlotIndex >= NumSupportedSlots)
+	{
+		return FFightingVRLobbySlot();
+	}
+
+	if (ActiveSlots.IsValidIndex(SlotIndex))
+	{
+		return ActiveSlots[SlotIndex];
+	}
+
+	FFightingVRLobbySlot OpenSlot;
+	OpenSlot.State = EFightingVRLobbySlotState::Open;
+	return OpenSlot;
+}
+
+int32 FFightingVRSplitScreenSlots::FindSlot(int32 ControllerId) const
+{
+	return ActiveSlots.IndexOfByPredicate([ControllerId](const FFightingVRLobbySlot& Slot) { return Slot.ControllerId == ControllerId; });
+}
+
+void FFightingVRSplitScreenSlots::ChangeSlots(TFunctionRef<void()> Change)
+{
+	FFightingVRLobbySlot OldSlots[MaxSlots];
+	for (int32 SlotIndex = 0; SlotIndex < MaxSlots; ++SlotIndex)
+	{
+		OldSlots[SlotIndex] = GetSlot(SlotIndex);
+	}
+
+	Change();
+
+	for (int32 SlotIndex = 0; SlotIndex < MaxSlots; ++SlotIndex)
+	{
+		if (GetSlot(SlotIndex) != OldSlots[SlotIndex])
+		{
+			OnSlotChanged.ExecuteIfBound(SlotIndex);
+		}
+	}
+}
+
+int32 FFightingVRSplitScreenSlots::GetNumJoined() const
+{
+	int32 NumJoined = 0;
+	while (NumJoined < ActiveSlots.Num() && ActiveSlots[NumJoined].State == EFightingVRLobbySlotState::Joined)
+	{
+		++NumJoined;
+	}
+	return NumJoined;
+}
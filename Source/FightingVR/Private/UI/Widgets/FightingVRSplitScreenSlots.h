@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** State of a single split screen lobby slot */
+enum class EFightingVRLobbySlotState : uint8
+{
+	/** not available with the current split screen maximum */
+	Closed,
+
+	/** free, waiting for a controller to press play */
+	Open,
+
+	/** a controller pressed play and is going through sign-in and privilege checks */
+	SigningIn,
+
+	/** taken by a local player */
+	Joined,
+};
+
+struct FFightingVRLobbySlot
+{
+	EFightingVRLobbySlotState State;
+
+	/** controller filling the slot, INDEX_NONE when closed or open */
+	int32 ControllerId;
+
+	/** nickname of the joined player */
+	FText DisplayName;
+
+	FFightingVRLobbySlot()
+		: State(EFightingVRLobbySlotState::Closed)
+		, ControllerId(INDEX_NONE)
+	{
+	}
+
+	bool operator==(const FFightingVRLobbySlot& Other) const
+	{
+		return State == Other.State && ControllerId == Other.ControllerId && DisplayName.EqualTo(Other.DisplayName);
+	}
+
+	bool operator!=(const FFightingVRLobbySlot& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+/** delegate called with the index of a slot whose state changed */
+DECLARE_DELEGATE_OneParam(FOnFightingVRLobbySlotChanged, int32);
+
+/**
+ * Headless model of the split screen lobby slots, driven by join, leave and sign-in events instead of polling.
+ * Joined players fill the first slots in local player order, followed by controllers that are still signing in.
+ * Only slots whose state actually changed are reported, so the lobby rebuilds no more widgets than that.
+ */
+class FFightingVRSplitScreenSlots
+{
+public:
+
+	static const int32 MaxSlots = 4;
+
+	FFightingVRSplitScreenSlots();
+
+	/** Opens or closes slots to match the split screen maximum */
+	void SetNumSupportedSlots(int32 InNumSupportedSlots);
+
+	int32 GetNumSupportedSlots() const { return NumSupportedSlots; }
+
+	/**
+	 * A controller pressed play and starts signing in, taking the first open slot.
+	 *
+	 * @param	ControllerId	Controller that wants to join.
+	 *
+	 * @return	true if the controller is now signing in, false if it already joined or no slot is open.
+	 */
+	bool BeginSignIn(int32 ControllerId);
+
+	/** Sign-in or privilege check of a controller failed or was abandoned, frees its slot */
+	void SignInFailed(int32 ControllerId);
+
+	/** A local player was added for the controller, replacing its sign-in slot if it had one */
+	void PlayerJoined(int32 ControllerId, const FText& DisplayName);
+
+	/** The local player of the controller was removed, the players after it move up a slot */
+	void PlayerLeft(int32 ControllerId);
+
+	/** The profile of a joined player changed */
+	void PlayerRenamed(int32 ControllerId, const FText& DisplayName);
+
+	/** Forgets every joined player and pending sign-in */
+	void Reset();
+
+	/** Returns the state of a slot, indices past the supported slots are closed */
+	FFightingVRLobbySlot GetSlot(int32 SlotIndex) const;
+
+	/** Returns the slot of a controller, INDEX_NONE if it is neither joined nor signing in */
+	int32 FindSlot(int32 ControllerId) const;
+
+	/** Called once for every slot changed by an event */
+	FOnFightingVRLobbySlotChanged OnSlotChanged;
+
+private:
+
+	/** Applies a change and reports every slot it affected */
+	void ChangeSlots(TFunctionRef<void()> Change);
+
+	/** Number of joined players, they come first in ActiveSlots */
+	int32 GetNumJoined() const;
+
+	int32 NumSupportedSlots;
+
+	/** Joined players in local player order, then controllers signing in */
+	TArray<FFightingVRLobbySlot, TInlineAllocator<MaxSlots>> ActiveSlots;
+};
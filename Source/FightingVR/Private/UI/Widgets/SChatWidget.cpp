@@ -8,6 +8,7 @@
 #define CHAT_BOX_WIDTH 576.0f
 #define CHAT_BOX_HEIGHT 192.0f
 #define CHAT_BOX_PADDING 20.0f
+#define CHAT_MAX_LINES 64
 
 void SChatWidget::Construct(const FArguments& InArgs, const FLocalPlayerContext& InContext)
 {
@@ -21,6 +22,10 @@ void SChatWidget::Construct(const FArguments& InArgs, const FLocalPlayerContext&
 	ChatFadeTime = 10.0;
 	LastChatLineTime = -1.0;
 	bVisibiltyNeedsFocus = true;
+	bHasPendingChatLines = false;
+
+	MaxChatLines = CHAT_MAX_LINES;
+	ChatHistory.Reserve(MaxChatLines);
 
 	//some constant values
 	const int32 PaddingValue = 2;
@@ -111,16 +116,17 @@ FSlateColor SChatWidget::GetStyleColor( const FLinearColor& InColor ) const
 
 void SChatWidget::AddChatLine(const FText& ChatString, bool SetFocus)
 {
-	ChatHistory.Add(MakeShareable(new FChatLine(ChatString)));
-
-	if(ChatHistoryListView.IsValid())
+	// Every message gets its own line, the list view keys its rows by the line pointer and only builds rows it has not seen
+	if (ChatHistory.Num() >= MaxChatLines)
 	{
-		FChatLine* LastLine  = ChatHistory[ChatHistory.Num() - 1].Get();
-		UE_LOG(LogOnline, Warning, TEXT("request scroll last=%s"), *LastLine->ChatString.ToString());
-		ChatHistoryListView->RequestScrollIntoView(ChatHistory[ChatHistory.Num() - 1]);
+		// History is full, drop the oldest line (its row is released by the next list refresh)
+		ChatHistory.RemoveAt(0, 1, false);
 	}
-	
-	FSlateApplication::Get().PlaySound(ChatStyle->RxMessgeSound);
+	ChatHistory.Add(MakeShareable(new FChatLine(ChatString)));
+
+	// Scrolling, list refresh and sound are deferred to Tick, so a burst of lines only costs them once
+	bHasPendingChatLines = true;
+
 	SetEntryVisibility( EVisibility::Visible );
 	bVisibiltyNeedsFocus = SetFocus;
 }
@@ -178,6 +184,20 @@ void SChatWidget::Tick( const FGeometry& AllottedGeometry, const double InCurren
 	// Always tick the super.
 	SCompoundWidget::Tick( AllottedGeometry, InCurrentTime, InDeltaTime );
 
+	if (bHasPendingChatLines)
+	{
+		bHasPendingChatLines = false;
+
+		if (ChatHistoryListView.IsValid() && ChatHistory.Num() > 0)
+		{
+			// The list view does not watch its source array, refresh it once for all the lines added this frame
+			ChatHistoryListView->RequestListRefresh();
+			ChatHistoryListView->RequestScrollIntoView(ChatHistory.Last());
+		}
+
+		FSlateApplication::Get().PlaySound(ChatStyle->RxMessgeSound);
+	}
+
 	// If we have not got the keep visible flag set, and the fade time has expired hide the widget
 	const double CurrentTime = FSlateApplication::Get().GetCurrentTime();
 	if( ( bAlwaysVisible == false ) && ( CurrentTime > ( LastChatLineTime + ChatFadeTime ) ) )
@@ -215,7 +235,12 @@ void SChatWidget::Tick( const FGeometry& AllottedGeometry, const double InCurren
  			FSlateApplication::Get().SetAllUserFocusToGameViewport();
 		}
 	}
-	FSlateApplication::Get().GetPlatformApplication().Get()->Cursor->SetType(EMouseCursor::None);
+
+	TSharedPtr<ICursor> Cursor = FSlateApplication::Get().GetPlatformApplication()->Cursor;
+	if (Cursor.IsValid() && Cursor->GetType() != EMouseCursor::None)
+	{
+		Cursor->SetType(EMouseCursor::None);
+	}
 }
 
 
@@ -40,7 +40,7 @@ public:
 	void SetEntryVisibility( TAttribute<EVisibility> InVisibility );
 
 	/** 
-	 * Add a new chat line.
+	 * Add a new chat line. Once the history is full the oldest line is dropped.
 	 *
 	 * @param	ChatString		String to add.
 	 * @param	SetFocus		Should the window be given focus
@@ -112,9 +112,15 @@ protected:
 	/** The chat history list view. */
 	TSharedPtr< SListView< TSharedPtr< FChatLine> > > ChatHistoryListView;
 
-	/** The array of chat history. */
+	/** The array of chat history, oldest first, as the list view needs it in display order. Never grows beyond MaxChatLines. */
 	TArray< TSharedPtr< FChatLine> > ChatHistory;
 
+	/** Maximum number of lines kept in the chat history. */
+	int32 MaxChatLines;
+
+	/** Set when lines were added since the last tick, so scrolling and sounds happen once per frame. */
+	uint32 bHasPendingChatLines : 1;
+
 	/** Should this chatbox be kept visible. */
 	uint32 bAlwaysVisible : 1;
 
@@ -5,6 +5,32 @@
 #include "Engine/DemoNetDriver.h"
 #include "FightingVRStyle.h"
 #include "CoreStyle.h"
+#include "Algo/BinarySearch.h"
+
+/** jumping to an event starts playback this long before it, so the lead-up is visible */
+static const float ReplayEventLeadSeconds = 2.0f;
+
+/** clicks on the timeline this close to a marker jump to its event */
+static const float ReplayEventMarkerSnapPixels = 6.0f;
+
+static FLinearColor GetReplayEventColor(EFightingVRReplayEventType Type)
+{
+	switch (Type)
+	{
+		case EFightingVRReplayEventType::Kill:
+			return FLinearColor(0.8f, 0.1f, 0.1f);
+		case EFightingVRReplayEventType::Death:
+			return FLinearColor(0.5f, 0.5f, 0.5f);
+		default:
+			return FLinearColor::White;
+	}
+}
+
+/** Demo time playback jumps to for an event */
+static float GetReplayEventJumpTime(const FFightingVRReplayEvent& Event)
+{
+	return FMath::Max(Event.Time - ReplayEventLeadSeconds, 0.0f);
+}
 
 /** Widget to represent the main replay timeline bar */
 class SFightingVRReplayTimeline : public SCompoundWidget
@@ -12,10 +38,12 @@ class SFightingVRReplayTimeline : public SCompoundWidget
 public:
 	SLATE_BEGIN_ARGS(SFightingVRReplayTimeline)
 		: _DemoDriver(nullptr)
+		, _Events(nullptr)
 		, _BackgroundBrush( FCoreStyle::Get().GetDefaultBrush() )
 		, _IndicatorBrush( FCoreStyle::Get().GetDefaultBrush() )
 		{}
 	SLATE_ARGUMENT(TWeakObjectPtr<UDemoNetDriver>, DemoDriver)
+	SLATE_ARGUMENT(const TArray<FFightingVRReplayEvent>*, Events)
 	SLATE_ATTRIBUTE( FMargin, BackgroundPadding )
 	SLATE_ATTRIBUTE( const FSlateBrush*, BackgroundBrush )
 	SLATE_ATTRIBUTE( const FSlateBrush*, IndicatorBrush )
@@ -27,12 +55,15 @@ private:
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
 
-	/** Jumps the replay to the time on the bar that was clicked */
+	/** Jumps the replay to the event marker or the time on the bar that was clicked */
 	FReply OnTimelineClicked(const FGeometry& Geometry, const FPointerEvent& Event);
 
 	/** The demo net driver underlying the current replay */
 	TWeakObjectPtr<UDemoNetDriver> DemoDriver;
 
+	/** Recorded gameplay events of the replay, owned by the demo HUD */
+	const TArray<FFightingVRReplayEvent>* Events;
+
 	/** The FName of the image resource to show */
 	TAttribute< const FSlateBrush* > BackgroundBrush;
 
@@ -43,6 +74,7 @@ private:
 void SFightingVRReplayTimeline::Construct(const FArguments& InArgs)
 {
 	DemoDriver = InArgs._DemoDriver;
+	Events = InArgs._Events;
 	BackgroundBrush = InArgs._BackgroundBrush;
 	IndicatorBrush = InArgs._IndicatorBrush;
 
@@ -68,7 +100,32 @@ FVector2D SFightingVRReplayTimeline::ComputeDesiredSize(float LayoutScaleMultipl
 
 int32 SFightingVRReplayTimeline::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
-	const int32 ParentLayerId = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyClippingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+	int32 ParentLayerId = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyClippingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	// Event markers go under the position indicator
+	if (Events != nullptr && Events->Num() > 0 && DemoDriver.IsValid() && DemoDriver->GetDemoTotalTime() > 0.0f)
+	{
+		const FSlateBrush* MarkerBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+		const FVector2D MarkerSize(2.0f, AllottedGeometry.GetLocalSize().Y);
+		const int32 MarkerLayerId = ParentLayerId + 1;
+
+		for (const FFightingVRReplayEvent& Event : *Events)
+		{
+			const float EventPercent = FMath::Clamp(Event.Time / DemoDriver->GetDemoTotalTime(), 0.0f, 1.0f);
+			const FVector2D Offset(AllottedGeometry.GetLocalSize().X * EventPercent - MarkerSize.X * 0.5f, 0.0f);
+
+			FSlateDrawElement::MakeBox(
+				OutDrawElements,
+				MarkerLayerId,
+				AllottedGeometry.ToPaintGeometry(Offset, MarkerSize),
+				MarkerBrush,
+				ESlateDrawEffect::None,
+				InWidgetStyle.GetColorAndOpacityTint() * GetReplayEventColor(Event.Type)
+			);
+		}
+
+		ParentLayerId = MarkerLayerId;
+	}
 
 	// Manually draw the position indicator
 	const FSlateBrush* ImageBrush = IndicatorBrush.Get();
@@ -114,6 +171,30 @@ FReply SFightingVRReplayTimeline::OnTimelineClicked(const FGeometry& Geometry, c
 
 		const float TimelinePercentage = LocalPos.X / Geometry.GetLocalSize().X;
 
+		// snap to the closest marker under the click, events are sorted by time
+		if (Events != nullptr && Events->Num() > 0)
+		{
+			const float SecondsPerPixel = DemoDriver->GetDemoTotalTime() / Geometry.GetLocalSize().X;
+			const float ClickedTime = TimelinePercentage * DemoDriver->GetDemoTotalTime();
+			const int32 NextIdx = Algo::LowerBoundBy(*Events, ClickedTime, &FFightingVRReplayEvent::Time);
+
+			const FFightingVRReplayEvent* ClosestEvent = nullptr;
+			for (int32 Idx = FMath::Max(NextIdx - 1, 0); Idx <= FMath::Min(NextIdx, Events->Num() - 1); ++Idx)
+			{
+				const FFightingVRReplayEvent& Candidate = (*Events)[Idx];
+				if (ClosestEvent == nullptr || FMath::Abs(Candidate.Time - ClickedTime) < FMath::Abs(ClosestEvent->Time - ClickedTime))
+				{
+					ClosestEvent = &Candidate;
+				}
+			}
+
+			if (FMath::Abs(ClosestEvent->Time - ClickedTime) <= ReplayEventMarkerSnapPixels * SecondsPerPixel)
+			{
+				DemoDriver->GotoTimeInSeconds(GetReplayEventJumpTime(*ClosestEvent));
+				return FReply::Handled();
+			}
+		}
+
 		DemoDriver->GotoTimeInSeconds( TimelinePercentage * DemoDriver->GetDemoTotalTime() );
 
 		return FReply::Handled();
@@ -127,6 +208,12 @@ void SFightingVRDemoHUD::Construct(const FArguments& InArgs)
 	PlayerOwner = InArgs._PlayerOwner;
 	check(PlayerOwner.IsValid());
 
+	UDemoNetDriver* DemoDriver = PlayerOwner->GetWorld()->GetDemoNetDriver();
+	if (DemoDriver)
+	{
+		UFightingVRReplayEventRecorder::LoadEvents(DemoDriver->GetActiveReplayName(), ReplayEvents);
+	}
+
 	ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -154,7 +241,8 @@ void SFightingVRDemoHUD::Construct(const FArguments& InArgs)
 				+SOverlay::Slot()
 				[
 					SNew(SFightingVRReplayTimeline)
-					.DemoDriver(PlayerOwner->GetWorld()->GetDemoNetDriver())
+					.DemoDriver(DemoDriver)
+					.Events(&ReplayEvents)
 					.BackgroundBrush(FFightingVRStyle::Get().GetBrush("FightingVR.ReplayTimelineBorder"))
 					.BackgroundPadding(FMargin(0.0f, 3.0))
 					.IndicatorBrush(FFightingVRStyle::Get().GetBrush("FightingVR.ReplayTimelineIndicator"))
@@ -191,14 +279,43 @@ void SFightingVRDemoHUD::Construct(const FArguments& InArgs)
 			.Padding(FMargin(6.0))
 			.AutoHeight()
 			[
-				SNew(SCheckBox)
-				.IsFocusable(false)
-				.Style(FCoreStyle::Get(), "ToggleButtonCheckbox")
-				.IsChecked(this, &SFightingVRDemoHUD::IsPauseChecked)
-				.OnCheckStateChanged(this, &SFightingVRDemoHUD::OnPauseCheckStateChanged)
+				SNew(SHorizontalBox)
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(FMargin(0.0f, 0.0f, 6.0f, 0.0f))
 				[
-					SNew(SImage)
-					.Image(FFightingVRStyle::Get().GetBrush("FightingVR.ReplayPauseIcon"))
+					SNew(SButton)
+					.IsFocusable(false)
+					.Visibility(this, &SFightingVRDemoHUD::GetEventButtonVisibility)
+					.Text(NSLOCTEXT("FightingVR.HUD.Menu", "PreviousReplayEvent", "<"))
+					.OnClicked(this, &SFightingVRDemoHUD::OnJumpToEventClicked, false)
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SCheckBox)
+					.IsFocusable(false)
+					.Style(FCoreStyle::Get(), "ToggleButtonCheckbox")
+					.IsChecked(this, &SFightingVRDemoHUD::IsPauseChecked)
+					.OnCheckStateChanged(this, &SFightingVRDemoHUD::OnPauseCheckStateChanged)
+					[
+						SNew(SImage)
+						.Image(FFightingVRStyle::Get().GetBrush("FightingVR.ReplayPauseIcon"))
+					]
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(FMargin(6.0f, 0.0f, 0.0f, 0.0f))
+				[
+					SNew(SButton)
+					.IsFocusable(false)
+					.Visibility(this, &SFightingVRDemoHUD::GetEventButtonVisibility)
+					.Text(NSLOCTEXT("FightingVR.HUD.Menu", "NextReplayEvent", ">"))
+					.OnClicked(this, &SFightingVRDemoHUD::OnJumpToEventClicked, true)
 				]
 			]
 
@@ -304,3 +421,40 @@ void SFightingVRDemoHUD::OnPauseCheckStateChanged(ECheckBoxState CheckState) con
 		}
 	}
 }
+
+EVisibility SFightingVRDemoHUD::GetEventButtonVisibility() const
+{
+	return ReplayEvents.Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+FReply SFightingVRDemoHUD::OnJumpToEventClicked(bool bForward) const
+{
+	UDemoNetDriver* DemoDriver = PlayerOwner.IsValid() ? PlayerOwner->GetWorld()->GetDemoNetDriver() : nullptr;
+	if (DemoDriver == nullptr || ReplayEvents.Num() == 0)
+	{
+		return FReply::Unhandled();
+	}
+
+	// events are sorted by time, so are their jump times; the tolerance keeps repeated presses from landing on the same event
+	const float RepeatTolerance = 0.5f;
+	const float CurrentTime = DemoDriver->GetDemoCurrentTime();
+
+	const FFightingVRReplayEvent* TargetEvent = nullptr;
+	if (bForward)
+	{
+		const int32 Idx = Algo::UpperBoundBy(ReplayEvents, CurrentTime + RepeatTolerance, &GetReplayEventJumpTime);
+		TargetEvent = ReplayEvents.IsValidIndex(Idx) ? &ReplayEvents[Idx] : nullptr;
+	}
+	else
+	{
+		const int32 Idx = Algo::LowerBoundBy(ReplayEvents, CurrentTime - RepeatTolerance, &GetReplayEventJumpTime) - 1;
+		TargetEvent = ReplayEvents.IsValidIndex(Idx) ? &ReplayEvents[Idx] : nullptr;
+	}
+
+	if (TargetEvent)
+	{
+		DemoDriver->GotoTimeInSeconds(GetReplayEventJumpTime(*TargetEvent));
+	}
+
+	return FReply::Handled();
+}
@@ -4,10 +4,14 @@
 
 #include "SlateBasics.h"
 #include "SlateExtras.h"
+#include "Online/FightingVRReplayEvents.h"
 
 class APlayerController;
 
-/** Shows the replay timeline bar, current time and total time of the replay, current playback speed, and a pause toggle button. */
+/**
+ * Shows the replay timeline bar with markers for recorded gameplay events, current time and total time of the replay,
+ * current playback speed, a pause toggle button, and buttons jumping to the previous or next event.
+ */
 class SFightingVRDemoHUD : public SCompoundWidget
 {
 public:
@@ -33,6 +37,14 @@ private:
 
 	ECheckBoxState IsPauseChecked() const;
 	void OnPauseCheckStateChanged(ECheckBoxState CheckState) const;
+
+	EVisibility GetEventButtonVisibility() const;
+
+	/** Jumps playback to just before the next or previous recorded event */
+	FReply OnJumpToEventClicked(bool bForward) const;
+
+	/** Gameplay events recorded with the replay, oldest first */
+	TArray<FFightingVRReplayEvent> ReplayEvents;
 };
 
 
@@ -621,7 +621,7 @@ FText SFightingVRScoreboardWidget::GetPlayerName(const FTeamPlayer TeamPlayer) c
 	const AFightingVRPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
 	if (PlayerState)
 	{
-		return FText::FromString(PlayerState->GetShortPlayerName());
+		return PlayerState->GetShortPlayerNameText();
 	}
 
 	return FText::GetEmpty();
@@ -39,6 +39,7 @@ void SFightingVRSplitScreenLobby::Construct( const FArguments& InArgs )
 	PressToStartMatchText = LOCTEXT("PressToStart", "<img src=\"FightingVR.Switch.Right\"/> Start Match / <img src=\"FightingVR.Switch.Up\"/> Connect Controllers");
 	PlayAsGuestText = LOCTEXT("PlayAsGuest", "<img src=\"FightingVR.Switch.Left\"/> Play As Guest");
 #endif	
+	SigningInText = LOCTEXT("SigningIn", "Signing in...");
 
 	PlayerOwner = InArgs._PlayerOwner;
 
@@ -233,10 +234,59 @@ void SFightingVRSplitScreenLobby::Construct( const FArguments& InArgs )
 			]			
 		]
 	];
-	
+
+	// the slot widgets only change when the slot model reports it
+	SlotModel.OnSlotChanged.BindSP(this, &SFightingVRSplitScreenLobby::UpdateSlotWidget);
+	for ( int32 i = 0; i < MAX_POSSIBLE_SLOTS; ++i )
+	{
+		UpdateSlotWidget( i );
+	}
+
+	UFightingVRInstance* const GameInstance = GetGameInstance();
+	if (GameInstance)
+	{
+		BoundGameInstance = GameInstance;
+		OnLocalPlayerAddedDelegateHandle = GameInstance->OnLocalPlayerAddedEvent.AddSP(this, &SFightingVRSplitScreenLobby::HandleLocalPlayerAdded);
+		OnLocalPlayerRemovedDelegateHandle = GameInstance->OnLocalPlayerRemovedEvent.AddSP(this, &SFightingVRSplitScreenLobby::HandleLocalPlayerRemoved);
+
+		const IOnlineIdentityPtr Identity = Online::GetIdentityInterface(GameInstance->GetWorld());
+		if (Identity.IsValid())
+		{
+			BoundIdentity = Identity;
+			for ( int32 i = 0; i < MAX_POSSIBLE_SLOTS; ++i )
+			{
+				OnLoginStatusChangedDelegateHandles[i] = Identity->AddOnLoginStatusChangedDelegate_Handle(i, FOnLoginStatusChangedDelegate::CreateSP(this, &SFightingVRSplitScreenLobby::HandleLoginStatusChanged));
+			}
+			OnControllerPairingChangedDelegateHandle = Identity->AddOnControllerPairingChangedDelegate_Handle(FOnControllerPairingChangedDelegate::CreateSP(this, &SFightingVRSplitScreenLobby::HandleControllerPairingChanged));
+		}
+	}
+
+	OnControllerConnectionChangeDelegateHandle = FCoreDelegates::OnControllerConnectionChange.AddSP(this, &SFightingVRSplitScreenLobby::HandleControllerConnectionChange);
+
 	Clear();
 }
 
+SFightingVRSplitScreenLobby::~SFightingVRSplitScreenLobby()
+{
+	FCoreDelegates::OnControllerConnectionChange.Remove(OnControllerConnectionChangeDelegateHandle);
+
+	if (BoundGameInstance.IsValid())
+	{
+		BoundGameInstance->OnLocalPlayerAddedEvent.Remove(OnLocalPlayerAddedDelegateHandle);
+		BoundGameInstance->OnLocalPlayerRemovedEvent.Remove(OnLocalPlayerRemovedDelegateHandle);
+	}
+
+	const IOnlineIdentityPtr Identity = BoundIdentity.Pin();
+	if (Identity.IsValid())
+	{
+		for ( int32 i = 0; i < MAX_POSSIBLE_SLOTS; ++i )
+		{
+			Identity->ClearOnLoginStatusChangedDelegate_Handle(i, OnLoginStatusChangedDelegateHandles[i]);
+		}
+		Identity->ClearOnControllerPairingChangedDelegate_Handle(OnControllerPairingChangedDelegateHandle);
+	}
+}
+
 void SFightingVRSplitScreenLobby::Clear()
 {	
 	if (GetGameInstance() == nullptr)
@@ -248,46 +298,104 @@ void SFightingVRSplitScreenLobby::Clear()
 	GetGameInstance()->RemoveSplitScreenPlayers();
 
 	// Sync the list with the actively tracked local users
-	UpdateSlots();
+	SyncSlots();
 }
 
-void SFightingVRSplitScreenLobby::Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime )
+void SFightingVRSplitScreenLobby::SyncSlots()
 {
-	// Parent tick
-	SCompoundWidget::Tick( AllottedGeometry, InCurrentTime, InDeltaTime);
+	UFightingVRInstance* const GameInstance = GetGameInstance();
+	if (GameInstance == nullptr)
+	{
+		return;
+	}
+
+	SlotModel.SetNumSupportedSlots( GetNumSupportedSlots() );
+	SlotModel.Reset();
 
-	// Make sure the slots match the local user list
-	UpdateSlots();
+	for ( ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers() )
+	{
+		SlotModel.PlayerJoined( LocalPlayer->GetControllerId(), FText::FromString(LocalPlayer->GetNickname()) );
+	}
 }
 
-void SFightingVRSplitScreenLobby::UpdateSlots()
+void SFightingVRSplitScreenLobby::UpdateSlotWidget( const int32 SlotIndex )
 {
-	if (GetGameInstance() == nullptr)
+	if ( SlotIndex < 0 || SlotIndex >= MAX_POSSIBLE_SLOTS )
 	{
 		return;
 	}
 
-	// Show active players
-	for ( int i = 0; i < GetNumSupportedSlots(); ++i )
+	const FFightingVRLobbySlot Slot = SlotModel.GetSlot( SlotIndex );
+	switch ( Slot.State )
 	{
-		ULocalPlayer * LocalPlayer = ( i < GetGameInstance()->GetNumLocalPlayers() ) ? GetGameInstance()->GetLocalPlayerByIndex( i ) : NULL;
+		case EFightingVRLobbySlotState::Closed:
+			UserSlots[SlotIndex]->SetVisibility( EVisibility::Collapsed );
+			return;
 
-		if ( LocalPlayer != NULL )
-		{
-			UserTextWidgets[i]->SetText( FText::FromString(LocalPlayer->GetNickname()) );
-		}
-		else
-		{ 
-			UserTextWidgets[i]->SetText( PressToPlayText );
-		}
+		case EFightingVRLobbySlotState::Open:
+			UserTextWidgets[SlotIndex]->SetText( PressToPlayText );
+			break;
 
-		UserSlots[i]->SetVisibility( EVisibility::Visible );
+		case EFightingVRLobbySlotState::SigningIn:
+			UserTextWidgets[SlotIndex]->SetText( SigningInText );
+			break;
+
+		case EFightingVRLobbySlotState::Joined:
+			UserTextWidgets[SlotIndex]->SetText( Slot.DisplayName );
+			break;
 	}
-	
-	// Hide non supported slots
-	for ( int i = GetNumSupportedSlots(); i < MAX_POSSIBLE_SLOTS; ++i )
+
+	UserSlots[SlotIndex]->SetVisibility( EVisibility::Visible );
+}
+
+void SFightingVRSplitScreenLobby::HandleLocalPlayerAdded( ULocalPlayer* LocalPlayer )
+{
+	if ( LocalPlayer != nullptr )
+	{
+		SlotModel.PlayerJoined( LocalPlayer->GetControllerId(), FText::FromString(LocalPlayer->GetNickname()) );
+	}
+}
+
+void SFightingVRSplitScreenLobby::HandleLocalPlayerRemoved( ULocalPlayer* LocalPlayer )
+{
+	if ( LocalPlayer != nullptr )
+	{
+		SlotModel.PlayerLeft( LocalPlayer->GetControllerId() );
+	}
+}
+
+void SFightingVRSplitScreenLobby::HandleLoginStatusChanged( int32 LocalUserNum, ELoginStatus::Type PreviousLoginStatus, ELoginStatus::Type LoginStatus, const FUniqueNetId& UserId )
+{
+	if ( LoginStatus == ELoginStatus::NotLoggedIn )
+	{
+		// signed out in the middle of joining
+		SlotModel.SignInFailed( LocalUserNum );
+	}
+
+	RefreshPlayerName( LocalUserNum );
+}
+
+void SFightingVRSplitScreenLobby::HandleControllerPairingChanged( int LocalUserNum, FControllerPairingChangedUserInfo PreviousUserInfo, FControllerPairingChangedUserInfo NewUserInfo )
+{
+	RefreshPlayerName( LocalUserNum );
+}
+
+void SFightingVRSplitScreenLobby::HandleControllerConnectionChange( bool bIsConnection, FPlatformUserId Unused, int32 UserIndex )
+{
+	// joined players are dropped by the game instance if needed, only abandoned sign-ins are ours to clean up
+	if ( !bIsConnection )
+	{
+		SlotModel.SignInFailed( UserIndex );
+	}
+}
+
+void SFightingVRSplitScreenLobby::RefreshPlayerName( const int32 ControllerId )
+{
+	const UFightingVRInstance* GameInstance = GetGameInstance();
+	ULocalPlayer* LocalPlayer = GameInstance ? GameInstance->FindLocalPlayerFromControllerId( ControllerId ) : nullptr;
+	if ( LocalPlayer != nullptr )
 	{
-		UserSlots[i]->SetVisibility( EVisibility::Collapsed );
+		SlotModel.PlayerRenamed( ControllerId, FText::FromString(LocalPlayer->GetNickname()) );
 	}
 }
 
@@ -301,6 +409,7 @@ void SFightingVRSplitScreenLobby::ConditionallyReadyPlayer( const int Controller
 	
 	if (GameInstance->GetNumLocalPlayers() >= GetNumSupportedSlots() )
 	{
+		SlotModel.SignInFailed( ControllerId );
 		return;		// Can't fit any more players at this point
 	}
 
@@ -310,6 +419,12 @@ void SFightingVRSplitScreenLobby::ConditionallyReadyPlayer( const int Controller
 		return;
 	}
 
+	// Takes the first open slot, or keeps the slot of a controller coming back from the login UI
+	if ( !SlotModel.BeginSignIn( ControllerId ) )
+	{
+		return;
+	}
+
 	TSharedPtr< const FUniqueNetId > UniqueNetId = GameInstance->GetUniqueNetIdFromControllerId( ControllerId );
 
 	const bool bIsPlayerOnline		= ( UniqueNetId.IsValid() && IsUniqueIdOnline( *UniqueNetId ) );
@@ -333,24 +448,28 @@ void SFightingVRSplitScreenLobby::ConditionallyReadyPlayer( const int Controller
 		{
 			ExternalUI->ShowLoginUI( ControllerId, OnlineMode == EOnlineMode::Online, false, FOnLoginUIClosedDelegate::CreateSP( this, &SFightingVRSplitScreenLobby::HandleLoginUIClosedAndReady ) );
 		}
+		else
+		{
+			SlotModel.SignInFailed( ControllerId );
+		}
 
 		return;
 	}
 
 	if (bIsPlayerOnline)
 	{
-		const IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GameInstance->GetWorld());
-		if (OnlineSub)
+		const IOnlineIdentityPtr Identity = Online::GetIdentityInterface(GameInstance->GetWorld());
+		if(Identity.IsValid())
 		{
-			const IOnlineIdentityPtr Identity = OnlineSub->GetIdentityInterface();
-			if(Identity.IsValid())
-			{
-				PendingControllerId = ControllerId;
-				Identity->GetUserPrivilege(
-					*UniqueNetId,
-					OnlineMode != EOnlineMode::Offline ? EUserPrivileges::CanPlayOnline : EUserPrivileges::CanPlay,
-					IOnlineIdentity::FOnGetUserPrivilegeCompleteDelegate::CreateSP(this, &SFightingVRSplitScreenLobby::OnUserCanPlay));
-			}
+			PendingControllerId = ControllerId;
+			Identity->GetUserPrivilege(
+				*UniqueNetId,
+				OnlineMode != EOnlineMode::Offline ? EUserPrivileges::CanPlayOnline : EUserPrivileges::CanPlay,
+				IOnlineIdentity::FOnGetUserPrivilegeCompleteDelegate::CreateSP(this, &SFightingVRSplitScreenLobby::OnUserCanPlay));
+		}
+		else
+		{
+			SlotModel.SignInFailed( ControllerId );
 		}
 	}
 	else
@@ -376,6 +495,14 @@ void SFightingVRSplitScreenLobby::ReadyPlayer( const int ControllerId )
 		{
 			FSlateApplication::Get().SetUserFocus(LocalPlayerIndex, SharedThis(this), EFocusCause::SetDirectly);
 		}
+
+		// the player was added before it had its id, so its slot still shows the nickname of the controller
+		RefreshPlayerName( ControllerId );
+	}
+	else
+	{
+		UE_LOG( LogOnline, Warning, TEXT( "SFightingVRSplitScreenLobby::ReadyPlayer: Failed to create local player for ControllerId %i: %s" ), ControllerId, *Error );
+		SlotModel.SignInFailed( ControllerId );
 	}
 }
 
@@ -447,6 +574,8 @@ void SFightingVRSplitScreenLobby::OnUserCanPlay(const FUniqueNetId& UserId, EUse
 {
 	if (PrivilegeResults != (uint32)IOnlineIdentity::EPrivilegeResults::NoFailures && GetGameInstance())
 	{
+		SlotModel.SignInFailed(PendingControllerId);
+
 		// Xbox shows its own system dialog currently
 #if PLATFORM_PS4
 		const IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetGameInstance()->GetWorld());
@@ -588,6 +717,9 @@ FReply SFightingVRSplitScreenLobby::OnFocusReceived(const FGeometry& MyGeometry,
 {
 	// focus all possible users
 	FSlateApplication::Get().SetAllUserFocus(SharedThis(this), EFocusCause::SetDirectly);
+
+	// pick up split screen maximum changes made while the lobby was hidden
+	SlotModel.SetNumSupportedSlots(GetNumSupportedSlots());
 	return FReply::Handled().ReleaseMouseCapture();
 
 }
@@ -607,7 +739,11 @@ void SFightingVRSplitScreenLobby::HandleLoginUIClosedAndReady( TSharedPtr<const
 	EOnlineMode OnlineMode = GameInstance->GetOnlineMode();
 
 	// If a player signed in, UniqueId will be valid, and we can place him in the open slot.
-	if ( UniqueId.IsValid() )
+	if ( !UniqueId.IsValid() )
+	{
+		SlotModel.SignInFailed( UserIndex );
+	}
+	else
 	{
 		if ( OnlineMode != EOnlineMode::Online || IsUniqueIdOnline( *UniqueId ) )
 		{
@@ -638,6 +774,10 @@ void SFightingVRSplitScreenLobby::OnLoginComplete(int32 LocalUserNum, bool bWasS
 	{
 		ConditionallyReadyPlayer(LocalUserNum, false);
 	}
+	else
+	{
+		SlotModel.SignInFailed(LocalUserNum);
+	}
 }
 
 UFightingVRInstance * SFightingVRSplitScreenLobby::GetGameInstance() const
@@ -5,6 +5,7 @@
 #include "SlateBasics.h"
 #include "SlateExtras.h"
 #include "FightingVRInstance.h"
+#include "FightingVRSplitScreenSlots.h"
 
 class SFightingVRSplitScreenLobby : public SCompoundWidget
 {
@@ -20,6 +21,8 @@ public:
 
 	SLATE_END_ARGS()	
 
+	~SFightingVRSplitScreenLobby();
+
 	/** says that we can support keyboard focus */
 	virtual bool SupportsKeyboardFocus() const override { return true; }
 
@@ -40,12 +43,25 @@ private:
 	virtual FReply OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent) override;
 	virtual void OnFocusLost( const FFocusEvent& InFocusEvent ) override;
 
-	void UpdateSlots();
+	/** Rebuilds the slot model from the current local players */
+	void SyncSlots();
+
+	/** Updates the widgets of a single slot from the slot model */
+	void UpdateSlotWidget( const int32 SlotIndex );
+
 	void ConditionallyReadyPlayer( const int ControllerId, const bool bCanShowUI );
 	void ReadyPlayer( const int ControllerId );
 	void UnreadyPlayer( const int ControllerId );
 
-	virtual void Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime ) override;
+	/** Slot model event sources */
+	void HandleLocalPlayerAdded( ULocalPlayer* LocalPlayer );
+	void HandleLocalPlayerRemoved( ULocalPlayer* LocalPlayer );
+	void HandleLoginStatusChanged( int32 LocalUserNum, ELoginStatus::Type PreviousLoginStatus, ELoginStatus::Type LoginStatus, const FUniqueNetId& UserId );
+	void HandleControllerPairingChanged( int LocalUserNum, FControllerPairingChangedUserInfo PreviousUserInfo, FControllerPairingChangedUserInfo NewUserInfo );
+	void HandleControllerConnectionChange( bool bIsConnection, FPlatformUserId Unused, int32 UserIndex );
+
+	/** Refreshes the name of a joined player after a profile change */
+	void RefreshPlayerName( const int32 ControllerId );
 
 	void HandleLoginUIClosedAndReady(TSharedPtr<const FUniqueNetId> UniqueId, const int UserIndex, const FOnlineError& Error = FOnlineError());
 
@@ -60,7 +76,10 @@ private:
 	bool ConfirmSponsorsSatisfied() const;
 	void OnUserCanPlay(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults);
 
-	static const int MAX_POSSIBLE_SLOTS = 4;
+	static const int MAX_POSSIBLE_SLOTS = FFightingVRSplitScreenSlots::MaxSlots;
+
+	/** Which controller fills which slot, updated by events rather than every tick */
+	FFightingVRSplitScreenSlots SlotModel;
 
 	/** The player that owns the Lobby. */
 	TWeakObjectPtr<ULocalPlayer> PlayerOwner;
@@ -77,6 +96,7 @@ private:
 	FText PressToPlayText;
 	FText PressToFindText;
 	FText PressToStartMatchText;
+	FText SigningInText;
 #if PLATFORM_SWITCH
 	FText PlayAsGuestText;
 #endif
@@ -84,6 +104,15 @@ private:
 	void OnLoginComplete(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Error);
 	FDelegateHandle OnLoginCompleteDelegateHandle;
 
+	/** Bindings of the slot model event sources */
+	TWeakObjectPtr<UFightingVRInstance> BoundGameInstance;
+	TWeakPtr<IOnlineIdentity, ESPMode::ThreadSafe> BoundIdentity;
+	FDelegateHandle OnLocalPlayerAddedDelegateHandle;
+	FDelegateHandle OnLocalPlayerRemovedDelegateHandle;
+	FDelegateHandle OnLoginStatusChangedDelegateHandles[MAX_POSSIBLE_SLOTS];
+	FDelegateHandle OnControllerPairingChangedDelegateHandle;
+	FDelegateHandle OnControllerConnectionChangeDelegateHandle;
+
 	int PendingControllerId;
 
 	/** True if we joining a match */
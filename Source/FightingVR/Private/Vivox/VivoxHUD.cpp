@@ -70,9 +70,53 @@ void AVivoxHUD::PostInitializeComponents()
     AHUD::PostInitializeComponents();
 
     bIsScoreBoardVisible = false;
+
+    bRosterDirty = true;
+    OnRosterChangedDelegateHandle = AFightingVRPlayerState::NotifyRosterChanged.AddUObject(this, &AVivoxHUD::OnRosterChanged);
+}
+
+void AVivoxHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    AFightingVRPlayerState::NotifyRosterChanged.Remove(OnRosterChangedDelegateHandle);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AVivoxHUD::OnRosterChanged(AFightingVRPlayerState* PlayerState)
+{
+    bRosterDirty = true;
+}
+
+void AVivoxHUD::RebuildRoster(AFightingVRState* MyGameState, AFightingVRPlayerState* MyPlayerState)
+{
+    const int32 TeamIndex = MyPlayerState->GetTeamNum();
+
+    Roster.Reset();
+    for (APlayerState* PlayerState : MyGameState->PlayerArray)
+    {
+        AFightingVRPlayerState* CurPlayerState = Cast<AFightingVRPlayerState>(PlayerState);
+        if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+        {
+            FVivoxRosterEntry& Entry = Roster.AddDefaulted_GetRef();
+            Entry.PlayerState = CurPlayerState;
+            Entry.ParticipantId = CurPlayerState->GetUniqueId().ToString();
+            Entry.DisplayName = CurPlayerState->GetShortPlayerNameText();
+            Entry.bIsBot = CurPlayerState->IsABot();
+            Entry.SortGroup = (CurPlayerState == MyPlayerState) ? 0 : (Entry.bIsBot ? 2 : 1);
+            Entry.SortName = CurPlayerState->GetPlayerName().ToUpper();
+        }
+    }
+
+    // local player < real players alphabetically < bots alphabetically
+    Roster.Sort([](const FVivoxRosterEntry& One, const FVivoxRosterEntry& Two) {
+        return One.SortGroup != Two.SortGroup ? One.SortGroup < Two.SortGroup : One.SortName < Two.SortName;
+    });
+
+    RosterOwner = MyPlayerState;
+    bRosterDirty = false;
 }
 
-FString AVivoxHUD::GetGameplayMode()
+const FString& AVivoxHUD::GetGameplayMode()
 {
     if (CachedGameplayMode.IsEmpty()) // cache gamemode so we don't need to do this every frame
     {
@@ -293,34 +337,21 @@ void AVivoxHUD::DrawVivoxRoster()
     const int32 TeamRed = 0;
     const int32 TeamIndex = MyPlayerState->GetTeamNum();
 
-    // create array of team-only players
-    TArray<AFightingVRPlayerState*> TeamArray;
-    for (int32 i = 0; i < MyGameState->PlayerArray.Num(); ++i)
+    // the roster only changes on join/leave, team and name events
+    if (bRosterDirty || RosterOwner != MyPlayerState)
     {
-        AFightingVRPlayerState* CurPlayerState = Cast<AFightingVRPlayerState>(MyGameState->PlayerArray[i]);
-        if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
-        {
-            TeamArray.Add(CurPlayerState);
-        }
+        RebuildRoster(MyGameState, MyPlayerState);
     }
 
-    // sort the array: local player < real players alphabetically < bots alphabetically
-    TeamArray.Sort([this](const AFightingVRPlayerState& One, const AFightingVRPlayerState& Two) {
-        if (One.GetShortPlayerName().Equals(GetGameInstance()->GetFirstGamePlayer()->GetNickname()))
-            return true;
-        else if ((One.IsABot() && Two.IsABot()) || (!One.IsABot() && !Two.IsABot()))
-            return One.GetPlayerName().Compare(Two.GetPlayerName(), ESearchCase::IgnoreCase) < 0; // One < Two
-        else
-            return (bool)Two.IsABot();
-    });
-
     // get Vivox channel session (same for all participants)
     TSharedPtr<IChannelSession> ChannelSession = VivoxGameInstance->GetChannelSessionForRoster();
 
     // team roster
-    for (int32 PlayerIndex = 0; PlayerIndex < TeamArray.Num(); ++PlayerIndex)
+    for (int32 PlayerIndex = 0; PlayerIndex < Roster.Num(); ++PlayerIndex)
     {
-        AFightingVRPlayerState* CurPlayerState = TeamArray[PlayerIndex];
+        const FVivoxRosterEntry& Entry = Roster[PlayerIndex];
+        AFightingVRPlayerState* CurPlayerState = Entry.PlayerState.Get();
+        if (!CurPlayerState) continue;
 
         // origin position for this roster item
         FVector2D CurPos(VivoxPosX, VivoxPosY + PlayerIndex * (VivoxRosterBg.VL + BoxPadding) * ScaleUI);
@@ -333,9 +364,9 @@ void AVivoxHUD::DrawVivoxRoster()
         bool bIsSpeaking = false;
 
         // If this player isn't a bot, check if in channel and speaking
-        if (!CurPlayerState->IsABot() && ChannelSession.IsValid())
+        if (!Entry.bIsBot && ChannelSession.IsValid())
         {
-            IParticipant * const *Participant = ChannelSession->Participants().Find(CurPlayerState->GetUniqueId().ToString());
+            IParticipant * const *Participant = ChannelSession->Participants().Find(Entry.ParticipantId);
             if (Participant)
             {
                 bIsInAudio = true;
@@ -347,7 +378,7 @@ void AVivoxHUD::DrawVivoxRoster()
         }
         // @todo: make a more comprehensive Area chat speech detection UI; meanwhile, local player uses team panel for any speech indicator and others Team channel only
         if (CurPlayerState == MyPlayerState) {
-            IParticipant * const *Participant = VivoxGameInstance->GetLoginSessionForRoster()->GetChannelSession(VivoxGameInstance->GetLastKnownTransmittingChannel()).Participants().Find(CurPlayerState->GetUniqueId().ToString());
+            IParticipant * const *Participant = VivoxGameInstance->GetLoginSessionForRoster()->GetChannelSession(VivoxGameInstance->GetLastKnownTransmittingChannel()).Participants().Find(Entry.ParticipantId);
             if (Participant && (*Participant)->SpeechDetected())
             {
                 bIsSpeaking = true;
@@ -388,7 +419,7 @@ void AVivoxHUD::DrawVivoxRoster()
         TextItem.Scale = FVector2D(TextScale * ScaleUI, TextScale * ScaleUI);
         TextItem.FontRenderInfo = ShadowedFont;
         TextItem.EnableShadow(FLinearColor::Black);
-        TextItem.Text = FText::FromString(CurPlayerState->GetShortPlayerName());
+        TextItem.Text = Entry.DisplayName;
         Canvas->DrawItem(TextItem, CurPos.X + TextOffsetX * ScaleUI, CurPos.Y + TextOffsetY * ScaleUI);
     }
 }
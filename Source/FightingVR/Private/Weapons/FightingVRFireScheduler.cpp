@@ -0,0 +1,156 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Weapons/FightingVRFireScheduler.h"
+#include "FightingVR.h"
+#include "Weapons/FightingVRWeapon.h"
+
+DECLARE_CYCLE_STAT(TEXT("Fire Scheduler"), STAT_FightingVR_FireScheduler, STATGROUP_FightingVR);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Shots Fired"), STAT_FightingVR_ScheduledShots, STATGROUP_FightingVR);
+
+float CVar_FightingVR_FireScheduler_StepRate = 240.0f;
+static FAutoConsoleVariableRef CVarFightingVRFireSchedulerStepRate(TEXT("FightingVR.FireScheduler.StepRate"), CVar_FightingVR_FireScheduler_StepRate, TEXT("Sub-steps per second the weapon fire scheduler dispatches shots at"), ECVF_Default);
+
+int32 CVar_FightingVR_FireScheduler_MaxStepsPerFrame = 64;
+static FAutoConsoleVariableRef CVarFightingVRFireSchedulerMaxStepsPerFrame(TEXT("FightingVR.FireScheduler.MaxStepsPerFrame"), CVar_FightingVR_FireScheduler_MaxStepsPerFrame, TEXT("Max sub-steps per frame, a longer hitch fires everything due in the last step"), ECVF_Default);
+
+void UFightingVRFireScheduler::Deinitialize()
+{
+	Shots.Reset();
+
+	Super::Deinitialize();
+}
+
+ETickableTickType UFightingVRFireScheduler::GetTickableTickType() const
+{
+	// the class default object never has shots to dispatch
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UFightingVRFireScheduler::IsTickable() const
+{
+	return Shots.Num() > 0;
+}
+
+TStatId UFightingVRFireScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFightingVRFireScheduler, STATGROUP_Tickables);
+}
+
+void UFightingVRFireScheduler::Tick(float DeltaTime)
+{
+	if (UWorld* World = GetWorld())
+	{
+		AdvanceTo(World->GetTimeSeconds());
+	}
+}
+
+void UFightingVRFireScheduler::ScheduleFire(AFightingVRWeapon* Weapon, double FireTime)
+{
+	if (Weapon == nullptr)
+	{
+		return;
+	}
+
+	if (Shots.Num() == 0 && CurrentShotTime < 0.0)
+	{
+		// start the clock on the step grid just before now, so nothing already due is skipped
+		const double StepSize = 1.0 / FMath::Max(CVar_FightingVR_FireScheduler_StepRate, 1.0f);
+		const double Now = GetShotTime();
+		DispatchedTime = FMath::FloorToDouble(Now / StepSize) * StepSize;
+	}
+
+	for (FScheduledShot& Shot : Shots)
+	{
+		if (Shot.Weapon == Weapon)
+		{
+			Shot.FireTime = FireTime;
+			return;
+		}
+	}
+
+	FScheduledShot& Shot = Shots.AddDefaulted_GetRef();
+	Shot.Weapon = Weapon;
+	Shot.FireTime = FireTime;
+}
+
+void UFightingVRFireScheduler::CancelFire(AFightingVRWeapon* Weapon)
+{
+	Shots.RemoveAll([Weapon](const FScheduledShot& Shot) { return Shot.Weapon == Weapon; });
+}
+
+double UFightingVRFireScheduler::GetShotTime() const
+{
+	if (CurrentShotTime >= 0.0)
+	{
+		return CurrentShotTime;
+	}
+
+	UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+double UFightingVRFireScheduler::GetRefireTime(double ShotTime, double Now, float TimeBetweenShots, bool bCatchUp)
+{
+	return (bCatchUp ? FMath::Max(ShotTime, Now - TimeBetweenShots) : Now) + TimeBetweenShots;
+}
+
+void UFightingVRFireScheduler::AdvanceTo(double Now)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightingVR_FireScheduler);
+
+	const double StepSize = 1.0 / FMath::Max(CVar_FightingVR_FireScheduler_StepRate, 1.0f);
+	const int32 MaxSteps = FMath::Max(CVar_FightingVR_FireScheduler_MaxStepsPerFrame, 1);
+
+	int32 NumSteps = FMath::FloorToInt((Now - DispatchedTime) / StepSize);
+	if (NumSteps > MaxSteps)
+	{
+		// skip ahead after a hitch, the last step still picks up every shot that became due
+		DispatchedTime += (NumSteps - MaxSteps) * StepSize;
+		NumSteps = MaxSteps;
+	}
+
+	for (int32 Step = 0; Step < NumSteps && Shots.Num() > 0; ++Step)
+	{
+		DispatchedTime += StepSize;
+		DispatchStep(DispatchedTime);
+	}
+}
+
+void UFightingVRFireScheduler::DispatchStep(double StepTime)
+{
+	// collect first, firing can schedule, cancel or destroy weapons
+	TArray<FScheduledShot, TInlineAllocator<16>> DueShots;
+	for (const FScheduledShot& Shot : Shots)
+	{
+		if (Shot.Weapon.IsValid() && Shot.FireTime <= StepTime)
+		{
+			DueShots.Add(Shot);
+		}
+	}
+
+	Shots.RemoveAll([StepTime](const FScheduledShot& Shot) { return !Shot.Weapon.IsValid() || Shot.FireTime <= StepTime; });
+
+	// due order, shots due at the same time fire in the order they were scheduled
+	DueShots.StableSort([](const FScheduledShot& A, const FScheduledShot& B) { return A.FireTime < B.FireTime; });
+
+	for (const FScheduledShot& Shot : DueShots)
+	{
+		if (AFightingVRWeapon* Weapon = Shot.Weapon.Get())
+		{
+			CurrentShotTime = Shot.FireTime;
+#if WITH_DEV_AUTOMATION_TESTS
+			if (ShotDispatchOverride)
+			{
+				ShotDispatchOverride(Weapon);
+			}
+			else
+#endif
+			{
+				Weapon->HandleReFiring();
+			}
+			CurrentShotTime = -1.0;
+
+			INC_DWORD_STAT(STAT_FightingVR_ScheduledShots);
+		}
+	}
+}
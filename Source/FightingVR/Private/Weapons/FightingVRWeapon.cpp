@@ -2,12 +2,16 @@
 
 #include "Weapons/FightingVRWeapon.h"
 #include "FightingVR.h"
+#include "Weapons/FightingVRFireScheduler.h"
 #include "Player/FightingVRCharacter.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Bots/FightingVRAIController.h"
 #include "Online/FightingVRPlayerState.h"
 #include "UI/FightingVRHUD.h"
 
+FOnFightingVRWeaponPoolChanged AFightingVRWeapon::NotifyParked;
+FOnFightingVRWeaponPoolChanged AFightingVRWeapon::NotifyUnparked;
+
 AFightingVRWeapon::AFightingVRWeapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	Mesh1P = ObjectInitializer.CreateDefaultSubobject<USkeletalMeshComponent>(this, TEXT("WeaponMesh1P"));
@@ -38,6 +42,7 @@ AFightingVRWeapon::AFightingVRWeapon(const FObjectInitializer& ObjectInitializer
 	bWantsToFire = false;
 	bPendingReload = false;
 	bPendingEquip = false;
+	bIsParked = false;
 	CurrentState = EWeaponState::Idle;
 
 	CurrentAmmo = 0;
@@ -179,6 +184,44 @@ void AFightingVRWeapon::OnLeaveInventory()
 	}
 }
 
+void AFightingVRWeapon::OnParked()
+{
+	check(GetLocalRole() == ROLE_Authority && MyPawn == NULL);
+
+	bIsParked = true;
+
+	// back to a freshly spawned weapon
+	CurrentAmmoInClip = 0;
+	CurrentAmmo = 0;
+	if (WeaponConfig.InitialClips > 0)
+	{
+		CurrentAmmoInClip = WeaponConfig.AmmoPerClip;
+		CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
+	}
+
+	SetWeaponState(EWeaponState::Idle);
+	BurstCounter = 0;
+	bRefiring = false;
+	LastFireTime = 0.0f;
+	SetActorTickEnabled(false);
+
+	// keep the channels around instead of closing them, clients only hide the weapon
+	SetNetDormancy(DORM_DormantAll);
+
+	NotifyParked.Broadcast(this);
+}
+
+void AFightingVRWeapon::OnUnparked()
+{
+	check(GetLocalRole() == ROLE_Authority);
+
+	bIsParked = false;
+	SetActorTickEnabled(true);
+	SetNetDormancy(DORM_Awake);
+
+	NotifyUnparked.Broadcast(this);
+}
+
 void AFightingVRWeapon::AttachMeshToPawn()
 {
 	if (MyPawn)
@@ -413,21 +456,14 @@ void AFightingVRWeapon::UseAmmo()
 
 void AFightingVRWeapon::HandleReFiring()
 {
-	// Update TimerIntervalAdjustment
-	UWorld* MyWorld = GetWorld();
-
-	float SlackTimeThisFrame = FMath::Max(0.0f, (MyWorld->TimeSeconds - LastFireTime) - WeaponConfig.TimeBetweenShots);
-
-	if (bAllowAutomaticWeaponCatchup)
-	{
-		TimerIntervalAdjustment -= SlackTimeThisFrame;
-	}
-
+	// the scheduler calls this at the exact due time of the shot, so there is no timer slack to compensate for
 	HandleFiring();
 }
 
 void AFightingVRWeapon::HandleFiring()
 {
+	UFightingVRFireScheduler* FireScheduler = GetWorld()->GetSubsystem<UFightingVRFireScheduler>();
+
 	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
 		if (GetNetMode() != NM_DedicatedServer)
@@ -487,16 +523,15 @@ void AFightingVRWeapon::HandleFiring()
 			StartReload();
 		}
 
-		// setup refire timer
-		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f);
+		// schedule refire
+		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f && FireScheduler != nullptr);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AFightingVRWeapon::HandleReFiring, FMath::Max<float>(WeaponConfig.TimeBetweenShots + TimerIntervalAdjustment, SMALL_NUMBER), false);
-			TimerIntervalAdjustment = 0.f;
+			FireScheduler->ScheduleFire(this, UFightingVRFireScheduler::GetRefireTime(FireScheduler->GetShotTime(), GetWorld()->GetTimeSeconds(), WeaponConfig.TimeBetweenShots, bAllowAutomaticWeaponCatchup));
 		}
 	}
 
-	LastFireTime = GetWorld()->GetTimeSeconds();
+	LastFireTime = FireScheduler ? FireScheduler->GetShotTime() : GetWorld()->GetTimeSeconds();
 }
 
 bool AFightingVRWeapon::ServerHandleFiring_Validate()
@@ -591,10 +626,11 @@ void AFightingVRWeapon::OnBurstStarted()
 {
 	// start firing, can be delayed to satisfy TimeBetweenShots
 	const float GameTime = GetWorld()->GetTimeSeconds();
-	if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
+	UFightingVRFireScheduler* FireScheduler = GetWorld()->GetSubsystem<UFightingVRFireScheduler>();
+	if (FireScheduler && LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
 		LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
 	{
-		GetWorldTimerManager().SetTimer(TimerHandle_HandleFiring, this, &AFightingVRWeapon::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
+		FireScheduler->ScheduleFire(this, LastFireTime + WeaponConfig.TimeBetweenShots);
 	}
 	else
 	{
@@ -613,11 +649,11 @@ void AFightingVRWeapon::OnBurstFinished()
 		StopSimulatingWeaponFire();
 	//}
 	
-	GetWorldTimerManager().ClearTimer(TimerHandle_HandleFiring);
+	if (UFightingVRFireScheduler* FireScheduler = GetWorld()->GetSubsystem<UFightingVRFireScheduler>())
+	{
+		FireScheduler->CancelFire(this);
+	}
 	bRefiring = false;
-
-	// reset firing interval adjustment
-	TimerIntervalAdjustment = 0.0f;
 }
 
 
@@ -779,8 +815,9 @@ void AFightingVRWeapon::OnRep_MyPawn()
 	{
 		OnEnterInventory(MyPawn);
 	}
-	else
+	else if (IsAttachedToPawn())
 	{
+		// the owning pawn may already have dropped the weapon locally when it died
 		OnLeaveInventory();
 	}
 }
@@ -943,6 +980,11 @@ bool AFightingVRWeapon::IsAttachedToPawn() const
 	return bIsEquipped || bPendingEquip;
 }
 
+bool AFightingVRWeapon::IsParked() const
+{
+	return bIsParked;
+}
+
 EWeaponState::Type AFightingVRWeapon::GetCurrentState() const
 {
 	return CurrentState;
@@ -25,6 +25,9 @@ void AFightingVRWeapon_Instant::FireWeapon()
 	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
 	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
 
+	// server traces (bots) need current bones of anyone this shot might hit
+	AFightingVRCharacter::MarkPosesNearLine(GetWorld(), StartTrace, EndTrace);
+
 	const FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 	ProcessInstantHit(Impact, StartTrace, ShootDir, RandomSeed, CurrentSpread);
 
@@ -40,6 +43,12 @@ void AFightingVRWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult&
 {
 	const float WeaponAngleDot = FMath::Abs(FMath::Sin(ReticleSpread * PI / 180.f));
 
+	// validation below checks against the hit pawn's bounds, make sure they follow its current pose
+	if (AFightingVRCharacter* HitPawn = Cast<AFightingVRCharacter>(Impact.GetActor()))
+	{
+		HitPawn->MarkPoseRelevant();
+	}
+
 	// if we have an instigator, calculate dot between the view and the shot
 	if (GetInstigator() && (Impact.GetActor() || Impact.bBlockingHit))
 	{
@@ -121,6 +130,9 @@ void AFightingVRWeapon_Instant::ServerNotifyMiss_Implementation(FVector_NetQuant
 	HitNotify.RandomSeed = RandomSeed;
 	HitNotify.ReticleSpread = ReticleSpread;
 
+	// pawns the shot barely missed are likely to be hit by the next ones
+	AFightingVRCharacter::MarkPosesNearLine(GetWorld(), Origin, Origin + ShootDir * InstantConfig.WeaponRange);
+
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
 	{
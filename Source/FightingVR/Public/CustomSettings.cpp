@@ -3,72 +3,38 @@
 
 #include "CustomSettings.h"
 
-// !!!!!!!!!!!!!
-// !_IMPORTANT_!
-// !!!!!!!!!!!!!
-FString const UCustomSettings::ProjectName = "FightingVR";
+UCustomSettings::FOnCustomSettingsChanged UCustomSettings::OnChanged;
 
 bool UCustomSettings::GetWithCopyrightNotice()
 {
-	if (ProjectName.IsEmpty())
-	{
-		UE_LOG(LogTemp, Error, TEXT("ProjectName must be set in CustomSettings.h"));
-		return false;
-	}
-	else
-	{
-		const auto Path = FString::Printf(TEXT("/Script/%s.CustomSettings"), *ProjectName);
-
-		bool bWithCopyrightNotice;
-		GConfig->GetBool(
-			*Path,
-			TEXT("bWithCopyrightNotice"),
-			bWithCopyrightNotice,
-			GGameIni
-		);
-
-		return bWithCopyrightNotice;
-	}
+	return GetDefault<UCustomSettings>()->bWithCopyrightNotice;
 }
 
 bool UCustomSettings::GetWithUploadDatatoServer()
 {
-	if (ProjectName.IsEmpty())
-	{
-		UE_LOG(LogTemp, Error, TEXT("ProjectName must be set in CustomSettings.h"));
-
-		return false;
-	}
-	else
-	{
-		const auto Path = FString::Printf(TEXT("/Script/%s.CustomSettings"), *ProjectName);
-
-		bool bWithUploadDatatoServer;
-		GConfig->GetBool(
-			*Path,
-			TEXT("bWithUploadDatatoServer"),
-			bWithUploadDatatoServer,
-			GGameIni
-		);
-
-		return bWithUploadDatatoServer;
-	}
+	return GetDefault<UCustomSettings>()->bWithUploadDatatoServer;
 }
 
 bool UCustomSettings::GetWithStandaloneHMD()
 {
-	if (ProjectName.IsEmpty())
-		UE_LOG(LogTemp, Error, TEXT("ProjectName must be set in CustomSettings.h"));
+	return GetDefault<UCustomSettings>()->bWithStandaloneHMD;
+}
 
-	const auto Path = FString::Printf(TEXT("/Script/%s.CustomSettings"), *ProjectName);
+void UCustomSettings::Reload()
+{
+	UCustomSettings* Settings = GetMutableDefault<UCustomSettings>();
+	Settings->ReloadConfig();
+	OnChanged.Broadcast(Settings);
+}
 
-	bool bWithStandaloneHMD;
-	GConfig->GetBool(
-		*Path,
-		TEXT("bWithStandaloneHMD"),
-		bWithStandaloneHMD,
-		GGameIni
-	);
+#if WITH_EDITOR
+void UCustomSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
 
-	return bWithStandaloneHMD;
-}
\ No newline at end of file
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		OnChanged.Broadcast(this);
+	}
+}
+#endif
@@ -8,7 +8,9 @@
 
 
 /**
- * 
+ * Project packaging switches, loaded from the game ini into the class default object once.
+ * The static getters read the cached values. Keys missing from the ini start with the defaults below
+ * and keep their current values when Reload() is called after the ini has been changed on disk.
  */
 
 UCLASS(Config = Game, defaultconfig, meta = (DisplayName = "Custom Game Settings"))
@@ -16,10 +18,11 @@ class FIGHTINGVR_API UCustomSettings : public UDeveloperSettings
 {
 	GENERATED_BODY()
 
-	// ** This project's class name * //
-	static const FString ProjectName;
-
 public:
+	/** Broadcast after the cached settings were reloaded or edited */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnCustomSettingsChanged, const UCustomSettings*);
+	static FOnCustomSettingsChanged OnChanged;
+
 	UPROPERTY(EditAnywhere, config, Category = Packaging)
 	bool bWithCopyrightNotice = true;
 
@@ -37,4 +40,12 @@ public:
 
 	UFUNCTION(BlueprintPure, Category = Packaging)
 	static bool GetWithStandaloneHMD();
-};
\ No newline at end of file
+
+	/** Re-reads the settings from the game ini, keys missing from the file keep their current values */
+	UFUNCTION(BlueprintCallable, Category = Packaging)
+	static void Reload();
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
@@ -2,8 +2,42 @@
 
 #pragma once
 
+#include "OnlineSessionSettings.h"
 #include "FightingVREngine.generated.h"
 
+/** Network failure with a snapshot of the connection stats at the time it happened */
+struct FFightingVRNetworkFailureRecord
+{
+	/** FDateTime::UtcNow() when the failure was handled */
+	FDateTime Time;
+
+	ENetworkFailure::Type FailureType;
+
+	FString ErrorString;
+
+	/** Map and address of the session we were in or connecting to */
+	FString URL;
+
+	/** Average round trip time in milliseconds */
+	float PingMs;
+
+	/** Incoming/outgoing packet loss over the last stat period, in percent */
+	float InPacketLossPercent;
+	float OutPacketLossPercent;
+
+	/** true if the connection could not send more data when it failed */
+	bool bSaturated;
+
+	FFightingVRNetworkFailureRecord()
+		: FailureType(ENetworkFailure::ConnectionLost)
+		, PingMs(0.0f)
+		, InPacketLossPercent(0.0f)
+		, OutPacketLossPercent(0.0f)
+		, bSaturated(false)
+	{
+	}
+};
+
 UCLASS()
 class FIGHTINGVR_API UFightingVREngine : public UGameEngine
 {
@@ -18,5 +52,52 @@ public:
 	 * 	All regular engine handling, plus update FightingVRKing state appropriately.
 	 */
 	virtual void HandleNetworkFailure(UWorld *World, UNetDriver *NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString) override;
-};
 
+	/** Returns the recorded network failures, oldest first */
+	void GetNetworkFailureHistory(TArray<FFightingVRNetworkFailureRecord>& OutHistory) const;
+
+protected:
+
+	/** Max number of network failures kept in the history, older ones are overwritten */
+	UPROPERTY(config)
+	int32 MaxNetworkFailureHistory;
+
+	/**
+	 * If true, a client that lost its connection joins the same session again through the session interface before giving up.
+	 * Clients that are not in an online session (direct connects on LAN or the Null subsystem) travel back to the last URL instead.
+	 */
+	UPROPERTY(config)
+	bool bAutoReconnect;
+
+	/** Number of reconnect attempts before falling back to the main menu */
+	UPROPERTY(config)
+	int32 MaxReconnectAttempts;
+
+	/** Adds a failure to the history, snapshotting the stats of the failed connection */
+	void RecordNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString);
+
+	/**
+	 * Starts going back to the session that was lost, if reconnecting is enabled and attempts are left.
+	 *
+	 * @return	true if a reconnect was started, false if the caller should fall back to the menu.
+	 */
+	bool TryReconnect(UWorld* World, UNetDriver* NetDriver);
+
+	/** Ends a reconnect once a map has been loaded while connected */
+	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
+
+	/** Failure history, used as a ring buffer once it reaches MaxNetworkFailureHistory */
+	TArray<FFightingVRNetworkFailureRecord> NetworkFailureHistory;
+
+	/** Index of the oldest record once the history is full */
+	int32 NetworkFailureHistoryHead;
+
+	/** URL of the session being reconnected to, empty when not reconnecting */
+	FString ReconnectURL;
+
+	/** Online session being reconnected to, invalid if the client was not in one */
+	FOnlineSessionSearchResult ReconnectSession;
+
+	/** Reconnect attempts made for ReconnectURL */
+	int32 ReconnectAttempts;
+};
@@ -79,6 +79,47 @@ enum class EOnlineMode : uint8
 	Online
 };
 
+/** Called when a front end map transition is over, bSuccess is false if the map could not be loaded */
+DECLARE_DELEGATE_OneParam(FOnFrontEndMapLoaded, bool /*bSuccess*/);
+
+/** Recording settings applied when a hosted match starts recording a replay */
+USTRUCT()
+struct FFightingVRReplayProfile
+{
+	GENERATED_BODY()
+
+	/** Name used to select the profile, from config or the ReplayProfile URL option */
+	UPROPERTY(config)
+	FName ProfileName;
+
+	/** Seconds between checkpoints, longer intervals mean smaller replays but slower scrubbing */
+	UPROPERTY(config)
+	float CheckpointIntervalSeconds;
+
+	/** Max milliseconds per frame spent saving a checkpoint, 0 saves it in a single frame */
+	UPROPERTY(config)
+	float CheckpointSaveMaxMSPerFrame;
+
+	/** Frames per second recorded into the demo stream */
+	UPROPERTY(config)
+	float RecordHz;
+
+	/**
+	 * If true, the replication graph leaves its ReplayLowValueActorClasses out of the demo stream.
+	 * That list ships empty, so this is a no-op until classes are added in Engine config.
+	 */
+	UPROPERTY(config)
+	bool bFilterLowValueActors;
+
+	FFightingVRReplayProfile()
+		: CheckpointIntervalSeconds(30.0f)
+		, CheckpointSaveMaxMSPerFrame(0.0f)
+		, RecordHz(8.0f)
+		, bFilterLowValueActors(false)
+	{
+	}
+};
+
 
 UCLASS(config=Game)
 class UFightingVRInstance : public UGameInstance
@@ -105,9 +146,21 @@ public:
 	bool HostGame(ULocalPlayer* LocalPlayer, const FString& GameType, const FString& InTravelURL);
 	bool JoinSession(ULocalPlayer* LocalPlayer, int32 SessionIndexInSearchResults);
 	bool JoinSession(ULocalPlayer* LocalPlayer, const FOnlineSessionSearchResult& SearchResult);
+
+	/** Joins a session again after losing the connection to it, destroying the stale local copy of the session first */
+	bool RejoinSession(const FOnlineSessionSearchResult& SearchResult);
 	void SetPendingInvite(const FFightingVRPendingInvite& InPendingInvite);
 
 	bool PlayDemo(ULocalPlayer* LocalPlayer, const FString& DemoName);
+
+	/** Applies the selected replay profile before the demo net driver starts recording */
+	virtual void StartRecordingReplay(const FString& InName, const FString& FriendlyName, const TArray<FString>& AdditionalOptions = TArray<FString>(), TSharedPtr<IAnalyticsProvider> AnalyticsProvider = nullptr) override;
+
+	/** Writes the replay event side-car file before the recording stops */
+	virtual void StopRecordingReplay() override;
+
+	/** Returns the replay profiles that can be selected with the ReplayProfile option */
+	const TArray<FFightingVRReplayProfile>& GetReplayProfiles() const { return ReplayProfiles; }
 	
 	/** Travel directly to the named session */
 	void TravelToSession(const FName& SessionName);
@@ -133,6 +186,9 @@ public:
 	/** Gets the current state of the GameInstance */
 	const FName GetCurrentState() const;
 
+	/** Returns true while a front end map is loading and the current state's UI is not up yet */
+	bool IsFrontEndTransitionPending() const { return !PendingFrontEndMap.IsEmpty(); }
+
 	/**
 	* Creates the message menu, clears other menus and sets the KingState to Message.
 	*
@@ -213,6 +269,36 @@ private:
 	UPROPERTY(config)
 	FString MainMenuMap;
 
+	/** Replay profiles that can be selected for recording */
+	UPROPERTY(config)
+	TArray<FFightingVRReplayProfile> ReplayProfiles;
+
+	/** Profile used when the DemoRec URL has no ReplayProfile option */
+	UPROPERTY(config)
+	FName DefaultReplayProfile;
+
+	/** Returns the replay profile named in the options, or the default one */
+	const FFightingVRReplayProfile& GetReplayProfile(const TArray<FString>& AdditionalOptions) const;
+
+	/** Values of the console variables changed by the replay profile, from before recording started */
+	TMap<FString, FString> SavedReplayConsoleVariables;
+
+	/** Puts back the console variables changed by the replay profile, so it doesn't carry over into later matches */
+	void RestoreReplayConsoleVariables();
+
+	/** Front end map being preloaded by LoadFrontEndMapAsync, empty when no transition is in flight */
+	FString PendingFrontEndMap;
+
+	/** Called once the pending front end map has become the current world, or failed to */
+	FOnFrontEndMapLoaded OnPendingFrontEndMapLoaded;
+
+	/** Preloaded package of the pending front end map, referenced so it can't be collected before the browse */
+	UPROPERTY(Transient)
+	UPackage* PendingFrontEndMapPackage;
+
+	/** FPlatformTime::Seconds() when the pending front end transition started */
+	double FrontEndTransitionStartTime;
+
 
 	FName CurrentState;
 	FName PendingState;
@@ -332,6 +418,21 @@ private:
 	/** Called after all the local players are registered in a session we're joining */
 	void FinishJoinSession(EOnJoinSessionCompleteResult::Type Result);
 
+	/** Joins the lost session through the session interface, returns false if the join could not be started */
+	bool StartRejoinSession(const FOnlineSessionSearchResult& SearchResult);
+
+	/** Joins PendingRejoinSession once the stale local copy of it is destroyed */
+	void OnRejoinSessionDestroyed(FName SessionName, bool bWasSuccessful);
+
+	/** Travels back to the rejoined session, or shows the lost connection message if the join failed */
+	void OnRejoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+
+	/** Session to join again once its stale local copy is destroyed */
+	FOnlineSessionSearchResult PendingRejoinSession;
+
+	/** Handle of the join completion delegate of a rejoin in flight */
+	FDelegateHandle OnRejoinSessionCompleteDelegateHandle;
+
 	/**
 	* Creates the message menu, clears other menus and sets the KingState to Message.
 	*
@@ -344,8 +445,29 @@ private:
 	/** Callback which is intended to be called upon finding sessions */
 	void OnSearchSessionsComplete(bool bWasSuccessful);
 
+	/** Browses to a front end map, blocking the game thread until it is loaded */
 	bool LoadFrontEndMap(const FString& MapName);
 
+	/**
+	 * Preloads a front end map package in the background while the loading screen keeps animating,
+	 * then browses to it once loading finishes.
+	 *
+	 * @param	MapName		Map to travel to.
+	 * @param	OnLoaded	Called once the map is the current world, immediately if it already is.
+	 *						Also called, with false, if the load can't start or the browse fails, so callers can always continue.
+	 * @return	false if the map name is not a valid URL.
+	 */
+	bool LoadFrontEndMapAsync(const FString& MapName, FOnFrontEndMapLoaded OnLoaded);
+
+	/** Called when the package preloaded by LoadFrontEndMapAsync finished loading */
+	void OnFrontEndMapPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	/** Drops any in flight front end transition, its callback will not be called */
+	void CancelFrontEndMapLoad();
+
+	/** Returns true if MapName is already the current world */
+	bool IsFrontEndMapLoaded(const FString& MapName) const;
+
 	/** Travel directly to the named session */
 	void InternalTravelToSession(const FName& SessionName);
 
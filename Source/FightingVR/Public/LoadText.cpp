@@ -1,6 +1,10 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "LoadText.h"
+#include "HAL/FileManager.h"
+#include "Algo/BinarySearch.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 bool ULoadText::FileSaveString(FString SaveString, FString SavePath)
 {
@@ -12,9 +16,198 @@ bool ULoadText::FileLoadString(FString LoadPath, FString& LoadString)
 	return FFileHelper::LoadFileToString(LoadString, *(FPaths::ProjectDir() + LoadPath));
 }
 
+/** bump when the record layout changes, older stores are rejected */
+static const uint32 ScoreStoreVersion = 1;
+static const uint32 ScoreStoreMagic = 0x46565353; // 'FVSS'
+static const int64 ScoreStoreHeaderSize = sizeof(uint32) * 2;
+static const int64 ScoreStoreRecordSize = sizeof(int32) + sizeof(float) * 3;
+
+static void SerializeScore(FArchive& Ar, FScoreData& Score)
+{
+	int32 MasterNumber = Score.masterNumber;
+	Ar << MasterNumber;
+	Ar << Score.scoreValue;
+	Ar << Score.damageValue;
+	Ar << Score.takenDamageValue;
+	Score.masterNumber = MasterNumber;
+}
+
+static void SerializeScoreStoreHeader(FArchive& Ar, uint32& Magic, uint32& Version)
+{
+	Ar << Magic;
+	Ar << Version;
+}
+
+bool ULoadText::ScoreRanksAbove(const FScoreData& A, const FScoreData& B)
+{
+	return A.scoreValue > B.scoreValue || (A.scoreValue == B.scoreValue && A.damageValue > B.damageValue) || (A.scoreValue == B.scoreValue && A.damageValue == B.damageValue && A.takenDamageValue < B.takenDamageValue);
+}
+
 void ULoadText::ScoreRankSort(UPARAM(ref) TArray<FScoreData>& scoreData)
 {
-    scoreData.Sort([](const FScoreData& A, const FScoreData& B) {
-		return A.scoreValue > B.scoreValue || (A.scoreValue == B.scoreValue && A.damageValue > B.damageValue) || (A.scoreValue == B.scoreValue && A.damageValue == B.damageValue && A.takenDamageValue < B.takenDamageValue);
-	});
+	scoreData.Sort(&ULoadText::ScoreRanksAbove);
+}
+
+bool ULoadText::ScoreAppend(const FScoreData& score, FString SavePath)
+{
+	const FString Filename = FPaths::ProjectDir() + SavePath;
+	const int64 FileSize = IFileManager::Get().FileSize(*Filename);
+	const bool bNewFile = FileSize < ScoreStoreHeaderSize;
+
+	if (!bNewFile)
+	{
+		// never append to a file this store doesn't own, or that an older layout wrote
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent));
+		if (!Reader)
+		{
+			return false;
+		}
+
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		SerializeScoreStoreHeader(*Reader, Magic, Version);
+		if (Reader->IsError() || Magic != ScoreStoreMagic || Version != ScoreStoreVersion)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Score store %s has an unknown format, not appending"), *SavePath);
+			return false;
+		}
+		Reader.Reset();
+
+		// a record torn by an interrupted append would shift every record after it, rewrite the store without it first
+		if ((FileSize - ScoreStoreHeaderSize) % ScoreStoreRecordSize != 0)
+		{
+			TArray<FScoreData> Scores;
+			if (!ScoreLoad(SavePath, Scores))
+			{
+				return false;
+			}
+
+			Scores.Add(score);
+			return ScoreCompact(Scores, SavePath);
+		}
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename, bNewFile ? 0 : FILEWRITE_Append));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	if (bNewFile)
+	{
+		uint32 Magic = ScoreStoreMagic;
+		uint32 Version = ScoreStoreVersion;
+		SerializeScoreStoreHeader(*Writer, Magic, Version);
+	}
+
+	FScoreData Record = score;
+	SerializeScore(*Writer, Record);
+	return Writer->Close();
+}
+
+bool ULoadText::ScoreLoad(FString LoadPath, TArray<FScoreData>& scoreData)
+{
+	scoreData.Reset();
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *(FPaths::ProjectDir() + LoadPath), FILEREAD_Silent) || FileData.Num() < ScoreStoreHeaderSize)
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	SerializeScoreStoreHeader(Reader, Magic, Version);
+	if (Magic != ScoreStoreMagic || Version != ScoreStoreVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Score store %s has an unknown format"), *LoadPath);
+		return false;
+	}
+
+	// whole records only, a partial tail is what an interrupted append leaves behind
+	const int64 NumRecords = (FileData.Num() - ScoreStoreHeaderSize) / ScoreStoreRecordSize;
+	scoreData.SetNumUninitialized(NumRecords);
+	for (FScoreData& Score : scoreData)
+	{
+		SerializeScore(Reader, Score);
+	}
+
+	return !Reader.IsError();
+}
+
+bool ULoadText::ScoreCompact(const TArray<FScoreData>& scoreData, FString SavePath)
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = ScoreStoreMagic;
+	uint32 Version = ScoreStoreVersion;
+	SerializeScoreStoreHeader(Writer, Magic, Version);
+
+	for (FScoreData Score : scoreData)
+	{
+		SerializeScore(Writer, Score);
+	}
+
+	// write next to the store and swap it in, a crash before the move leaves the old store untouched
+	const FString Filename = FPaths::ProjectDir() + SavePath;
+	const FString TempFilename = Filename + TEXT(".tmp");
+	return FFileHelper::SaveArrayToFile(FileData, *TempFilename) && IFileManager::Get().Move(*Filename, *TempFilename, true, true);
+}
+
+void ULoadText::ScoreTopK(const TArray<FScoreData>& scoreData, int32 Count, TArray<FScoreData>& topScores)
+{
+	topScores.Reset();
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// min-heap on rank, the root is the worst of the best Count seen so far
+	auto WorstOnTop = [](const FScoreData& A, const FScoreData& B) { return ScoreRanksAbove(B, A); };
+
+	topScores.Reserve(FMath::Min(Count, scoreData.Num()));
+	for (const FScoreData& Score : scoreData)
+	{
+		if (topScores.Num() < Count)
+		{
+			topScores.HeapPush(Score, WorstOnTop);
+		}
+		else if (ScoreRanksAbove(Score, topScores.HeapTop()))
+		{
+			FScoreData Worst;
+			topScores.HeapPop(Worst, WorstOnTop, false);
+			topScores.HeapPush(Score, WorstOnTop);
+		}
+	}
+
+	topScores.Sort(&ULoadText::ScoreRanksAbove);
+}
+
+int32 ULoadText::ScoreRankOf(const TArray<FScoreData>& scoreData, const FScoreData& score)
+{
+	int32 Rank = 0;
+	for (const FScoreData& Other : scoreData)
+	{
+		if (ScoreRanksAbove(Other, score))
+		{
+			++Rank;
+		}
+	}
+	return Rank;
+}
+
+void ULoadText::ScoreInsertRanked(UPARAM(ref) TArray<FScoreData>& rankedScores, const FScoreData& score)
+{
+	// after any equal scores, so entries that tie keep the order they were added in
+	const int32 InsertIndex = Algo::UpperBound(rankedScores, score, &ULoadText::ScoreRanksAbove);
+	rankedScores.Insert(score, InsertIndex);
+}
+
+int32 ULoadText::ScoreRankOfRanked(const TArray<FScoreData>& rankedScores, const FScoreData& score)
+{
+	// every entry before the lower bound ranks above score
+	return Algo::LowerBound(rankedScores, score, &ULoadText::ScoreRanksAbove);
 }
@@ -43,4 +43,41 @@ public:
 
 	UFUNCTION(BlueprintCallable, meta=(CompactNodeTitle = "ScoreRANK"))
 	static void ScoreRankSort(UPARAM(ref) TArray<FScoreData>& scoreData);
+
+	/**
+	 * Appends one score to the binary store at SavePath, creating the file if needed.
+	 * Fails without touching a file of another format or version, a store with a torn record is rewritten without it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "save")
+	static bool ScoreAppend(const FScoreData& score, FString SavePath);
+
+	/** Reads every score of the binary store at LoadPath, a record torn by a crash mid-append is dropped */
+	UFUNCTION(BlueprintCallable, Category = "save")
+	static bool ScoreLoad(FString LoadPath, TArray<FScoreData>& scoreData);
+
+	/** Rewrites the binary store at SavePath with only scoreData, the old file stays intact until the new one is complete */
+	UFUNCTION(BlueprintCallable, Category = "save")
+	static bool ScoreCompact(const TArray<FScoreData>& scoreData, FString SavePath);
+
+	/** Returns the best Count scores in rank order without sorting the whole array, scans every score on each call */
+	UFUNCTION(BlueprintPure, meta=(CompactNodeTitle = "ScoreTOP"))
+	static void ScoreTopK(const TArray<FScoreData>& scoreData, int32 Count, TArray<FScoreData>& topScores);
+
+	/** Returns the 0 based rank score would have among scoreData, scans every score on each call */
+	UFUNCTION(BlueprintPure, meta=(CompactNodeTitle = "ScoreRANKOF"))
+	static int32 ScoreRankOf(const TArray<FScoreData>& scoreData, const FScoreData& score);
+
+	/**
+	 * Inserts score into an array kept in rank order (see ScoreRankSort), so repeated queries don't rescan every score.
+	 * The best Count scores of a ranked array are its first Count entries.
+	 */
+	UFUNCTION(BlueprintCallable, meta=(CompactNodeTitle = "ScoreINSERT"))
+	static void ScoreInsertRanked(UPARAM(ref) TArray<FScoreData>& rankedScores, const FScoreData& score);
+
+	/** Returns the 0 based rank score would have among rankedScores, which must be in rank order, with a binary search */
+	UFUNCTION(BlueprintPure, meta=(CompactNodeTitle = "ScoreRANKOF"))
+	static int32 ScoreRankOfRanked(const TArray<FScoreData>& rankedScores, const FScoreData& score);
+
+	/** True if A ranks above B: higher score, then more damage dealt, then less damage taken */
+	static bool ScoreRanksAbove(const FScoreData& A, const FScoreData& B);
 };
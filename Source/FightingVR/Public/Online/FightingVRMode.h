@@ -9,6 +9,7 @@
 class AFightingVRAIController;
 class AFightingVRPlayerState;
 class AFightingVRPickup;
+class AFightingVRWeapon;
 class FUniqueNetId;
 
 UCLASS(config=Game)
@@ -79,6 +80,12 @@ class AFightingVRMode : public AGameMode
 	/** Create a bot */
 	AFightingVRAIController* CreateBot(int32 BotNum);	
 
+	/** [server] takes a parked weapon of given class from the pool, spawns a new one if none is free */
+	AFightingVRWeapon* AcquireWeapon(TSubclassOf<AFightingVRWeapon> WeaponClass);
+
+	/** [server] parks a weapon that left its pawn's inventory, so a later respawn can reuse it */
+	void ReleaseWeapon(AFightingVRWeapon* Weapon);
+
 	virtual void PostInitProperties() override;
 
 protected:
@@ -112,6 +119,14 @@ protected:
 	UPROPERTY()
 	TArray<AFightingVRAIController*> BotControllers;
 
+	/** max number of parked weapons kept for reuse, extra ones are destroyed */
+	UPROPERTY(config)
+	int32 MaxPooledWeapons;
+
+	/** weapons parked after their pawn died, waiting for the next respawn */
+	UPROPERTY(Transient)
+	TArray<AFightingVRWeapon*> WeaponPool;
+
 	UPROPERTY(config)
 	TSubclassOf<AFightingVRPlayerController> PlatformPlayerControllerClass;
 	
@@ -4,6 +4,10 @@
 
 #include "FightingVRPlayerState.generated.h"
 
+class AFightingVRPlayerState;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFightingVRRosterChanged, AFightingVRPlayerState*);
+
 UCLASS()
 class AFightingVRPlayerState : public APlayerState
 {
@@ -24,8 +28,17 @@ class AFightingVRPlayerState : public APlayerState
 	virtual void RegisterPlayerWithSession(bool bWasFromInvite) override;
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** refresh the short name and notify roster listeners of name changes */
+	virtual void OnRep_PlayerName() override;
+
+	/** refresh the short name, OnRep_PlayerName is not called on dedicated servers */
+	virtual void SetPlayerName(const FString& S) override;
+
 	// End APlayerState interface
 
+	/** Global notification when a player joins, leaves, changes team or is renamed. Needed for HUD rosters. */
+	FIGHTINGVR_API static FOnFightingVRRosterChanged NotifyRosterChanged;
+
 	/**
 	 * Set new team and update pawn. Also updates player character team colors.
 	 *
@@ -60,16 +73,11 @@ class AFightingVRPlayerState : public APlayerState
 	/** get match id that the player is in */
 	FString GetMatchId() const;
 
-	/** gets truncated player name to fit in death log and scoreboards */
-	FString GetShortPlayerName() const;
+	/** gets truncated player name to fit in death log and scoreboards, cached when the name changes */
+	const FString& GetShortPlayerName() const { return ShortPlayerName; }
 
-	/** Sends kill (excluding self) to clients */
-	UFUNCTION(Reliable, Client)
-	void InformAboutKill(class AFightingVRPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AFightingVRPlayerState* KilledPlayerState);
-
-	/** broadcast death to local clients */
-	UFUNCTION(Reliable, NetMulticast)
-	void BroadcastDeath(class AFightingVRPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AFightingVRPlayerState* KilledPlayerState);
+	/** gets the truncated player name as text for Slate, cached when the name changes */
+	const FText& GetShortPlayerNameText() const { return ShortPlayerNameText; }
 
 	/** replicate team colors. Updated the players mesh colors appropriately */
 	UFUNCTION()
@@ -121,4 +129,13 @@ protected:
 
 	/** helper for scoring points */
 	void ScorePoints(int32 Points);
+
+	/** rebuilds ShortPlayerName and ShortPlayerNameText from the current player name */
+	void UpdateShortPlayerName();
+
+	/** player name truncated to MAX_PLAYER_NAME_LENGTH */
+	FString ShortPlayerName;
+
+	/** ShortPlayerName as text */
+	FText ShortPlayerNameText;
 };
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FightingVRReplayEvents.generated.h"
+
+enum class EFightingVRReplayEventType : uint8
+{
+	Kill,
+	Death,
+	MatchState,
+};
+
+/** Gameplay event of a recorded replay, shown as a marker on the replay timeline */
+struct FFightingVRReplayEvent
+{
+	/** demo time of the event, in seconds */
+	float Time;
+
+	EFightingVRReplayEventType Type;
+
+	/** killer and victim names, or the new match state */
+	FString Description;
+
+	FFightingVRReplayEvent()
+		: Time(0.0f)
+		, Type(EFightingVRReplayEventType::Kill)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FFightingVRReplayEvent& Event)
+	{
+		Ar << Event.Time;
+		Ar << Event.Type;
+		Ar << Event.Description;
+		return Ar;
+	}
+};
+
+/**
+ * Collects gameplay events while the world records a replay and writes them to a side-car file next to the replay.
+ * Lets the demo HUD draw event markers and jump to events without scanning the replay stream.
+ */
+UCLASS()
+class UFightingVRReplayEventRecorder : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Adds an event at the current demo time, does nothing unless the world is recording a replay.
+	 *
+	 * @param	Type			Kind of event.
+	 * @param	Description		Text shown for the event.
+	 */
+	void RecordEvent(EFightingVRReplayEventType Type, const FString& Description);
+
+	/** Writes the events of the current recording if any were added since the last write */
+	void Flush();
+
+	/**
+	 * Writes the side-car file of a replay, replacing any previous one.
+	 *
+	 * @param	StreamName	Name of the replay stream.
+	 * @param	InEvents	Events to write, oldest first.
+	 *
+	 * @return	true if the file was written.
+	 */
+	static bool SaveEvents(const FString& StreamName, const TArray<FFightingVRReplayEvent>& InEvents);
+
+	/**
+	 * Reads the events recorded for a replay, oldest first.
+	 *
+	 * @param	StreamName	Name of the replay stream.
+	 * @param	OutEvents	Events found, empty if the replay has no side-car file.
+	 *
+	 * @return	true if a valid side-car file was read.
+	 */
+	static bool LoadEvents(const FString& StreamName, TArray<FFightingVRReplayEvent>& OutEvents);
+
+	/**
+	 * Deletes the side-car file of a deleted replay.
+	 *
+	 * @param	StreamName	Name of the replay stream.
+	 */
+	static void DeleteEvents(const FString& StreamName);
+
+private:
+
+	/** Full path of the side-car file of a replay */
+	static FString GetEventsFilename(const FString& StreamName);
+
+	/** Name of the replay the events belong to */
+	FString RecordingStreamName;
+
+	/** Events of the current recording, oldest first */
+	TArray<FFightingVRReplayEvent> Events;
+
+	/** True if events were added since the last write */
+	bool bEventsDirty;
+};
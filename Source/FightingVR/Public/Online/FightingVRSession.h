@@ -123,6 +123,54 @@ protected:
 	 */
 	virtual void RegisterServer() override;
 
+	/** Settings a dedicated server advertises, rebuilt for every registration and heartbeat */
+	TSharedPtr<class FFightingVROnlineSessionSettings> BuildServerSettings() const;
+
+	/** Creates the dedicated server session, called again with backoff until it succeeds */
+	void AttemptRegisterServer();
+
+	/** Handles the result of a dedicated server CreateSession, destroying a leftover session and scheduling a retry on failure */
+	void OnRegisterServerComplete(bool bWasSuccessful);
+
+	/** Schedules the next registration attempt with backoff, unless an attempt or a retry is already pending */
+	void RetryRegisterServer();
+
+	/** Re-registers a lost dedicated server session and pushes changed settings to the online service */
+	void ServerHeartbeat();
+
+	/** Seconds to wait before the first registration retry, doubled after every failure */
+	UPROPERTY(config)
+	float RegisterServerRetryDelay;
+
+	/** Upper bound of the registration retry delay */
+	UPROPERTY(config)
+	float RegisterServerMaxRetryDelay;
+
+	/** Seconds between dedicated server heartbeats, 0 disables them */
+	UPROPERTY(config)
+	float ServerHeartbeatInterval;
+
+	/** true while the dedicated server session is being created or waiting for a retry */
+	bool bRegisteringServer;
+
+	/** true from a registration CreateSession call until its result is handled */
+	bool bRegisterServerAttemptPending;
+
+	/** Number of CreateSession calls made for the current registration */
+	int32 RegisterServerAttempts;
+
+	/** FPlatformTime::Seconds() when the current registration started */
+	double RegisterServerStartTime;
+
+	/** FPlatformTime::Seconds() when the last CreateSession call was made */
+	double RegisterServerAttemptStartTime;
+
+	/** Handle for efficient management of AttemptRegisterServer timer */
+	FTimerHandle TimerHandle_RetryRegisterServer;
+
+	/** Handle for efficient management of ServerHeartbeat timer */
+	FTimerHandle TimerHandle_ServerHeartbeat;
+
 	/* 
 	 * Event triggered when a presence session is created
 	 *
@@ -8,6 +8,93 @@
 /** ranked PlayerState map, created from the GameState */
 typedef TMap<int32, TWeakObjectPtr<AFightingVRPlayerState> > RankedPlayerMap; 
 
+/** single kill, replicated as part of the kill feed */
+USTRUCT()
+struct FFightingVRKillFeedEntry : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** player that scored the kill, may be null */
+	UPROPERTY()
+	class AFightingVRPlayerState* KillerPlayerState;
+
+	/** player that was killed */
+	UPROPERTY()
+	class AFightingVRPlayerState* VictimPlayerState;
+
+	/** damage type class that caused the death */
+	UPROPERTY()
+	UClass* DamageTypeClass;
+
+	/** server world time of the kill */
+	UPROPERTY()
+	float KillTime;
+
+	/** true if the kill had a killer, tells a null KillerPlayerState apart from one that is not mapped yet */
+	UPROPERTY()
+	bool bHasKiller;
+
+	/** client only, set once local players were notified about the kill */
+	bool bAnnounced;
+
+	FFightingVRKillFeedEntry()
+		: KillerPlayerState(nullptr)
+		, VictimPlayerState(nullptr)
+		, DamageTypeClass(nullptr)
+		, KillTime(0.f)
+		, bHasKiller(false)
+		, bAnnounced(false)
+	{
+	}
+
+	/** notifies local players about the kill when it arrives on a client */
+	void PostReplicatedAdd(const struct FFightingVRKillFeed& InArraySerializer);
+
+	/** notifies local players about a kill that arrived before its player states were mapped */
+	void PostReplicatedChange(const struct FFightingVRKillFeed& InArraySerializer);
+
+private:
+
+	/** notifies local players once both player states of the kill are available */
+	void ConditionallyAnnounce(const struct FFightingVRKillFeed& InArraySerializer);
+};
+
+/** bounded list of the most recent kills, delta replicated */
+USTRUCT()
+struct FFightingVRKillFeed : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** most recent kills, oldest first */
+	UPROPERTY()
+	TArray<FFightingVRKillFeedEntry> Entries;
+
+	/** game state owning this feed */
+	class AFightingVRState* Owner;
+
+	FFightingVRKillFeed()
+		: Owner(nullptr)
+	{
+	}
+
+	/** adds a new entry, dropping the oldest one if the feed is full */
+	FFightingVRKillFeedEntry& AddEntry(int32 MaxEntries);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FFightingVRKillFeedEntry, FFightingVRKillFeed>(Entries, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FFightingVRKillFeed> : public TStructOpsTypeTraitsBase2<FFightingVRKillFeed>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
 UCLASS()
 class AFightingVRState : public AGameState
 {
@@ -31,6 +118,36 @@ public:
 	UPROPERTY(Transient, Replicated)
 	bool bTimerPaused;
 
+	/** recent kills, replaces per player death RPCs */
+	UPROPERTY(Transient, Replicated)
+	FFightingVRKillFeed KillFeed;
+
+	/** 
+	 * Server only. Adds a kill to the replicated kill feed and notifies local players.
+	 *
+	 * @param	KillerPlayerState	Player that did the killing, may be null.
+	 * @param	VictimPlayerState	Player that was killed.
+	 * @param	DamageType			The type of damage that caused the death.
+	 */
+	void AddKill(AFightingVRPlayerState* KillerPlayerState, AFightingVRPlayerState* VictimPlayerState, const UDamageType* DamageType);
+
+	/** Sends a kill feed entry to all local player controllers */
+	void NotifyKill(const FFightingVRKillFeedEntry& Entry);
+
+	/** Adds a kill feed entry to the events of the replay being recorded, if any */
+	void RecordReplayKill(const FFightingVRKillFeedEntry& Entry);
+
+	/**
+	 * Server only. Queues points for a player and their current team, applied once per frame by FlushPendingScores.
+	 *
+	 * @param	PlayerState		Player that scored.
+	 * @param	Points			Points to add, may be negative.
+	 */
+	void AddPendingScore(AFightingVRPlayerState* PlayerState, int32 Points);
+
+	/** Applies queued points to player scores and TeamScores, writing each of them once */
+	void FlushPendingScores();
+
 	/** gets ranked PlayerState map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
 
@@ -39,6 +156,13 @@ public:
 	virtual void HandleMatchHasStarted() override;
 	virtual void HandleMatchHasEnded() override;
 
+	/** adds match state changes to the events of the replay being recorded */
+	virtual void OnRep_MatchState() override;
+
+	/** notify roster listeners of joining and leaving players */
+	virtual void AddPlayerState(APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
+
 protected:
 	UPROPERTY(config)
 	FString ActivityId;
@@ -47,4 +171,13 @@ protected:
 	bool bEnableGameFeedback;
 
 	FFightingVROnlineGameMatches GameMatches;
+
+	/** Points queued per player since the last flush */
+	TMap<TWeakObjectPtr<AFightingVRPlayerState>, int32> PendingPlayerScores;
+
+	/** Points queued per team since the last flush, indexed by team number */
+	TArray<int32> PendingTeamScores;
+
+	/** Handle for efficient management of FlushPendingScores timer */
+	FTimerHandle TimerHandle_FlushPendingScores;
 };
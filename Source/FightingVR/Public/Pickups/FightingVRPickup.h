@@ -10,6 +10,8 @@ class AFightingVRPickup : public AActor
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class UFightingVRPickupRespawnScheduler;
+
 	/** pickup on touch */
 	virtual void NotifyActorBeginOverlap(class AActor* Other) override;
 
@@ -54,9 +56,6 @@ protected:
 	UPROPERTY(Transient, Replicated)
 	AFightingVRCharacter* PickedUpBy;
 
-	/** Handle for efficient management of RespawnPickup timer */
-	FTimerHandle TimerHandle_RespawnPickup;
-
 	UFUNCTION()
 	void OnRep_IsActive();
 
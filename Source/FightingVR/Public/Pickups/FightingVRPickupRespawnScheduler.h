@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FightingVRPickupRespawnScheduler.generated.h"
+
+class AFightingVRPickup;
+
+/**
+ * Respawns every picked up pickup of a world from a single timer.
+ * Pending respawns are kept in a min-heap on respawn time, the timer always fires for the earliest one.
+ */
+UCLASS()
+class UFightingVRPickupRespawnScheduler : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Queues a pickup to respawn after a delay.
+	 *
+	 * @param	Pickup		Pickup that was just picked up.
+	 * @param	Delay		Seconds until the pickup respawns.
+	 */
+	void ScheduleRespawn(AFightingVRPickup* Pickup, float Delay);
+
+	/** Returns number of pickups waiting to respawn */
+	int32 GetNumPendingRespawns() const { return PendingRespawns.Num(); }
+
+protected:
+
+	struct FPendingRespawn
+	{
+		TWeakObjectPtr<AFightingVRPickup> Pickup;
+
+		/** world time the pickup respawns */
+		float RespawnTime;
+
+		bool operator<(const FPendingRespawn& Other) const { return RespawnTime < Other.RespawnTime; }
+	};
+
+	/** respawns every pickup that is due and rearms the timer for the next one */
+	void RespawnDuePickups();
+
+	/** points the timer at the earliest pending respawn, or clears it */
+	void UpdateTimer();
+
+	/** Pending respawns, min-heap on RespawnTime */
+	TArray<FPendingRespawn> PendingRespawns;
+
+	/** Handle for efficient management of RespawnDuePickups timer */
+	FTimerHandle TimerHandle_RespawnDuePickups;
+};
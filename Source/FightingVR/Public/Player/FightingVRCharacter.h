@@ -272,6 +272,18 @@ class AFightingVRCharacter : public ACharacter
 
 	/** Update the team color of all player meshes. */
 	void UpdateTeamColorsAllMIDs();
+
+	/** [dedicated server] keep refreshing mesh bones for a while and bring a stale pose up to date, called before hit traces */
+	void MarkPoseRelevant();
+
+	/**
+	* [dedicated server] Marks pawns close to a shot, so their bones are current when the shot is traced.
+	*
+	* @param	World		World the shot is fired in.
+	* @param	Start		Start of the shot.
+	* @param	End			End of the shot.
+	*/
+	static void MarkPosesNearLine(UWorld* World, const FVector& Start, const FVector& End);
 private:
 
 	/** pawn mesh: 1st person view */
@@ -333,9 +345,22 @@ protected:
 	/** Base lookup rate, in deg/sec. Other scaling may affect final lookup rate. */
 	float BaseLookUpRate;
 
-	/** material instances for setting team color in mesh (3rd person view) */
+	/** authored materials of mesh (3rd person view), replaced by shared team colored instances */
 	UPROPERTY(Transient)
-	TArray<UMaterialInstanceDynamic*> MeshMIDs;
+	TArray<UMaterialInterface*> MeshBaseMaterials;
+
+	/** authored materials of mesh (1st person view), replaced by shared team colored instances */
+	UPROPERTY(Transient)
+	TArray<UMaterialInterface*> Mesh1PBaseMaterials;
+
+	/** class default relative transform of the 1st person mesh, the camera pivots it in OnCameraUpdate */
+	FTransform DefaultMesh1PTransform;
+
+	/** [dedicated server] true while mesh bones are refreshed every tick */
+	uint32 bPoseRelevant : 1;
+
+	/** [dedicated server] time until mesh bones keep being refreshed */
+	float PoseRelevantUntilTime;
 
 	/** animation played on death */
 	UPROPERTY(EditDefaultsOnly, Category = Animation)
@@ -383,8 +408,11 @@ protected:
 	/** handle mesh visibility and updates */
 	void UpdatePawnMeshes();
 
-	/** handle mesh colors on specified material instance */
-	void UpdateTeamColors(UMaterialInstanceDynamic* UseMID);
+	/** handle mesh colors on specified mesh */
+	void UpdateTeamColors(USkeletalMeshComponent* UseMesh, const TArray<UMaterialInterface*>& BaseMaterials);
+
+	/** [dedicated server] switch mesh between refreshing bones every tick and reduced rate pose updates */
+	void SetPoseRelevant(bool bRelevant);
 
 	/** Responsible for cleaning up bodies on clients. */
 	virtual void TornOff();
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FightingVRCorpseManager.generated.h"
+
+class AFightingVRCharacter;
+
+/**
+ * Keeps the number of dead pawns in a world within budget.
+ * Only a few ragdolls simulate at once, settled ones are frozen in place and the oldest/farthest corpses are removed first.
+ */
+UCLASS()
+class UFightingVRCorpseManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Starts tracking a pawn that just went ragdoll, evicting other corpses if the budget is exceeded.
+	 *
+	 * @param	Corpse		Dead pawn simulating physics.
+	 */
+	void AddCorpse(AFightingVRCharacter* Corpse);
+
+	/** Returns number of corpses still simulating physics */
+	int32 GetNumActiveRagdolls() const;
+
+	/** Returns number of corpses tracked, simulating or frozen */
+	int32 GetNumCorpses() const { return Corpses.Num(); }
+
+protected:
+
+	struct FCorpseInfo
+	{
+		TWeakObjectPtr<AFightingVRCharacter> Pawn;
+
+		/** world time the pawn went ragdoll */
+		float StartTime;
+
+		/** true once the pose has been frozen */
+		bool bFrozen;
+	};
+
+	/** freezes settled ragdolls, removes expired corpses and updates stats */
+	void UpdateCorpses();
+
+	/** freezes active ragdolls until there are at most MaxActive left */
+	void EnforceActiveBudget(int32 MaxActive);
+
+	/** removes corpses until there are at most MaxCorpses left */
+	void EnforceCorpseBudget(int32 MaxCorpses);
+
+	/** returns index of the corpse that is cheapest to lose: oldest and farthest from local viewers */
+	int32 FindCorpseToEvict(bool bOnlyActive) const;
+
+	/** stops simulating and locks the current pose */
+	void FreezeCorpse(FCorpseInfo& Info) const;
+
+	/** Tracked corpses, oldest first */
+	TArray<FCorpseInfo> Corpses;
+
+	/** Handle for efficient management of UpdateCorpses timer */
+	FTimerHandle TimerHandle_UpdateCorpses;
+};
@@ -21,10 +21,17 @@ public:
 	/** Initializes the PersistentUser */
 	void LoadPersistentUser();
 
+	/** Returns the achievement and stats writer of this player, created on first use */
+	class UFightingVRResultsWriter* GetResultsWriter();
+
 private:
 	/** Persistent user data stored between sessions (i.e. the user's savegame) */
 	UPROPERTY()
 	class UFightingVRPersistentUser* PersistentUser;
+
+	/** Pending achievement and stats writes, kept here so they outlive the player controller */
+	UPROPERTY()
+	class UFightingVRResultsWriter* ResultsWriter;
 };
 
 
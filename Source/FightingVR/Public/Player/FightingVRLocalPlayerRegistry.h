@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FightingVRLocalPlayerRegistry.generated.h"
+
+class AFightingVRPlayerController;
+class APlayerState;
+
+/**
+ * Player controllers of the local (split screen) players in a world.
+ * Lets per-event dispatch, like kill feed notifications, visit only local players instead of every controller.
+ */
+UCLASS()
+class UFightingVRLocalPlayerRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Adds a controller that just got a local player, no-op if already registered */
+	void RegisterController(AFightingVRPlayerController* Controller);
+
+	/** Removes a controller that lost its local player or is leaving the world */
+	void UnregisterController(AFightingVRPlayerController* Controller);
+
+	/** Returns the controllers of all local players, in registration order */
+	const TArray<AFightingVRPlayerController*>& GetLocalControllers() const { return LocalControllers; }
+
+	/**
+	 * Returns the local controller owning a player state, or the local controller of the same unique net id
+	 * when the player state is a copy from before a seamless travel or an inactive one that was reused.
+	 *
+	 * @param	PlayerState		Player state to look for, may be null.
+	 */
+	AFightingVRPlayerController* FindByPlayerState(const APlayerState* PlayerState) const;
+
+protected:
+
+	/** Local player controllers, nulled by GC if one is destroyed without unregistering */
+	UPROPERTY(Transient)
+	TArray<AFightingVRPlayerController*> LocalControllers;
+};
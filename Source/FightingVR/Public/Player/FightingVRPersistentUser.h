@@ -3,6 +3,25 @@
 #pragma once
 #include "FightingVRPersistentUser.generated.h"
 
+/** A player met in an online match, remembered across sessions for the recently met menu */
+USTRUCT()
+struct FFightingVRRecentlyMetPlayer
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Stringified unique net id, used to deduplicate entries and to open the player's profile */
+	UPROPERTY()
+	FString UniqueId;
+
+	/** Last known display name */
+	UPROPERTY()
+	FString PlayerName;
+
+	/** When the player was last seen in a match */
+	UPROPERTY()
+	FDateTime LastMetTime;
+};
+
 UCLASS()
 class UFightingVRPersistentUser : public USaveGame
 {
@@ -101,6 +120,29 @@ public:
 
 	void SetIsRecordingDemos(const bool InbIsRecordingDemos);
 
+	/**
+	 * Moves a player to the front of the recently met list, adding them if they are new.
+	 * The least recently met player is dropped once the list is full.
+	 *
+	 * @param	UniqueId	Stringified unique net id of the player.
+	 * @param	PlayerName	Current display name of the player.
+	 */
+	void AddRecentlyMetPlayer(const FString& UniqueId, const FString& PlayerName);
+
+	/**
+	 * Updates the name of a recently met player, keeping their place in the list. No-op if the player isn't listed.
+	 *
+	 * @param	UniqueId	Stringified unique net id of the player.
+	 * @param	PlayerName	New display name of the player.
+	 */
+	void RenameRecentlyMetPlayer(const FString& UniqueId, const FString& PlayerName);
+
+	/** Recently met players, most recent first */
+	FORCEINLINE const TArray<FFightingVRRecentlyMetPlayer>& GetRecentlyMetPlayers() const
+	{
+		return RecentlyMetPlayers;
+	}
+
 	FORCEINLINE FString GetName() const
 	{
 		return SlotName;
@@ -165,6 +207,10 @@ protected:
 	UPROPERTY()
 	bool bVibrationOpt;
 
+	/** Players met in online matches, most recent first */
+	UPROPERTY()
+	TArray<FFightingVRRecentlyMetPlayer> RecentlyMetPlayers;
+
 private:
 	/** Internal.  True if data is changed but hasn't been saved. */
 	bool bIsDirty;
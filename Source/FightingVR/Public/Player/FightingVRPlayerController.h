@@ -168,13 +168,21 @@ public:
 	void QueryStats();
 
 	/** 
-	 * Writes a single achievement (unless another write is in progress).
+	 * Queues achievement progress on the local player and writes all queued progress as one batch, once any write in progress has completed.
 	 *
 	 * @param Id achievement id (string)
 	 * @param Percent number 1 to 100
 	 */
 	void UpdateAchievementProgress( const FString& Id, float Percent );
 
+	/** 
+	 * Queues achievement progress without writing it. Progress for the same achievement keeps the highest value.
+	 *
+	 * @param Id achievement id (string)
+	 * @param Percent number 1 to 100
+	 */
+	void QueueAchievementProgress( const FString& Id, float Percent );
+
 	/** Returns a pointer to the FightingVR game hud. May return NULL. */
 	AFightingVRHUD* GetFightingVRHUD() const;
 
@@ -190,6 +198,9 @@ public:
 	/** Associate a new UPlayer with this PlayerController. */
 	virtual void SetPlayer(UPlayer* Player);
 
+	/** Join the local player registry of the world we seamless traveled to. */
+	virtual void NotifyLoadedWorld(FName WorldPackageName, bool bFinalDest) override;
+
 	// end AFightingVRPlayerController-specific
 
 	virtual void PreClientTravel(const FString& PendingURL, ETravelType TravelType, bool bIsSeamlessTravel) override;
@@ -227,8 +238,11 @@ protected:
 	/** FightingVR in-game menu */
 	TSharedPtr<class FFightingVRIngameMenu> FightingVRIngameMenu;
 
-	/** Achievements write object */
-	FOnlineAchievementsWritePtr WriteObject;
+	/** Whether the player won the match whose results are waiting to be written */
+	bool bPendingMatchResultIsWinner;
+
+	/** Writes save file, achievements, leaderboards and stats for the match that just ended, queueing the online writes on the local player */
+	void WriteMatchResults();
 
 	/** try to find spot for death cam */
 	bool FindDeathCameraSpot(FVector& CameraLocation, FRotator& CameraRotation);
@@ -257,6 +271,9 @@ protected:
 
 public:
 	virtual void TickActor(float DeltaTime, enum ELevelTick TickType, FActorTickFunction& ThisTickFunction) override;
+
+	/** leave the local player registry */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//End AActor interface
 
 	//Begin AController interface
@@ -326,9 +343,37 @@ public:
 	UPROPERTY(config)
 	float FireTriggerThreshold;
 
+	/** chat messages a player may send per second once the burst is used up */
+	UPROPERTY(config)
+	float ChatMessagesPerSecond;
+
+	/** number of chat messages a player may send back to back */
+	UPROPERTY(config)
+	int32 ChatBurstSize;
+
+protected:
+
+	/** Server only. Consumes a chat token, returns false if the sender is over the chat rate limit */
+	bool ConsumeChatToken();
+
+	/** Server only. Broadcasts all chat messages accepted since the last flush as a single message */
+	void FlushPendingChatMessages();
+
+	/** Server only. Chat messages accepted this frame, waiting to be broadcast */
+	TArray<FString> PendingChatMessages;
+
+	/** Server only. Chat tokens currently available to this player */
+	float ChatTokens;
+
+	/** Server only. World time the chat tokens were last refilled */
+	float LastChatTokenTime;
+
 private:
 
 	/** Handle for efficient management of ClientStartOnlineGame timer */
 	FTimerHandle TimerHandle_ClientStartOnlineGame;
+
+	/** Handle for efficient management of WriteMatchResults timer */
+	FTimerHandle TimerHandle_WriteMatchResults;
 };
 
@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Online.h"
+#include "OnlineStatsInterface.h"
+#include "FightingVRResultsWriter.generated.h"
+
+/**
+ * Achievement and stats writes of a local player, batched and retried with backoff.
+ * Owned by the local player and timed on the game instance, so writes queued at the end of a match
+ * survive the player controller being destroyed or travelling back to the menu.
+ */
+UCLASS(Within=LocalPlayer)
+class UFightingVRResultsWriter : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFightingVRResultsWriter();
+
+	virtual UWorld* GetWorld() const override;
+
+	/**
+	 * Queues achievement progress without writing it. Progress for the same achievement keeps the highest value.
+	 *
+	 * @param Id achievement id (string)
+	 * @param Percent number 1 to 100
+	 */
+	void QueueAchievementProgress(const FString& Id, float Percent);
+
+	/** Queues a stats update, kept until the backend accepts it */
+	void QueueStatsUpdate(FOnlineStatsUserUpdatedStats&& StatsUpdate);
+
+	/** Writes all queued achievement progress in a single batch, once any write in progress has completed */
+	void WritePendingAchievements();
+
+	/** Writes all queued stats updates in a single batch, once any write in progress has completed */
+	void WritePendingStats();
+
+private:
+
+	/** Called when a batched achievement write completes, retries with backoff on failure */
+	void OnAchievementsWritten(const FUniqueNetId& PlayerId, bool bWasSuccessful, int32 WriteId);
+
+	/** Called when a batched stats write completes, retries with backoff on failure */
+	void OnStatsWritten(const FOnlineError& ResultState, int32 WriteId);
+
+	/** Treats a write the backend never answered as failed */
+	void OnAchievementsWriteTimeout();
+
+	/** Treats a stats write the backend never answered as failed, dropping the Sum updates that may already have been applied */
+	void OnStatsWriteTimeout();
+
+	/** Returns the timer manager of the game instance, which outlives the worlds of a session */
+	FTimerManager* GetTimerManager() const;
+
+	/** Achievements write object */
+	FOnlineAchievementsWritePtr WriteObject;
+
+	/** Achievement progress waiting to be written, keyed by achievement id */
+	TMap<FString, float> PendingAchievementProgress;
+
+	/** Achievement progress in the current write, queued again if the write fails */
+	TMap<FString, float> InFlightAchievementProgress;
+
+	/** Number of consecutive failed achievement writes */
+	int32 AchievementWriteRetries;
+
+	/** Id of the current achievement write, completions of older (timed out) writes are ignored */
+	int32 AchievementWriteId;
+
+	/** Stats updates waiting to be written */
+	TArray<FOnlineStatsUserUpdatedStats> PendingStatsUpdates;
+
+	/** Stats updates in the current write, queued again if the write fails */
+	TArray<FOnlineStatsUserUpdatedStats> InFlightStatsUpdates;
+
+	/** Number of consecutive failed stats writes */
+	int32 StatsWriteRetries;
+
+	/** Id of the current stats write, completions of older (timed out) writes are ignored */
+	int32 StatsWriteId;
+
+	/** Handle for efficient management of WritePendingAchievements timer */
+	FTimerHandle TimerHandle_WritePendingAchievements;
+
+	/** Handle for efficient management of OnAchievementsWriteTimeout timer */
+	FTimerHandle TimerHandle_AchievementsWriteTimeout;
+
+	/** Handle for efficient management of WritePendingStats timer */
+	FTimerHandle TimerHandle_WritePendingStats;
+
+	/** Handle for efficient management of OnStatsWriteTimeout timer */
+	FTimerHandle TimerHandle_StatsWriteTimeout;
+};
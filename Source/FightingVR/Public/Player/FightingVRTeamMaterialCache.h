@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FightingVRTeamMaterialCache.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Team colored material instances shared by all pawns of a world.
+ * Team color is the only parameter pawns vary, so one instance per (base material, team) is enough.
+ */
+UCLASS()
+class UFightingVRTeamMaterialCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Returns the instance of a material colored for a team, creating it on first use.
+	 *
+	 * @param	BaseMaterial	Material the mesh was authored with.
+	 * @param	TeamNum			Team to color the material for.
+	 */
+	UMaterialInstanceDynamic* GetTeamMaterial(UMaterialInterface* BaseMaterial, int32 TeamNum);
+
+	/** Returns number of instances created so far */
+	int32 GetNumTeamMaterials() const { return TeamMaterials.Num(); }
+
+private:
+
+	/** instances by base material and team */
+	TMap<TPair<UMaterialInterface*, int32>, UMaterialInstanceDynamic*> TeamMaterialMap;
+
+	/** keeps the instances referenced */
+	UPROPERTY(Transient)
+	TArray<UMaterialInstanceDynamic*> TeamMaterials;
+};
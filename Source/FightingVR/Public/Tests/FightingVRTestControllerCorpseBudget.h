@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerCorpseBudget.generated.h"
+
+/**
+ * Hosts a match and kills the local player a number of times (-TargetNumOfKills=, default 50) in quick succession.
+ * Fails if the corpse manager ever tracks more corpses or active ragdolls than its budget allows,
+ * or if ragdolls are still simulating after the settle time once the kills stop. Logs the worst frame time.
+ */
+UCLASS()
+class UFightingVRTestControllerCorpseBudget : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+	virtual void OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults) override;
+
+	/** Logs the counters and ends the test */
+	void FinishTest(bool bSuccess);
+
+	uint8 bInMatch : 1;
+
+	int32 NumKills;
+	int32 TargetNumOfKills;
+
+	int32 PeakCorpses;
+	int32 PeakActiveRagdolls;
+	float PeakFrameTime;
+
+	/** Time since the last kill, or since the last kill of the test once all are done */
+	float TimeSinceLastKill;
+};
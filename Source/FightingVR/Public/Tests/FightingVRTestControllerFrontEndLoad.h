@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerFrontEndLoad.generated.h"
+
+/**
+ * Hosts a match and returns to the main menu a number of times (-TargetNumOfFrontEndLoads=, default 3),
+ * timing each front end transition from leaving the match until the main menu is up, and the worst frame on the way.
+ * Fails if a transition takes longer than -MaxFrontEndLoadSecs= (default 60), or has a frame longer than
+ * -MaxFrontEndFrameMs= when that is set.
+ */
+UCLASS()
+class UFightingVRTestControllerFrontEndLoad : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+	virtual void OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults) override;
+
+	/** Leaves the match for the main menu and starts timing the transition */
+	void StartFrontEndLoad();
+
+	/** Logs the timings of the transition that just finished, then hosts the next match or ends the test */
+	void FinishFrontEndLoad();
+
+	uint8 bInMatch : 1;
+	uint8 bLoadingFrontEnd : 1;
+
+	int32 NumFrontEndLoads;
+	int32 TargetNumOfFrontEndLoads;
+	float MaxFrontEndLoadSecs;
+	float MaxFrontEndFrameMs;
+
+	/** FPlatformTime::Seconds() when the current match started */
+	double MatchStartTime;
+
+	/** FPlatformTime::Seconds() when the current transition started */
+	double FrontEndLoadStartTime;
+
+	/** Longest frame of the current transition */
+	float WorstFrameTime;
+
+	double TotalFrontEndLoadSecs;
+	float PeakFrontEndLoadSecs;
+	float PeakFrameTime;
+};
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerPickupReplication.generated.h"
+
+/**
+ * Server side measurement of idle pickup replication cost.
+ * Once a client is connected, fills the match up to -NumPickups= pickups (default 200) by cloning the level's pickups,
+ * then samples outgoing bytes per connection and game thread time for -SampleSeconds= (default 30) and logs them.
+ */
+UCLASS()
+class UFightingVRTestControllerPickupReplication : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	/** Spawns copies of the level's pickups until there are NumPickups, returns false if the level has none */
+	bool SpawnPickups();
+
+	uint8 bInMatch : 1;
+	uint8 bSpawnedPickups : 1;
+
+	int32 NumPickups;
+	float SampleSeconds;
+
+	/** Time since the pickups were spawned, the first seconds are left out while they replicate initially */
+	float TimeSinceSpawn;
+
+	int32 NumSamples;
+	double TotalGameThreadMs;
+	double TotalOutBytesPerSecond;
+	uint32 PeakOutBytesPerSecond;
+};
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "FightingVRTestControllerListenServerClient.h"
+#include "FightingVRTestControllerReconnectClient.generated.h"
+
+/**
+ * Client half of the reconnect test, paired with UFightingVRTestControllerReconnectServer.
+ * Joins the server, then waits for the connection to be lost and checks the client gets back into the match within
+ * -MaxReconnectSecs= (default 120) without falling back to the main menu. Needs reconnecting enabled, e.g.
+ * -ini:Engine:[/Script/FightingVR.FightingVREngine]:bAutoReconnect=True
+ */
+UCLASS()
+class UFightingVRTestControllerReconnectClient : public UFightingVRTestControllerListenServerClient
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	/** Returns number of network failures the engine recorded so far */
+	int32 GetNumNetworkFailures() const;
+
+	/** Returns true if the client is in a match and connected to its server */
+	bool IsConnectedToServer() const;
+
+	uint8 bInMatch : 1;
+	uint8 bLostConnection : 1;
+	uint8 bReconnected : 1;
+
+	float MaxReconnectSecs;
+
+	/** Network failures recorded before the match was joined */
+	int32 NumNetworkFailuresBeforeMatch;
+
+	double LostConnectionTime;
+};
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerReconnectServer.generated.h"
+
+/**
+ * Server half of the reconnect test, paired with UFightingVRTestControllerReconnectClient.
+ * Once a client has played for -KillServerAfter= seconds (default 15), drops every client connection, or with -KillServer exits
+ * the process without closing them, for test nodes that restart the server. Then waits -MaxReconnectSecs= (default 120) for a client
+ * to come back and stay for 10 seconds.
+ */
+UCLASS()
+class UFightingVRTestControllerReconnectServer : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	/** Returns number of connected clients */
+	int32 GetNumClients() const;
+
+	uint8 bInMatch : 1;
+	uint8 bDroppedClients : 1;
+	uint8 bKillServer : 1;
+
+	float KillServerAfter;
+	float MaxReconnectSecs;
+
+	/** Time the current phase (waiting for the first client, for the drop, or for the client to come back) has been running */
+	float PhaseTime;
+
+	/** Time the clients have been back after the drop */
+	float ReconnectedTime;
+};
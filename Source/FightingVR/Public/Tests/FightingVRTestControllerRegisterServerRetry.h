@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerRegisterServerRetry.generated.h"
+
+/**
+ * Dedicated server failure injection for the session registration retry, meant for the Null online subsystem.
+ * Once registered, -NumInjectedFailures= times (default 3) replaces the game session with a blocking one and registers again,
+ * so the first CreateSession fails. Checks every failure is handled once, the blocking session is destroyed before the retry
+ * and the registration broadcast only fires for the attempt that succeeds.
+ */
+UCLASS()
+class UFightingVRTestControllerRegisterServerRetry : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	/** Replaces the registered game session with one the next registration attempt collides with */
+	void InjectFailure();
+
+	/** Checks the results of the current registration cycle once it succeeded */
+	void CheckCycle();
+
+	void OnCreateSessionComplete(FName SessionName, bool bWasSuccessful);
+	void OnDestroySessionComplete(FName SessionName, bool bWasSuccessful);
+	void OnRegisterServerBroadcast(FName SessionName, bool bWasSuccessful);
+
+	/** Clears the session delegates and ends the test */
+	void FinishTest(int32 ExitCode);
+
+	uint8 bInMatch : 1;
+	uint8 bInjected : 1;
+	uint8 bRegistering : 1;
+
+	int32 NumInjectedFailures;
+	int32 NumCycles;
+
+	/** Results seen in the current registration cycle */
+	int32 NumCreateFailures;
+	int32 NumCreateSuccesses;
+	int32 NumDestroys;
+	int32 NumBroadcasts;
+	int32 NumEarlyRetries;
+
+	double CycleStartTime;
+
+	FDelegateHandle OnCreateSessionCompleteDelegateHandle;
+	FDelegateHandle OnDestroySessionCompleteDelegateHandle;
+	FDelegateHandle OnRegisterServerBroadcastDelegateHandle;
+};
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "Tests/FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerReplayProfiles.generated.h"
+
+/**
+ * Replay size and server frame time benchmark for the replay profiles.
+ * Once the match has -MinBots= bot pawns (default 8, start the map with ?Bots=8), samples the game thread time
+ * for -RecordSeconds= (default 60) without recording, then records the match for as long under every replay profile
+ * in turn. Logs the average and peak game thread time and the size of the demo file of each profile.
+ */
+UCLASS()
+class UFightingVRTestControllerReplayProfiles : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	/** Stops the recording of the current phase, logs its frame times and starts the next phase */
+	void EndPhase();
+
+	/** Returns number of bot pawns alive in the match */
+	int32 GetNumBotPawns() const;
+
+	uint8 bInMatch : 1;
+
+	int32 MinBots;
+	float RecordSeconds;
+
+	/** 0 samples without recording, phase N records with the replay profile N - 1 */
+	int32 PhaseIndex;
+
+	float SampledTime;
+	int32 NumSamples;
+	double TotalGameThreadMs;
+	double PeakGameThreadMs;
+
+	/** Average game thread time without recording, to compare the profiles against */
+	double BaselineGameThreadMs;
+
+	/** Replay names of the finished recordings, their sizes are logged once all demo files are closed */
+	TArray<FString> RecordedReplayNames;
+	TArray<FName> RecordedProfileNames;
+};
\ No newline at end of file
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "Tests/FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerServerAnimBudget.generated.h"
+
+/**
+ * Dedicated server frame time benchmark for the pawn bone update budget.
+ * Once the match has -MinBots= bot pawns (default 32, start the map with ?Bots=32), samples the game thread time
+ * for -SampleSeconds= (default 60) and logs the average and peak. Run once as is and once with
+ * -ExecCmds="FightingVR.ServerAnimBudget 0" to compare against full bone updates.
+ */
+UCLASS()
+class UFightingVRTestControllerServerAnimBudget : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+
+	/** Returns number of bot pawns alive in the match */
+	int32 GetNumBotPawns() const;
+
+	uint8 bInMatch : 1;
+
+	int32 MinBots;
+	float SampleSeconds;
+
+	float SampledTime;
+	int32 NumSamples;
+	double TotalGameThreadMs;
+	double PeakGameThreadMs;
+};
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc.All Rights Reserved.
+#pragma once
+
+#include "FightingVRTestControllerBase.h"
+#include "FightingVRTestControllerWeaponPool.generated.h"
+
+class AFightingVRWeapon;
+
+/**
+ * Hosts a match and kills and respawns the local player for a number of cycles (-TargetNumOfRespawns=, default 100),
+ * counting weapon actor spawns, destroys and actor channel opens. Fails if weapons keep being spawned or destroyed
+ * once the weapon pool is warm.
+ */
+UCLASS()
+class UFightingVRTestControllerWeaponPool : public UFightingVRTestControllerBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+
+protected:
+	virtual void OnTick(float TimeDelta) override;
+	virtual void OnUserCanPlayOnline(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults) override;
+
+	void OnActorSpawned(AActor* Actor);
+
+	UFUNCTION()
+	void OnWeaponDestroyed(AActor* DestroyedActor);
+
+	/** Counts weapon actors that got an actor channel since the last call */
+	void CountWeaponChannelOpens();
+
+	/** Logs the counters and ends the test */
+	void FinishTest();
+
+	uint8 bInMatch : 1;
+	uint8 bWaitingForRespawn : 1;
+
+	int32 NumRespawns;
+	int32 TargetNumOfRespawns;
+
+	int32 NumWeaponSpawns;
+	int32 NumWeaponSpawnsAfterWarmup;
+	int32 NumWeaponDestroys;
+	int32 NumWeaponChannelOpens;
+
+	/** Weapons with an open actor channel, per connection, as of the last count */
+	TMap<TWeakObjectPtr<UNetConnection>, TSet<TWeakObjectPtr<AFightingVRWeapon>>> WeaponChannels;
+
+	FDelegateHandle ActorSpawnedDelegateHandle;
+};
@@ -29,12 +29,27 @@ struct FDeathMessage
 	/** Name of killed player. */
 	FString VictimDesc;
 
+	/** Killer name as text, built once when the message is added. */
+	FText KillerText;
+
+	/** Victim name as text, built once when the message is added. */
+	FText VictimText;
+
+	/** Measured size of the killer name, valid once bTextSizeCached is set. */
+	FVector2D KillerTextSize;
+
+	/** Measured size of the victim name, valid once bTextSizeCached is set. */
+	FVector2D VictimTextSize;
+
 	/** Killer is local player. */
 	uint8 bKillerIsOwner : 1;
 	
 	/** Victim is local player. */
 	uint8 bVictimIsOwner : 1;
 
+	/** Name sizes have been measured. */
+	uint8 bTextSizeCached : 1;
+
 	/** Team number of the killer. */
 	int32 KillerTeamNum;
 
@@ -49,8 +64,11 @@ struct FDeathMessage
 
 	/** Initialise defaults. */
 	FDeathMessage()
-		: bKillerIsOwner(false)
+		: KillerTextSize(FVector2D::ZeroVector)
+		, VictimTextSize(FVector2D::ZeroVector)
+		, bKillerIsOwner(false)
 		, bVictimIsOwner(false)
+		, bTextSizeCached(false)
 		, KillerTeamNum(0)
 		, VictimTeamNum(0)		
 		, HideTime(0.f)
@@ -286,6 +304,12 @@ protected:
 	/** Active death messages. */
 	TArray<FDeathMessage> DeathMessages;
 
+	/** " killed " text drawn between names when the damage type has no icon. */
+	FText KilledText;
+
+	/** Measured size of KilledText, zero until first measured. */
+	FVector2D KilledTextSize;
+
 	/** State of match. */
 	EFightingVRMatchState::Type MatchState;
 
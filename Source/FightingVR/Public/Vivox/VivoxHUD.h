@@ -20,11 +20,16 @@
 #include "Map.h"
 #include "VivoxHUD.generated.h"
 
+class AFightingVRState;
+class AFightingVRPlayerState;
+
 UCLASS()
 class AVivoxHUD : public AFightingVRHUD
 {
     GENERATED_UCLASS_BODY()
 
+    friend class FFightingVRVivoxRosterBenchmark;
+
 public:
     /** Main HUD update loop. */
     virtual void DrawHUD() override;
@@ -87,7 +92,7 @@ protected:
     FString CachedGameplayMode;
 
     /** Returns CachedGameplayMode, first setting if unset. */
-    FString GetGameplayMode();
+    const FString& GetGameplayMode();
 
     /** Stores the size of the Debug Info box. */
     FVector2D CachedDebugInfoBoxSize;
@@ -104,6 +109,44 @@ protected:
     /** Stores the Player State and speaking status of all teammates. */
     TMap<FString, bool> TeammatesInAudio;
 
+    /** Teammate shown in the roster, with everything that only changes on roster events precomputed. */
+    struct FVivoxRosterEntry
+    {
+        TWeakObjectPtr<AFightingVRPlayerState> PlayerState;
+
+        /** Vivox participant key, the player's unique id. */
+        FString ParticipantId;
+
+        /** Short player name, as drawn. */
+        FText DisplayName;
+
+        /** Sort group: local player, then real players, then bots. */
+        uint8 SortGroup;
+
+        /** Upper case player name, sorts within the group. */
+        FString SortName;
+
+        bool bIsBot;
+    };
+
+    /** Local player's team, in draw order. Speaking state is looked up per frame on top of it. */
+    TArray<FVivoxRosterEntry> Roster;
+
+    /** Player state the roster was built for. */
+    TWeakObjectPtr<AFightingVRPlayerState> RosterOwner;
+
+    /** Set by roster events, the roster is rebuilt on the next draw. */
+    bool bRosterDirty;
+
+    /** Handle for the player state roster notification. */
+    FDelegateHandle OnRosterChangedDelegateHandle;
+
+    /** Marks the roster for a rebuild when a player joins, leaves, changes team or is renamed. */
+    void OnRosterChanged(AFightingVRPlayerState* PlayerState);
+
+    /** Rebuilds and sorts the local player's team roster. */
+    void RebuildRoster(AFightingVRState* MyGameState, AFightingVRPlayerState* MyPlayerState);
+
     /** Draws Vivox informational text. */
     void DrawVivoxInfoText();
 
@@ -116,6 +159,9 @@ protected:
     /** Called every time game is started. */
     virtual void PostInitializeComponents() override;
 
+    /** Stops listening for roster changes. */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
     UVivoxGameInstance *VivoxGameInstance;
 };
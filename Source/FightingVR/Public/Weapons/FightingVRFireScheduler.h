@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FightingVRFireScheduler.generated.h"
+
+class AFightingVRWeapon;
+
+/**
+ * Dispatches weapon refire for a whole world on a fixed sub-step instead of one timer per weapon.
+ * Shots are scheduled at exact times, so the fire rate does not depend on the frame rate,
+ * and a long frame fires every shot that became due during it, in the order they were due.
+ */
+UCLASS()
+class UFightingVRFireScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Schedules the next shot of a weapon, replacing any shot already scheduled for it.
+	 *
+	 * @param	Weapon		Weapon to call HandleReFiring on.
+	 * @param	FireTime	World time the shot is due.
+	 */
+	void ScheduleFire(AFightingVRWeapon* Weapon, double FireTime);
+
+	/** Removes the scheduled shot of a weapon, if any */
+	void CancelFire(AFightingVRWeapon* Weapon);
+
+	/** Returns the time the shot being dispatched was due, or the current world time outside of dispatch */
+	double GetShotTime() const;
+
+	/**
+	 * Returns when a weapon firing continuously is due to fire again.
+	 * Catching up keeps the cadence of the shot schedule, but never by more than one shot after a hitch.
+	 *
+	 * @param	ShotTime			Time the shot just fired was due.
+	 * @param	Now					Current world time.
+	 * @param	TimeBetweenShots	Refire interval of the weapon.
+	 * @param	bCatchUp			Keep the cadence, instead of counting the interval from now.
+	 */
+	static double GetRefireTime(double ShotTime, double Now, float TimeBetweenShots, bool bCatchUp);
+
+	/**
+	 * Advances the scheduler clock in fixed steps, firing every shot due on the way.
+	 *
+	 * @param	Now		World time to advance to.
+	 */
+	void AdvanceTo(double Now);
+
+protected:
+
+	struct FScheduledShot
+	{
+		TWeakObjectPtr<AFightingVRWeapon> Weapon;
+
+		/** world time the shot is due */
+		double FireTime;
+	};
+
+	/** fires every shot due at or before StepTime, in due order */
+	void DispatchStep(double StepTime);
+
+	/** Scheduled shots, one per weapon */
+	TArray<FScheduledShot> Shots;
+
+	/** Scheduler clock, always a whole number of steps */
+	double DispatchedTime = -1.0;
+
+	/** Due time of the shot being dispatched, negative outside of dispatch */
+	double CurrentShotTime = -1.0;
+
+#if WITH_DEV_AUTOMATION_TESTS
+public:
+
+	/** Called for due shots instead of the weapon's HandleReFiring, so tests can run the schedule without weapons firing */
+	TFunction<void(AFightingVRWeapon*)> ShotDispatchOverride;
+#endif
+};
@@ -13,6 +13,9 @@ class UParticleSystemComponent;
 class UForceFeedbackEffect;
 class USoundCue;
 class UMatineeCameraShake;
+class AFightingVRWeapon;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFightingVRWeaponPoolChanged, AFightingVRWeapon*);
 
 namespace EWeaponState
 {
@@ -90,6 +93,8 @@ class AFightingVRWeapon : public AActor
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class UFightingVRFireScheduler;
+
 	/** perform initial setup */
 	virtual void PostInitializeComponents() override;
 
@@ -141,6 +146,21 @@ class AFightingVRWeapon : public AActor
 	/** check if mesh is already attached */
 	bool IsAttachedToPawn() const;
 
+	/** [server] weapon was returned to the weapon pool: reset it and let it go dormant */
+	virtual void OnParked();
+
+	/** [server] weapon was taken from the weapon pool for a new owner */
+	virtual void OnUnparked();
+
+	/** check if it's waiting in the weapon pool */
+	bool IsParked() const;
+
+	/** Global notification when a weapon is parked in the weapon pool. Needed for replication graph. */
+	FIGHTINGVR_API static FOnFightingVRWeaponPoolChanged NotifyParked;
+
+	/** Global notification when a weapon leaves the weapon pool. Needed for replication graph. */
+	FIGHTINGVR_API static FOnFightingVRWeaponPoolChanged NotifyUnparked;
+
 
 	//////////////////////////////////////////////////////////////////////////
 	// Input
@@ -252,10 +272,6 @@ class AFightingVRWeapon : public AActor
 	UPROPERTY(EditDefaultsOnly, Category=HUD)
 	bool bHideCrosshairWhileNotAiming;
 
-	/** Adjustment to handle frame rate affecting actual timer interval. */
-	UPROPERTY(Transient)
-	float TimerIntervalAdjustment;
-
 	/** Whether to allow automatic weapons to catch up with shorter refire cycles */
 	UPROPERTY(Config)
 	bool bAllowAutomaticWeaponCatchup = true;
@@ -387,6 +403,9 @@ protected:
 	/** is equip animation playing? */
 	uint32 bPendingEquip : 1;
 
+	/** is weapon waiting in the weapon pool? */
+	uint32 bIsParked : 1;
+
 	/** weapon is refiring */
 	uint32 bRefiring;
 
@@ -423,9 +442,6 @@ protected:
 	/** Handle for efficient management of ReloadWeapon timer */
 	FTimerHandle TimerHandle_ReloadWeapon;
 
-	/** Handle for efficient management of HandleFiring timer */
-	FTimerHandle TimerHandle_HandleFiring;
-
 	//////////////////////////////////////////////////////////////////////////
 	// Input - server side
 
@@ -471,7 +487,7 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerHandleFiring();
 
-	/** [local + server] handle weapon refire, compensating for slack time if the timer can't sample fast enough */
+	/** [local + server] handle weapon refire, called by the world's fire scheduler when the next shot is due */
 	void HandleReFiring();
 
 	/** [local + server] handle weapon fire */